@@ -47,6 +47,12 @@ SDL_AudioStream *ogv_stream;
 int InitAudioPlayback()
 {
     StopAllSfx(); //"init"
+#if RETRO_USE_HEADLESS
+    // no device, but the sfx list still has to match a normal run
+    audioEnabled = false;
+    LoadGlobalSfx();
+    return true;
+#endif
 #if RETRO_USING_SDL1 || RETRO_USING_SDL2
     SDL_AudioSpec want;
     want.freq     = AUDIO_FREQUENCY;
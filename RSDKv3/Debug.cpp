@@ -1,4 +1,8 @@
 #include "RetroEngine.hpp"
+#if !RETRO_USE_ORIGINAL_CODE
+#include <chrono>
+#include <stdlib.h>
+#endif
 
 int touchFlags = 0;
 
@@ -52,6 +56,10 @@ void InitDevMenu()
 #if RETRO_USE_MOD_LOADER
     AddTextMenuEntry(&gameMenu[0], "MODS");
     AddTextMenuEntry(&gameMenu[0], " ");
+#endif
+#if RETRO_USE_SCRIPT_PROFILER
+    AddTextMenuEntry(&gameMenu[0], "SCRIPT PROFILER");
+    AddTextMenuEntry(&gameMenu[0], " ");
 #endif
     AddTextMenuEntry(&gameMenu[0], "EXIT GAME");
     gameMenu[0].alignment        = 2;
@@ -99,6 +107,49 @@ void InitErrorMessage()
         UpdateHardwareTextures();
     }
 }
+#if RETRO_USE_SCRIPT_PROFILER
+void SetupScriptProfilerMenu()
+{
+    const char subNames[SCRIPTSUB_COUNT][0x8] = { "MAIN", "PINT", "DRAW", "INIT" };
+
+    int list[SCRIPTPROFILE_COUNT];
+    int count  = SortScriptProfiles(list);
+    int frames = scriptProfileFrames > 0 ? scriptProfileFrames : 1;
+
+    char buffer[0x80];
+    SetupTextMenu(&gameMenu[0], 0);
+    AddTextMenuEntry(&gameMenu[0], "SCRIPT PROFILER");
+    sprintf(buffer, "%d FRAMES", scriptProfileFrames);
+    AddTextMenuEntry(&gameMenu[0], buffer);
+    sprintf(buffer, "3D FACES/FRAME: %d DRAWN %d CULLED", (int)(scriptProfileFacesDrawn / frames), (int)(scriptProfileFacesCulled / frames));
+    AddTextMenuEntry(&gameMenu[0], buffer);
+    AddTextMenuEntry(&gameMenu[0], "OBJECT          SUB  CALLS  US/FRAME  PEAK US");
+
+    SetupTextMenu(&gameMenu[1], 0);
+    for (int i = 0; i < count && i < 0x80; ++i) {
+        ScriptProfile *profile = &scriptProfiles[list[i]];
+        sprintf(buffer, "%-15.15s %-4s %5d %9.1f %8.1f", profile->typeName, subNames[profile->sub], profile->callCount / frames,
+                profile->time / 1000.0 / frames, profile->peakFrameTime / 1000.0);
+        AddTextMenuEntry(&gameMenu[1], buffer);
+    }
+    if (!count)
+        AddTextMenuEntry(&gameMenu[1], "NO SCRIPTS PROFILED YET");
+
+    gameMenu[0].alignment      = 0;
+    gameMenu[0].selectionCount = 1;
+    gameMenu[0].selection1     = 0;
+    gameMenu[1].alignment      = 0;
+    gameMenu[1].selectionCount = 1;
+    gameMenu[1].selection1     = 0;
+    if (gameMenu[1].rowCount > 16)
+        gameMenu[1].visibleRowCount = 16;
+    else
+        gameMenu[1].visibleRowCount = 0;
+    gameMenu[1].timer            = 0;
+    gameMenu[1].visibleRowOffset = 0;
+}
+#endif
+
 void ProcessStageSelect()
 {
     ClearScreen(0xF0);
@@ -171,6 +222,9 @@ void ProcessStageSelect()
 #if RETRO_USE_MOD_LOADER
             count += 2;
 #endif
+#if RETRO_USE_SCRIPT_PROFILER
+            count += 2;
+#endif
 
             if (gameMenu[0].selection2 > count)
                 gameMenu[0].selection2 = 9;
@@ -231,6 +285,12 @@ void ProcessStageSelect()
                     gameMenu[1].visibleRowOffset = 0;
                     stageMode                    = DEVMENU_MODMENU;
                 }
+#endif
+#if RETRO_USE_SCRIPT_PROFILER
+                else if (gameMenu[0].selection2 == count - 2) {
+                    SetupScriptProfilerMenu();
+                    stageMode = DEVMENU_SCRIPTPROFILER;
+                }
 #endif
                 else {
                     Engine.running = false;
@@ -308,6 +368,10 @@ void ProcessStageSelect()
 #if RETRO_USE_MOD_LOADER
                 AddTextMenuEntry(&gameMenu[0], "MODS");
                 AddTextMenuEntry(&gameMenu[0], " ");
+#endif
+#if RETRO_USE_SCRIPT_PROFILER
+                AddTextMenuEntry(&gameMenu[0], "SCRIPT PROFILER");
+                AddTextMenuEntry(&gameMenu[0], " ");
 #endif
                 AddTextMenuEntry(&gameMenu[0], "EXIT GAME");
                 gameMenu[0].alignment        = 2;
@@ -493,6 +557,10 @@ void ProcessStageSelect()
 #if RETRO_USE_MOD_LOADER
                 AddTextMenuEntry(&gameMenu[0], "MODS");
                 AddTextMenuEntry(&gameMenu[0], " ");
+#endif
+#if RETRO_USE_SCRIPT_PROFILER
+                AddTextMenuEntry(&gameMenu[0], "SCRIPT PROFILER");
+                AddTextMenuEntry(&gameMenu[0], " ");
 #endif
                 AddTextMenuEntry(&gameMenu[0], "EXIT GAME");
                 gameMenu[0].alignment        = 2;
@@ -651,6 +719,10 @@ void ProcessStageSelect()
                 AddTextMenuEntry(&gameMenu[0], " ");
                 AddTextMenuEntry(&gameMenu[0], "MODS");
                 AddTextMenuEntry(&gameMenu[0], " ");
+#if RETRO_USE_SCRIPT_PROFILER
+                AddTextMenuEntry(&gameMenu[0], "SCRIPT PROFILER");
+                AddTextMenuEntry(&gameMenu[0], " ");
+#endif
                 AddTextMenuEntry(&gameMenu[0], "EXIT GAME");
                 gameMenu[0].alignment        = 2;
                 gameMenu[0].selectionCount   = 2;
@@ -666,6 +738,100 @@ void ProcessStageSelect()
         }
 #endif
 
+#if RETRO_USE_SCRIPT_PROFILER
+        case DEVMENU_SCRIPTPROFILER: // Script Profiler
+        {
+            if (keyDown.down) {
+                gameMenu[1].timer += 1;
+                if (gameMenu[1].timer > 8) {
+                    gameMenu[1].timer = 0;
+                    keyPress.down     = true;
+                }
+            }
+            else {
+                if (keyDown.up) {
+                    gameMenu[1].timer -= 1;
+                    if (gameMenu[1].timer < -8) {
+                        gameMenu[1].timer = 0;
+                        keyPress.up       = true;
+                    }
+                }
+                else {
+                    gameMenu[1].timer = 0;
+                }
+            }
+            if (keyPress.down) {
+                gameMenu[1].selection1++;
+                if (gameMenu[1].selection1 - gameMenu[1].visibleRowOffset >= gameMenu[1].visibleRowCount) {
+                    gameMenu[1].visibleRowOffset += 1;
+                }
+            }
+            if (keyPress.up) {
+                gameMenu[1].selection1--;
+                if (gameMenu[1].selection1 - gameMenu[1].visibleRowOffset < 0) {
+                    gameMenu[1].visibleRowOffset -= 1;
+                }
+            }
+            if (gameMenu[1].selection1 == gameMenu[1].rowCount) {
+                gameMenu[1].selection1       = 0;
+                gameMenu[1].visibleRowOffset = 0;
+            }
+            if (gameMenu[1].selection1 < 0) {
+                gameMenu[1].selection1       = gameMenu[1].rowCount - 1;
+                gameMenu[1].visibleRowOffset = gameMenu[1].rowCount - gameMenu[1].visibleRowCount;
+            }
+
+            DrawTextMenu(&gameMenu[0], 16, 24);
+            DrawTextMenu(&gameMenu[1], 16, 64);
+            if (keyPress.start || keyPress.A) {
+                WriteScriptProfile();
+                EditTextMenuEntry(&gameMenu[0], "REPORT SAVED TO SCRIPTPROFILE.TXT", 1);
+            }
+            else if (keyPress.C) {
+                ResetScriptProfiler();
+                SetupScriptProfilerMenu();
+            }
+            else if (keyPress.B) {
+                stageMode = DEVMENU_MAIN;
+                SetupTextMenu(&gameMenu[0], 0);
+                AddTextMenuEntry(&gameMenu[0], "RETRO ENGINE DEV MENU");
+                AddTextMenuEntry(&gameMenu[0], " ");
+                char version[0x80];
+                StrCopy(version, Engine.gameWindowText);
+                StrAdd(version, " Version");
+                AddTextMenuEntry(&gameMenu[0], version);
+                AddTextMenuEntry(&gameMenu[0], Engine.gameVersion);
+#ifdef RETRO_DEV_EXTRA
+                AddTextMenuEntry(&gameMenu[0], RETRO_DEV_EXTRA);
+#else
+                AddTextMenuEntry(&gameMenu[0], " ");
+#endif
+                AddTextMenuEntry(&gameMenu[0], " ");
+                AddTextMenuEntry(&gameMenu[0], " ");
+                AddTextMenuEntry(&gameMenu[0], " ");
+                AddTextMenuEntry(&gameMenu[0], " ");
+                AddTextMenuEntry(&gameMenu[0], "START GAME");
+                AddTextMenuEntry(&gameMenu[0], " ");
+                AddTextMenuEntry(&gameMenu[0], "STAGE SELECT");
+                AddTextMenuEntry(&gameMenu[0], " ");
+#if RETRO_USE_MOD_LOADER
+                AddTextMenuEntry(&gameMenu[0], "MODS");
+                AddTextMenuEntry(&gameMenu[0], " ");
+#endif
+                AddTextMenuEntry(&gameMenu[0], "SCRIPT PROFILER");
+                AddTextMenuEntry(&gameMenu[0], " ");
+                AddTextMenuEntry(&gameMenu[0], "EXIT GAME");
+                gameMenu[0].alignment        = 2;
+                gameMenu[0].selectionCount   = 2;
+                gameMenu[0].selection1       = 0;
+                gameMenu[0].selection2       = 9;
+                gameMenu[1].visibleRowCount  = 0;
+                gameMenu[1].visibleRowOffset = 0;
+            }
+            break;
+        }
+#endif
+
         default: break;
     }
 
@@ -674,3 +840,204 @@ void ProcessStageSelect()
         gfxVertexSizeOpaque = gfxVertexSize;
     }
 }
+
+#if !RETRO_USE_ORIGINAL_CODE
+// Plays every stage in stageList for a fixed number of frames and writes min/median/p99 timings of each frame phase to a json file
+bool benchmarkActive = false;
+long long benchmarkPhaseTime[BENCHPHASE_COUNT];
+long long benchmarkPhaseMark = 0;
+
+FileIO *benchmarkFile = nullptr;
+int benchmarkFrames   = 0;
+int benchmarkFrame    = 0;
+int benchmarkList     = 0;
+int benchmarkStage    = 0;
+int benchmarkEntries  = 0;
+
+long long benchmarkFrameStart = 0;
+int benchmarkSamples[BENCHPHASE_COUNT][BENCHMARK_FRAME_COUNT]; // ns
+
+const char *benchmarkPhaseNames[BENCHPHASE_COUNT] = { "processObjects", "cameraUpdate", "drawStageGFX", "flipScreen", "frame" };
+
+long long GetBenchmarkTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void WriteBenchmark(const char *text, ...)
+{
+    char buffer[0x200];
+    va_list args;
+    va_start(args, text);
+    vsprintf(buffer, text, args);
+    va_end(args);
+    fWrite(buffer, 1, strlen(buffer), benchmarkFile);
+}
+
+int CompareBenchmarkSamples(const void *a, const void *b) { return *(const int *)a - *(const int *)b; }
+
+// finds the next stage to play from (benchmarkList, benchmarkStage) onwards, returns false once every list is done
+bool LoadBenchmarkStage()
+{
+    while (benchmarkList < STAGELIST_MAX && benchmarkStage >= stageListCount[benchmarkList]) {
+        ++benchmarkList;
+        benchmarkStage = 0;
+    }
+    if (benchmarkList >= STAGELIST_MAX)
+        return false;
+
+    activeStageList   = benchmarkList;
+    stageListPosition = benchmarkStage;
+    stageMode         = STAGEMODE_LOAD;
+    Engine.gameMode   = ENGINE_MAINGAME;
+    benchmarkFrame    = 0;
+    return true;
+}
+
+bool StartBenchmark(const char *filePath, int framesPerStage)
+{
+    benchmarkFile = fOpen(filePath, "w");
+    if (!benchmarkFile) {
+        PrintLog("ERROR: Couldn't open file '%s' for writing!", filePath);
+        return false;
+    }
+
+    benchmarkFrames = framesPerStage;
+    if (benchmarkFrames > BENCHMARK_FRAME_COUNT)
+        benchmarkFrames = BENCHMARK_FRAME_COUNT;
+    if (benchmarkFrames < 1)
+        benchmarkFrames = 1;
+    benchmarkList    = 0;
+    benchmarkStage   = 0;
+    benchmarkEntries = 0;
+    Engine.gameSpeed = 1;
+
+    WriteBenchmark("{\n  \"framesPerStage\": %d,\n  \"warmupFrames\": %d,\n  \"stages\": [", benchmarkFrames, BENCHMARK_WARMUP_COUNT);
+    if (!LoadBenchmarkStage()) {
+        PrintLog("ERROR: No stages to benchmark!");
+        WriteBenchmark("]\n}\n");
+        fClose(benchmarkFile);
+        benchmarkFile = nullptr;
+        return false;
+    }
+
+    for (int p = 0; p < BENCHPHASE_COUNT; ++p) benchmarkPhaseTime[p] = 0;
+    benchmarkActive     = true;
+    benchmarkFrameStart = GetBenchmarkTime();
+    return true;
+}
+
+// holds right and jumps for 20 frames out of every 120, unless a replay is driving input instead
+void ApplyBenchmarkInput()
+{
+    if (!benchmarkActive || inputReplayMode == INPUTREPLAY_PLAYBACK)
+        return;
+
+    for (int i = 0; i < INPUT_MAX; ++i) {
+        bool held = false;
+        switch (i) {
+            case INPUT_RIGHT:
+            case INPUT_ANY: held = true; break;
+            case INPUT_BUTTONA: held = (benchmarkFrame % 120) < 20; break;
+            default: break;
+        }
+        if (held)
+            inputDevice[i].setHeld();
+        else
+            inputDevice[i].setReleased();
+    }
+}
+
+void UpdateBenchmark()
+{
+    if (!benchmarkActive)
+        return;
+
+    long long time                       = GetBenchmarkTime();
+    benchmarkPhaseTime[BENCHPHASE_FRAME] = time - benchmarkFrameStart;
+    benchmarkFrameStart                  = time;
+
+    // the first frames include the stage load & caches warming up
+    int sample = benchmarkFrame++ - BENCHMARK_WARMUP_COUNT;
+    if (sample >= 0) {
+        for (int p = 0; p < BENCHPHASE_COUNT; ++p) benchmarkSamples[p][sample] = (int)benchmarkPhaseTime[p];
+    }
+    for (int p = 0; p < BENCHPHASE_COUNT; ++p) benchmarkPhaseTime[p] = 0;
+
+    if (sample + 1 < benchmarkFrames)
+        return;
+
+    SceneInfo *scene = &stageList[benchmarkList][benchmarkStage];
+    WriteBenchmark("%s\n    {\n      \"list\": \"%s\",\n      \"name\": \"%s\",\n      \"folder\": \"%s\",\n      \"id\": \"%s\",\n",
+                   benchmarkEntries++ ? "," : "", stageListNames[benchmarkList], scene->name, scene->folder, scene->id);
+    for (int p = 0; p < BENCHPHASE_COUNT; ++p) {
+        int *samples = benchmarkSamples[p];
+        qsort(samples, benchmarkFrames, sizeof(int), CompareBenchmarkSamples);
+        int p99 = (benchmarkFrames * 99) / 100;
+        if (p99 >= benchmarkFrames)
+            p99 = benchmarkFrames - 1;
+        WriteBenchmark("      \"%s\": { \"minUs\": %.1f, \"medianUs\": %.1f, \"p99Us\": %.1f }%s\n", benchmarkPhaseNames[p], samples[0] / 1000.0,
+                       samples[benchmarkFrames / 2] / 1000.0, samples[p99] / 1000.0, p + 1 < BENCHPHASE_COUNT ? "," : "");
+    }
+    WriteBenchmark("    }");
+    printf("Benchmarked %s - %s\n", stageListNames[benchmarkList], scene->name);
+
+    ++benchmarkStage;
+    if (!LoadBenchmarkStage()) {
+        WriteBenchmark("\n  ]\n}\n");
+        fClose(benchmarkFile);
+        benchmarkFile   = nullptr;
+        benchmarkActive = false;
+        Engine.gameMode = ENGINE_EXITGAME;
+    }
+}
+
+uint selfCheckRandom = 1;
+
+void ReportSelfCheck(const char *name, int failures, int cases)
+{
+    if (failures)
+        printf("%s: %d of %d cases differ\n", name, failures, cases);
+    else
+        printf("%s: all %d cases match\n", name, cases);
+}
+
+// Each module's check prints its own results & returns how many of its cases mismatched, the total is the exit code
+int RunSelfCheck(uint seed)
+{
+    selfCheckRandom = seed ? seed : 1; // xorshift never leaves 0
+#if RETRO_USING_SSE2
+    printf("selfcheck: seed %u, SSE2 paths\n", selfCheckRandom);
+#elif RETRO_USING_NEON
+    printf("selfcheck: seed %u, NEON paths\n", selfCheckRandom);
+#else
+    printf("selfcheck: seed %u, scalar build (the vector paths aren't compiled in)\n", selfCheckRandom);
+#endif
+
+    int failures = 0;
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+    GenerateBlendLookupTable();
+    failures += CheckDrawingSpans();
+#endif
+    failures += CheckEntityBounds();
+    failures += Check3DDrawListSort();
+    failures += Check3DTransform();
+    failures += Check3DProjection();
+
+    // timings only, these never fail
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+    BenchmarkDrawingSpans();
+#if RETRO_USE_DIRTY_RECTS
+    BenchmarkDirtyRects();
+#endif
+#endif
+    BenchmarkEntityBounds();
+    Benchmark3DDrawListSort();
+
+    if (failures)
+        printf("selfcheck: %d cases FAILED\n", failures);
+    else
+        printf("selfcheck: passed\n");
+    return failures;
+}
+#endif
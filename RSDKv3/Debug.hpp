@@ -54,10 +54,62 @@ enum DevMenuMenus {
 #if RETRO_USE_MOD_LOADER
     DEVMENU_MODMENU,
 #endif
+#if RETRO_USE_SCRIPT_PROFILER
+    DEVMENU_SCRIPTPROFILER,
+#endif
 };
 
 void InitDevMenu();
 void InitErrorMessage();
 void ProcessStageSelect();
 
+#if !RETRO_USE_ORIGINAL_CODE
+#define BENCHMARK_FRAME_COUNT  (0x2000)
+#define BENCHMARK_WARMUP_COUNT (60)
+
+enum BenchmarkPhases {
+    BENCHPHASE_OBJECTS,
+    BENCHPHASE_CAMERA,
+    BENCHPHASE_DRAW,
+    BENCHPHASE_FLIP,
+    BENCHPHASE_FRAME,
+    BENCHPHASE_COUNT,
+};
+
+extern bool benchmarkActive;
+extern long long benchmarkPhaseTime[BENCHPHASE_COUNT];
+extern long long benchmarkPhaseMark;
+
+long long GetBenchmarkTime();
+// adds the time since the last mark to phase, or just sets the mark if phase is -1
+inline void MarkBenchmarkPhase(int phase)
+{
+    if (benchmarkActive) {
+        long long time = GetBenchmarkTime();
+        if (phase >= 0)
+            benchmarkPhaseTime[phase] += time - benchmarkPhaseMark;
+        benchmarkPhaseMark = time;
+    }
+}
+
+bool StartBenchmark(const char *filePath, int framesPerStage);
+void ApplyBenchmarkInput();
+void UpdateBenchmark();
+
+// -selfcheck <seed>: runs the vector paths against their scalar reference on generated cases, no game data needed
+extern uint selfCheckRandom;
+
+// xorshift32, so a seed makes the same cases on every platform
+inline uint SelfCheckRandom()
+{
+    selfCheckRandom ^= selfCheckRandom << 13;
+    selfCheckRandom ^= selfCheckRandom >> 17;
+    selfCheckRandom ^= selfCheckRandom << 5;
+    return selfCheckRandom;
+}
+
+void ReportSelfCheck(const char *name, int failures, int cases);
+int RunSelfCheck(uint seed);
+#endif
+
 #endif //! DEBUG_H
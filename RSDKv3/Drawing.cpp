@@ -1,4 +1,7 @@
 #include "RetroEngine.hpp"
+#if !RETRO_USE_ORIGINAL_CODE
+#include <algorithm>
+#endif
 
 short blendLookupTable[BLENDTABLE_SIZE];
 short subtractLookupTable[BLENDTABLE_SIZE];
@@ -22,6 +25,58 @@ DrawListEntry drawListEntries[DRAWLAYER_COUNT];
 int gfxDataPosition;
 GFXSurface gfxSurface[SURFACE_MAX];
 byte graphicData[GFXDATA_MAX];
+int gfxSpanPosition;
+int gfxSpanRowPosition;
+GFXSpan *gfxSpanList = NULL;
+int gfxSpanListSize   = 0;
+int *gfxSpanRows      = NULL;
+int gfxSpanRowsSize   = 0;
+
+RETRO_BAND_LOCAL int drawClipTop    = 0;
+RETRO_BAND_LOCAL int drawClipBottom = SCREEN_YSIZE;
+
+#if RETRO_USE_BAND_RENDERING
+RETRO_BAND_LOCAL bool recordDrawCommands = false;
+int drawBandCount                        = 0;
+DrawCommand drawCommands[2][DRAWCOMMAND_COUNT];
+int drawCommandList  = 0; // the list being recorded into, the other one may still be rasterizing
+int drawCommandCount = 0;
+
+std::thread drawBandThreads[DRAWBAND_MAX];
+std::mutex drawBandMutex;
+std::condition_variable drawBandStart;
+std::condition_variable drawBandDone;
+int drawBandFirstThread = 1; // band the first worker thread takes, the main thread does band 0 itself unless drawing is deferred
+int drawBandJob         = 0; // bumped every submit, workers wake when it changes
+int drawBandsLeft       = 0;
+bool drawBandsBusy      = false; // a submitted list hasn't been waited on yet
+bool drawBandsExit      = false;
+
+// the submitted list, the palette the main thread had when it was submitted, and the last one each band's draws left active
+DrawCommand *drawBandCommands;
+int drawBandCommandCount;
+ushort *drawBandPalette;
+PaletteEntry *drawBandPalette32;
+int drawBandLastCommand[DRAWBAND_MAX];
+ushort *drawBandLastPalette[DRAWBAND_MAX];
+PaletteEntry *drawBandLastPalette32[DRAWBAND_MAX];
+#endif
+
+#if RETRO_USE_DIRTY_RECTS
+ushort *presentedFrameBuffer = NULL; // what screenBuffer was last given
+bool presentedFrameValid     = false; // false when screenBuffer might not hold presentedFrameBuffer (HQ frames, videos, render resets)
+#endif
+
+#if RETRO_USE_TILEROW_CACHE
+TileRowCacheLine tileRowCache[TILEROWCACHE_COUNT][SCREEN_YSIZE];
+byte *tileRowCacheData = NULL;
+int tileRowCacheID     = 1; // lines built under an older ID get rebuilt
+#endif
+
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+Layer3DLineTable floor3DLineTable = { 0, 0, -1 };
+Layer3DLineTable sky3DLineTable   = { 0, 0, -1 };
+#endif
 
 #if RETRO_PLATFORM == RETRO_3DS
 // implementation taken from here: https://gbatemp.net/threads/best-way-to-draw-pixel-buffer.445173/
@@ -125,6 +180,19 @@ int InitRenderDevice()
     Engine.frameBuffer2x = new ushort[(SCREEN_XSIZE * 2) * (SCREEN_YSIZE * 2)];
     memset(Engine.frameBuffer, 0, (SCREEN_XSIZE * SCREEN_YSIZE) * sizeof(ushort));
     memset(Engine.frameBuffer2x, 0, (SCREEN_XSIZE * 2) * (SCREEN_YSIZE * 2) * sizeof(ushort));
+#if RETRO_USE_TILEROW_CACHE
+    tileRowCacheData = new byte[TILEROWCACHE_COUNT * SCREEN_YSIZE * SCREEN_XSIZE];
+    InvalidateTileRowCache();
+#endif
+#if RETRO_USE_DIRTY_RECTS
+    presentedFrameBuffer = new ushort[SCREEN_XSIZE * SCREEN_YSIZE];
+    presentedFrameValid  = false;
+#endif
+
+#if RETRO_USE_HEADLESS
+    // everything still draws into frameBuffer (draw subs can change game state), it just never gets presented
+    return 1;
+#endif
 
 #if RETRO_USING_SDL2
     SDL_Init(SDL_INIT_EVERYTHING);
@@ -270,6 +338,47 @@ int InitRenderDevice()
 
     return 1;
 }
+#if RETRO_USE_DIRTY_RECTS
+// Gets the bounds of everything in frameBuffer that differs from presentedFrameBuffer, and brings presentedFrameBuffer up to date
+// Returns false if the frame hasn't changed
+bool GetDirtyRect(SDL_Rect *rect)
+{
+    int top    = 0;
+    int bottom = SCREEN_YSIZE;
+    int left   = 0;
+    int right  = SCREEN_XSIZE;
+    if (presentedFrameValid) {
+        int rowSize = SCREEN_XSIZE * sizeof(ushort);
+        while (top < bottom && !memcmp(&Engine.frameBuffer[top * SCREEN_XSIZE], &presentedFrameBuffer[top * SCREEN_XSIZE], rowSize)) ++top;
+        if (top == bottom)
+            return false;
+        while (!memcmp(&Engine.frameBuffer[(bottom - 1) * SCREEN_XSIZE], &presentedFrameBuffer[(bottom - 1) * SCREEN_XSIZE], rowSize)) --bottom;
+
+        left  = SCREEN_XSIZE;
+        right = 0;
+        for (int y = top; y < bottom; ++y) {
+            ushort *frameBufferPtr = &Engine.frameBuffer[y * SCREEN_XSIZE];
+            ushort *presentedPtr   = &presentedFrameBuffer[y * SCREEN_XSIZE];
+            int x                  = 0;
+            while (x < left && frameBufferPtr[x] == presentedPtr[x]) ++x;
+            left = x < left ? x : left;
+            x    = SCREEN_XSIZE;
+            while (x > right && frameBufferPtr[x - 1] == presentedPtr[x - 1]) --x;
+            right = x > right ? x : right;
+        }
+    }
+
+    rect->x = left;
+    rect->y = top;
+    rect->w = right - left;
+    rect->h = bottom - top;
+    for (int y = top; y < bottom; ++y)
+        memcpy(&presentedFrameBuffer[y * SCREEN_XSIZE + left], &Engine.frameBuffer[y * SCREEN_XSIZE + left], rect->w * sizeof(ushort));
+    presentedFrameValid = true;
+    return true;
+}
+#endif
+
 void RenderRenderDevice()
 {
     if (Engine.gameMode == ENGINE_EXITGAME)
@@ -354,6 +463,17 @@ void RenderRenderDevice()
     */
 #endif
 
+#if RETRO_USE_DIRTY_RECTS
+    // menus & static screens usually only change a cursor or a counter, so there's often very little to send
+    SDL_Rect dirtyRect;
+    bool frameChanged = true;
+    if (Engine.gameMode != ENGINE_VIDEOWAIT && !drawStageGFXHQ) {
+        frameChanged = GetDirtyRect(&dirtyRect);
+        if (!frameChanged && !Engine.vsync)
+            return; // the window still shows this frame so there's nothing to clear, copy or present, vsync'd frames have to present to keep the pace
+    }
+#endif
+
     int pitch = 0;
 #if RETRO_USING_SDL2
     SDL_SetRenderTarget(Engine.renderer, texTarget);
@@ -439,11 +559,16 @@ void RenderRenderDevice()
     ushort *pixels = NULL;
     if (Engine.gameMode != ENGINE_VIDEOWAIT) {
         if (!drawStageGFXHQ) {
-#if RETRO_USING_SDL2
+#if RETRO_USE_DIRTY_RECTS
+            if (frameChanged)
+                SDL_UpdateTexture(Engine.screenBuffer, &dirtyRect, &Engine.frameBuffer[dirtyRect.y * SCREEN_XSIZE + dirtyRect.x],
+                                  SCREEN_XSIZE * sizeof(ushort));
+#elif RETRO_USING_SDL2
             SDL_LockTexture(Engine.screenBuffer, NULL, (void **)&pixels, &pitch);
             memcpy(pixels, Engine.frameBuffer, pitch * SCREEN_YSIZE);
             SDL_UnlockTexture(Engine.screenBuffer);
-
+#endif
+#if RETRO_USING_SDL2
             SDL_RenderCopy(Engine.renderer, Engine.screenBuffer, NULL, destScreenPos);
 #elif RETRO_USING_C2D
 
@@ -453,6 +578,9 @@ void RenderRenderDevice()
         }
         else {
             int w = 0, h = 0;
+#if RETRO_USE_DIRTY_RECTS
+            presentedFrameValid = false;
+#endif
 #if RETRO_USING_SDL2
             SDL_QueryTexture(Engine.screenBuffer2x, NULL, NULL, &w, &h);
             SDL_LockTexture(Engine.screenBuffer2x, NULL, (void **)&pixels, &pitch);
@@ -497,6 +625,9 @@ void RenderRenderDevice()
         }
     }
     else {
+#if RETRO_USE_DIRTY_RECTS
+        presentedFrameValid = false;
+#endif
 #if RETRO_USING_SDL2
         SDL_RenderCopy(Engine.renderer, Engine.videoBuffer, NULL, destScreenPos);
 #endif
@@ -570,6 +701,16 @@ void ReleaseRenderDevice()
         delete[] Engine.frameBuffer;
     if (Engine.frameBuffer2x)
         delete[] Engine.frameBuffer2x;
+#if RETRO_USE_TILEROW_CACHE
+    if (tileRowCacheData)
+        delete[] tileRowCacheData;
+    tileRowCacheData = NULL;
+#endif
+#if RETRO_USE_DIRTY_RECTS
+    if (presentedFrameBuffer)
+        delete[] presentedFrameBuffer;
+    presentedFrameBuffer = NULL;
+#endif
 #if RETRO_USING_SDL2
     SDL_DestroyTexture(Engine.screenBuffer);
     Engine.screenBuffer = NULL;
@@ -588,6 +729,10 @@ void ReleaseRenderDevice()
 #if RETRO_USING_SDL1
     SDL_FreeSurface(Engine.screenBuffer);
 #endif
+
+#if RETRO_USE_BAND_RENDERING
+    ReleaseDrawBands();
+#endif
 }
 
 void GenerateBlendLookupTable(void)
@@ -611,8 +756,172 @@ void GenerateBlendLookupTable(void)
     }
 }
 
+#if RETRO_USE_BAND_RENDERING
+void ReplayDrawCommands(int band)
+{
+    drawClipTop     = band * SCREEN_YSIZE / drawBandCount;
+    drawClipBottom  = (band + 1) * SCREEN_YSIZE / drawBandCount;
+    activePalette   = drawBandPalette;
+    activePalette32 = drawBandPalette32;
+
+    drawBandLastCommand[band] = -1;
+    for (int c = 0; c < drawBandCommandCount; ++c) {
+        int *p = drawBandCommands[c].params;
+
+        // draws switch to each line's palette as they go, note which one was left active so the main thread can pick it up
+        activePalette = NULL;
+        switch (drawBandCommands[c].type) {
+            case DRAWCMD_SPRITE: DrawSprite(p[0], p[1], p[2], p[3], p[4], p[5], p[6]); break;
+            case DRAWCMD_SPRITEFLIPPED: DrawSpriteFlipped(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]); break;
+            case DRAWCMD_BLENDEDSPRITE: DrawBlendedSprite(p[0], p[1], p[2], p[3], p[4], p[5], p[6]); break;
+            case DRAWCMD_ALPHABLENDEDSPRITE: DrawAlphaBlendedSprite(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]); break;
+            case DRAWCMD_ADDITIVEBLENDEDSPRITE: DrawAdditiveBlendedSprite(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]); break;
+            case DRAWCMD_SUBTRACTIVEBLENDEDSPRITE: DrawSubtractiveBlendedSprite(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]); break;
+            case DRAWCMD_RECTANGLE: DrawRectangle(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]); break;
+            case DRAWCMD_TINTRECTANGLE: DrawTintRectangle(p[0], p[1], p[2], p[3]); break;
+            case DRAWCMD_SPRITESCALED: DrawSpriteScaled(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9], p[10], p[11]); break;
+            case DRAWCMD_SPRITEROTATED: DrawSpriteRotated(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9], p[10]); break;
+            case DRAWCMD_SPRITEROTOZOOM: DrawSpriteRotozoom(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9], p[10], p[11]); break;
+            case DRAWCMD_SCALEDTINTMASK: DrawScaledTintMask(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7], p[8], p[9], p[10], p[11]); break;
+            case DRAWCMD_HLINESCROLLLAYER: DrawHLineScrollLines(p[0], p[1], p[2], p[3], p[4]); break;
+            case DRAWCMD_3DFLOORLAYER: Draw3DFloorLines(p[0], p[1], p[2]); break;
+            case DRAWCMD_3DSKYLAYER: Draw3DSkyLines(p[0], p[1], p[2], p[3]); break;
+            default: break;
+        }
+        if (activePalette) {
+            drawBandLastCommand[band]   = c;
+            drawBandLastPalette[band]   = activePalette;
+            drawBandLastPalette32[band] = activePalette32;
+        }
+    }
+
+    drawClipTop    = 0;
+    drawClipBottom = SCREEN_YSIZE;
+}
+
+void DrawBandThread(int band)
+{
+    int job = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(drawBandMutex);
+            while (drawBandJob == job && !drawBandsExit) drawBandStart.wait(lock);
+            if (drawBandsExit)
+                return;
+            job = drawBandJob;
+        }
+
+        ReplayDrawCommands(band);
+
+        std::lock_guard<std::mutex> lock(drawBandMutex);
+        if (--drawBandsLeft == 0)
+            drawBandDone.notify_one();
+    }
+}
+
+void InitDrawBands()
+{
+    drawBandCount = Engine.renderBands;
+    if (drawBandCount <= 0)
+        drawBandCount = std::thread::hardware_concurrency();
+    if (drawBandCount < 1)
+        drawBandCount = 1;
+    if (drawBandCount > DRAWBAND_MAX)
+        drawBandCount = DRAWBAND_MAX;
+
+    // deferred drawing hands every band to a worker so the scripts can carry on while the last list rasterizes
+    drawBandFirstThread = Engine.deferredDrawing ? 0 : 1;
+    drawBandJob         = 0;
+    drawBandsExit       = false;
+    for (int b = drawBandFirstThread; b < drawBandCount; ++b) drawBandThreads[b] = std::thread(DrawBandThread, b);
+    if (Engine.deferredDrawing)
+        printLog("Rendering stages deferred, in %d bands", drawBandCount);
+    else if (drawBandCount > 1)
+        printLog("Rendering stages in %d bands", drawBandCount);
+}
+
+void WaitForDrawBands()
+{
+    if (!drawBandsBusy)
+        return;
+    {
+        std::unique_lock<std::mutex> lock(drawBandMutex);
+        while (drawBandsLeft > 0) drawBandDone.wait(lock);
+    }
+    drawBandsBusy = false;
+
+    // a serial draw leaves the palette of the last line it touched active, which is the latest command in the bottom-most band it reached
+    activePalette   = drawBandPalette;
+    activePalette32 = drawBandPalette32;
+    int lastCommand = -1;
+    for (int b = 0; b < drawBandCount; ++b) {
+        if (drawBandLastCommand[b] >= lastCommand && drawBandLastCommand[b] >= 0) {
+            lastCommand     = drawBandLastCommand[b];
+            activePalette   = drawBandLastPalette[b];
+            activePalette32 = drawBandLastPalette32[b];
+        }
+    }
+}
+
+void SubmitDrawCommands()
+{
+    // the bands replay with recording off, so this can't be re-entered from them
+    if (!recordDrawCommands || !drawCommandCount)
+        return;
+
+    WaitForDrawBands();
+    drawBandCommands     = drawCommands[drawCommandList];
+    drawBandCommandCount = drawCommandCount;
+    drawBandPalette      = activePalette;
+    drawBandPalette32    = activePalette32;
+    drawCommandList ^= 1;
+    drawCommandCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(drawBandMutex);
+        drawBandsLeft = drawBandCount - drawBandFirstThread;
+        ++drawBandJob;
+    }
+    drawBandsBusy = true;
+    drawBandStart.notify_all();
+
+    if (drawBandFirstThread) {
+        recordDrawCommands = false;
+        ReplayDrawCommands(0);
+        recordDrawCommands = true;
+        WaitForDrawBands();
+    }
+}
+
+void ReleaseDrawBands()
+{
+    WaitForDrawBands();
+    {
+        std::lock_guard<std::mutex> lock(drawBandMutex);
+        drawBandsExit = true;
+    }
+    drawBandStart.notify_all();
+    for (int b = drawBandFirstThread; b < drawBandCount; ++b) drawBandThreads[b].join();
+    drawBandCount      = 0;
+    drawCommandCount   = 0;
+    recordDrawCommands = false;
+}
+#endif
+
+void FlushDrawCommands()
+{
+#if RETRO_USE_BAND_RENDERING
+    SubmitDrawCommands();
+    WaitForDrawBands();
+#endif
+}
+
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+inline void FillSpan(ushort *frameBufferPtr, ushort colour, int count);
+#endif
+
 void ClearScreen(byte index)
 {
+    FlushDrawCommands();
     ushort colour       = activePalette[index];
 
 #if RETRO_USING_C2D
@@ -638,6 +947,7 @@ void ClearScreen(byte index)
 #endif
 
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
+    // left as a plain loop, compilers vectorize a whole screen fill on their own at least as well as FillSpan (see BenchmarkDrawingSpans)
     ushort *framebuffer = Engine.frameBuffer;
     int cnt             = SCREEN_XSIZE * SCREEN_YSIZE;
 
@@ -665,6 +975,7 @@ void SetScreenSize(int width, int height)
 
 void CopyFrameOverlay2x()
 {
+    FlushDrawCommands();
     ushort *frameBuffer   = &Engine.frameBuffer[((SCREEN_YSIZE / 2) + 12) * SCREEN_XSIZE];
     ushort *frameBuffer2x = Engine.frameBuffer2x;
 
@@ -707,12 +1018,39 @@ void DrawObjectList(int Layer)
         if (type) {
             activePlayer = 0;
             if (scriptData[objectScriptList[type].subDraw.scriptCodePtr] > 0)
-                ProcessScript(objectScriptList[type].subDraw.scriptCodePtr, objectScriptList[type].subDraw.jumpTablePtr, SUB_DRAW);
+                ProcessObjectScript(type, &objectScriptList[type].subDraw, SUB_DRAW);
         }
     }
 }
 void DrawStageGFX(void)
 {
+#if RETRO_USE_BAND_RENDERING
+    // scripts run in between draws, so everything up to the next state change is recorded then rasterized in bands
+    if (!drawBandCount)
+        InitDrawBands();
+    recordDrawCommands = drawBandCount > 1 || Engine.deferredDrawing;
+#endif
+
+#if RETRO_USE_PALETTE_FADE
+    // the fade drawn over everything at the end can be applied to the palettes everything's drawn with instead, unless something in the
+    // draw lists can draw a blend with what's under it, which would come out different
+    bool paletteFade = Engine.paletteFade && renderType == RENDER_SW && fadeMode > 0 && fadeA > 0 && fadeA < 0xFF;
+    for (int l = 0; l < 4; ++l) {
+        // HQ skies aren't drawn with the palettes
+        if (activeTileLayers[l] < LAYER_COUNT && stageLayouts[activeTileLayers[l]].type == LAYER_3DSKY && Engine.useHQModes)
+            paletteFade = false;
+    }
+    for (int l = 0; l < DRAWLAYER_COUNT && paletteFade; ++l) {
+        DrawListEntry *list = &drawListEntries[l];
+        for (int i = 0; i < list->listSize && paletteFade; ++i) {
+            if (objectScriptList[objectEntityList[list->entityRefs[i]].type].blocksPaletteFade)
+                paletteFade = false;
+        }
+    }
+    if (paletteFade)
+        BeginPaletteFade(fadeR, fadeG, fadeB, fadeA);
+#endif
+
     waterDrawPos = waterLevel - yScrollOffset;
     if (waterDrawPos < 0)
         waterDrawPos = 0;
@@ -821,15 +1159,22 @@ void DrawStageGFX(void)
 #endif
     DrawObjectList(6);
 
+#if RETRO_USE_PALETTE_FADE
+    // the palette overlay, and anything drawn between frames, wants the real colours
+    bool paletteFaded = SuspendPaletteFade();
+#else
+    bool paletteFaded = false;
+#endif
     if (drawStageGFXHQ) {
         CopyFrameOverlay2x();
         if (fadeMode > 0) {
-            DrawRectangle(0, 0, SCREEN_XSIZE, SCREEN_YSIZE, fadeR, fadeG, fadeB, fadeA);
+            if (!paletteFaded)
+                DrawRectangle(0, 0, SCREEN_XSIZE, SCREEN_YSIZE, fadeR, fadeG, fadeB, fadeA);
             SetFadeHQ(fadeR, fadeG, fadeB, fadeA);
         }
     }
     else {
-        if (fadeMode > 0) {
+        if (fadeMode > 0 && !paletteFaded) {
             DrawRectangle(0, 0, SCREEN_XSIZE, SCREEN_YSIZE, fadeR, fadeG, fadeB, fadeA);
         }
     }
@@ -848,12 +1193,18 @@ void DrawStageGFX(void)
     }
 #endif
 
+#if RETRO_USE_BAND_RENDERING
+    FlushDrawCommands();
+    recordDrawCommands = false;
+#endif
 }
 
 void DrawHLineScrollLayer(int layerID)
 {
+#if RETRO_USE_BAND_RENDERING
+    WaitForDrawBands(); // a layer that's still rasterizing reads the parallax positions stepped below
+#endif
     TileLayer *layer = &stageLayouts[activeTileLayers[layerID]];
-    int screenwidth16       = (SCREEN_XSIZE >> 4) - 1;		 	// tiles onscreen
     int layerwidth          = layer->width;
     int layerheight         = layer->height;
     bool aboveMidPoint      = layerID >= tLayerMidPoint;
@@ -901,9 +1252,8 @@ void DrawHLineScrollLayer(int layerID)
         lastXSize = layerwidth;
     }
 
-    ushort *frameBufferPtr = Engine.frameBuffer;
-    byte *lineBuffer       = gfxLineBuffer;
-    int tileYPos           = yscrollOffset % (layerheight << 7);
+#if RETRO_USING_C2D
+    int tileYPos = yscrollOffset % (layerheight << 7);
     if (tileYPos < 0)
         tileYPos += layerheight << 7;
     byte *scrollIndex = &lineScroll[tileYPos];
@@ -911,7 +1261,6 @@ void DrawHLineScrollLayer(int layerID)
     int chunkY        = tileYPos >> 7;
     int tileY         = (tileYPos & 0x7F) >> 4;
 
-#if RETRO_USING_C2D
     clearScreen = 1;
 
     scrollIndex = &lineScroll[(tileYPos / 16) * 16];
@@ -970,10 +1319,165 @@ void DrawHLineScrollLayer(int layerID)
     }  
 #endif
 
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        // the scroll state above has been stepped, the lines themselves only read it so they can go out to the bands
+        AddDrawCommand(DRAWCMD_HLINESCROLLLAYER, activeTileLayers[layerID], yscrollOffset, layer->deformationOffset, layer->deformationOffsetW,
+                       aboveMidPoint);
+        SubmitDrawCommands();
+        return;
+    }
+#endif
+    DrawHLineScrollLines(activeTileLayers[layerID], yscrollOffset, layer->deformationOffset, layer->deformationOffsetW, aboveMidPoint);
+#endif
+}
+#if RETRO_USE_TILEROW_CACHE && RETRO_RENDERTYPE == RETRO_SW_RENDER
+inline void DrawSpriteSpan(ushort *frameBufferPtr, const byte *gfxData, int step, int count, const ushort *palette);
+
+// Fills row with the palette indices of one screen-wide line of a layer starting at chunkX, 0 where a tile is on the other plane
+// Returns false if nothing on the line is visible
+static bool BuildTileRow(byte *row, TileLayer *layer, int chunkX, int chunkY, int tileY, int tileY16, bool aboveMidPoint)
+{
+    int chunkXPos  = chunkX >> 7;
+    int chunkTileX = (chunkX & 0x7F) >> 4;
+    int tilePxXPos = chunkX & 0xF;
+    int chunk      = (layer->tiles[chunkXPos + (chunkY << 8)] << 6) + chunkTileX + 8 * tileY;
+    int lineRemain = SCREEN_XSIZE;
+    bool visible   = false;
+
+    while (lineRemain > 0) {
+        int tilePxLineCnt = TILE_SIZE - tilePxXPos;
+        if (tilePxLineCnt > lineRemain)
+            tilePxLineCnt = lineRemain;
+
+        const byte *gfxDataPtr = NULL;
+        int step               = 1;
+        if (tiles128x128.visualPlane[chunk] == (byte)aboveMidPoint) {
+            int direction = tiles128x128.direction[chunk];
+            gfxDataPtr    = &tilesetGFXData[tiles128x128.gfxDataPos[chunk]];
+#if RETRO_USE_FLIPPED_TILESET
+            if (flippedTilesetGFXData && direction != FLIP_NO && direction <= FLIP_XY) {
+                gfxDataPtr = &flippedTilesetGFXData[(direction - 1) * TILESET_SIZE + tiles128x128.gfxDataPos[chunk]];
+                direction  = FLIP_NO;
+            }
+#endif
+            switch (direction) {
+                case FLIP_NO: gfxDataPtr += TILE_SIZE * tileY16 + tilePxXPos; break;
+                case FLIP_X:
+                    gfxDataPtr += TILE_SIZE * tileY16 + 0xF - tilePxXPos;
+                    step = -1;
+                    break;
+                case FLIP_Y: gfxDataPtr += TILE_SIZE * (0xF - tileY16) + tilePxXPos; break;
+                case FLIP_XY:
+                    gfxDataPtr += TILE_SIZE * (0xF - tileY16) + 0xF - tilePxXPos;
+                    step = -1;
+                    break;
+                default: gfxDataPtr = NULL; break;
+            }
+        }
 
-    // Draw Above Water (if applicable)
+        if (gfxDataPtr && step > 0) {
+            // a straight copy the compiler can vectorize, every tile is one of these with the flipped tileset
+            byte opaque = 0;
+            for (int i = 0; i < tilePxLineCnt; ++i) {
+                row[i] = gfxDataPtr[i];
+                opaque |= gfxDataPtr[i];
+            }
+            visible |= opaque > 0;
+        }
+        else if (gfxDataPtr) {
+            for (int i = 0; i < tilePxLineCnt; ++i) {
+                row[i] = *gfxDataPtr;
+                visible |= *gfxDataPtr > 0;
+                gfxDataPtr += step;
+            }
+        }
+        else {
+            memset(row, 0, tilePxLineCnt);
+        }
+        row += tilePxLineCnt;
+        lineRemain -= tilePxLineCnt;
+        tilePxXPos = 0;
+
+        if (++chunkTileX <= 7) {
+            ++chunk;
+        }
+        else {
+            chunkTileX = 0;
+            if (++chunkXPos == layer->width)
+                chunkXPos = 0;
+            chunk = (layer->tiles[chunkXPos + (chunkY << 8)] << 6) + 8 * tileY;
+        }
+    }
+    return visible;
+}
+#endif
+
+// Rasterizes the lines of an H-scroll layer that fall between drawClipTop & drawClipBottom, once DrawHLineScrollLayer has scrolled it
+// Everything scripts can change mid-frame is passed in, so a deferred draw sees the layer as it was when it was queued
+void DrawHLineScrollLines(int layoutID, int yscrollOffset, int deformationOffset, int deformationOffsetW, bool aboveMidPoint)
+{
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
-    int drawableLines[2] = { waterDrawPos, SCREEN_YSIZE - waterDrawPos };
+    TileLayer *layer  = &stageLayouts[layoutID];
+#if !RETRO_USE_TILEROW_CACHE
+    int screenwidth16 = (SCREEN_XSIZE >> 4) - 1; // tiles onscreen
+#endif
+    int layerwidth    = layer->width;
+    int layerheight   = layer->height;
+
+    byte *lineScroll = layer->lineScroll;
+    int *deformationData;
+    int *deformationDataW;
+    if (layoutID) { // BG Layer
+        deformationData  = &bgDeformationData2[(byte)(yscrollOffset + deformationOffset)];
+        deformationDataW = &bgDeformationData3[(byte)(yscrollOffset + waterDrawPos + deformationOffsetW)];
+    }
+    else { // FG Layer
+        deformationData  = &bgDeformationData0[(byte)(yscrollOffset + deformationOffset)];
+        deformationDataW = &bgDeformationData1[(byte)(yscrollOffset + waterDrawPos + deformationOffsetW)];
+    }
+
+    ushort *frameBufferPtr = Engine.frameBuffer;
+    byte *lineBuffer       = gfxLineBuffer;
+    int tileYPos           = yscrollOffset % (layerheight << 7);
+    if (tileYPos < 0)
+        tileYPos += layerheight << 7;
+    byte *scrollIndex = &lineScroll[tileYPos];
+    int tileY16       = tileYPos & 0xF;
+    int chunkY        = tileYPos >> 7;
+    int tileY         = (tileYPos & 0x7F) >> 4;
+
+    // step over the lines above this band
+    for (int y = 0; y < drawClipTop; ++y) {
+        if (y < waterDrawPos)
+            ++deformationData;
+        else
+            ++deformationDataW;
+        ++scrollIndex;
+        ++lineBuffer;
+        frameBufferPtr += SCREEN_XSIZE;
+
+        if (++tileY16 > TILE_SIZE - 1) {
+            tileY16 = 0;
+            ++tileY;
+        }
+        if (tileY > 7) {
+            if (++chunkY == layerheight) {
+                chunkY = 0;
+                scrollIndex -= 0x80 * layerheight;
+            }
+            tileY = 0;
+        }
+    }
+
+    // Draw Above Water (if applicable)
+    int waterLine = waterDrawPos;
+    if (waterLine < drawClipTop)
+        waterLine = drawClipTop;
+    if (waterLine > drawClipBottom)
+        waterLine = drawClipBottom;
+    int drawableLines[2] = { waterLine - drawClipTop, drawClipBottom - waterLine };
     for (int i = 0; i < 2; ++i) {
         while (drawableLines[i]-- > 0) {
             activePalette = fullPalette[*lineBuffer];
@@ -999,6 +1503,25 @@ void DrawHLineScrollLayer(int layerID)
                 chunkX += fullLayerwidth;
             if (chunkX >= fullLayerwidth)
                 chunkX -= fullLayerwidth;
+#if RETRO_USE_TILEROW_CACHE
+            // lines that haven't scrolled since they were last drawn reuse the row they were built from, only the palette is looked up again
+            int screenY                = (int)(lineBuffer - gfxLineBuffer) - 1;
+            int rowYPos                = (chunkY << 7) + (tileY << 4) + tileY16;
+            int cacheRow               = (layoutID * 2 + aboveMidPoint) * SCREEN_YSIZE + screenY;
+            TileRowCacheLine *rowCache = &tileRowCache[layoutID * 2 + aboveMidPoint][screenY];
+            byte *row                  = &tileRowCacheData[cacheRow * SCREEN_XSIZE];
+            if (rowCache->cacheID != tileRowCacheID || rowCache->chunkX != chunkX || rowCache->tileYPos != rowYPos
+                || rowCache->layerWidth != layerwidth) {
+                rowCache->cacheID    = tileRowCacheID;
+                rowCache->chunkX     = chunkX;
+                rowCache->tileYPos   = rowYPos;
+                rowCache->layerWidth = layerwidth;
+                rowCache->blank      = !BuildTileRow(row, layer, chunkX, chunkY, tileY, tileY16, aboveMidPoint);
+            }
+            if (!rowCache->blank)
+                DrawSpriteSpan(frameBufferPtr, row, 1, SCREEN_XSIZE, activePalette);
+            frameBufferPtr += SCREEN_XSIZE;
+#else
             int chunkXPos         = chunkX >> 7;
             int tilePxXPos        = chunkX & 0xF;
             int tileXPxRemain     = TILE_SIZE - tilePxXPos;
@@ -1415,6 +1938,7 @@ void DrawHLineScrollLayer(int layerID)
                     frameBufferPtr += tilePxLineCnt;
                 }
             }
+#endif
 
             if (++tileY16 > TILE_SIZE - 1) {
                 tileY16 = 0;
@@ -1435,6 +1959,7 @@ void DrawHLineScrollLayer(int layerID)
 }
 void DrawVLineScrollLayer(int layerID)
 {
+    FlushDrawCommands();
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     TileLayer *layer = &stageLayouts[activeTileLayers[layerID]];
     int layerwidth          = layer->width;
@@ -1940,53 +2465,76 @@ void DrawVLineScrollLayer(int layerID)
 	// disabled in HW render mode
 #endif
 }
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+// Draws a floor line across one 16x16 tile until it steps off it, returns how many pixels that was.
+// direction is always a constant at the call sites, so each flip gets its own loop once this is inlined
+inline int Draw3DFloorSpan(ushort *frameBufferPtr, const byte *tilePixels, int direction, int &XPos, int &YPos, int XBuffer, int YBuffer, int count,
+                           const ushort *palette)
+{
+    int tileX = XPos >> 16;
+    int tileY = YPos >> 16;
+    int drawn = 0;
+    do {
+        int pixelX = (XPos >> 12) & 0xF;
+        int pixelY = (YPos >> 12) & 0xF;
+        byte index = 0;
+        switch (direction) {
+            case FLIP_NO: index = tilePixels[TILE_SIZE * pixelY + pixelX]; break;
+            case FLIP_X: index = tilePixels[TILE_SIZE * pixelY + 0xF - pixelX]; break;
+            case FLIP_Y: index = tilePixels[TILE_SIZE * (0xF - pixelY) + pixelX]; break;
+            case FLIP_XY: index = tilePixels[TILE_SIZE * (0xF - pixelY) + 0xF - pixelX]; break;
+            default: index = *tilePixels; break;
+        }
+        if (index > 0)
+            frameBufferPtr[drawn] = palette[index];
+        XPos += XBuffer;
+        YPos += YBuffer;
+    } while (++drawn < count && (XPos >> 16) == tileX && (YPos >> 16) == tileY);
+    return drawn;
+}
+
+// Whether a 3D layer's line table needs rebuilding because the layer's height or angle, or the screen width, changed since it was built.
+// The table is marked as built for the new values
+inline bool Layer3DLinesChanged(Layer3DLineTable *table, TileLayer *layer)
+{
+    if (table->YPos == layer->YPos && table->angle == layer->angle && table->screenWidth == SCREEN_XSIZE)
+        return false;
+    table->YPos        = layer->YPos;
+    table->angle       = layer->angle;
+    table->screenWidth = SCREEN_XSIZE;
+    return true;
+}
+#endif
+
 void Draw3DFloorLayer(int layerID)
 {
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     TileLayer *layer = &stageLayouts[activeTileLayers[layerID]];
-    int layerWidth          = layer->width << 7;
-    int layerHeight         = layer->height << 7;
-    int layerYPos           = layer->YPos;
-    int layerZPos           = layer->ZPos;
-    int sinValue            = sinM[layer->angle];
-    int cosValue            = cosM[layer->angle];
-    byte *linePtr           = gfxLineBuffer;
-    ushort *frameBufferPtr  = &Engine.frameBuffer[((SCREEN_YSIZE / 2) + 12) * SCREEN_XSIZE];
-    int layerXPos           = layer->XPos >> 4;
-    int ZBuffer             = layerZPos >> 4;
-    for (int i = 4; i < ((SCREEN_YSIZE / 2) - 8); ++i) {
-        if (!(i & 1)) {
-            activePalette   = fullPalette[*linePtr];
-            activePalette32 = fullPalette32[*linePtr];
-            linePtr++;
-        }
-        int XBuffer            = layerYPos / (i << 9) * -cosValue >> 8;
-        int YBuffer            = sinValue * (layerYPos / (i << 9)) >> 8;
-        int XPos               = layerXPos + (3 * sinValue * (layerYPos / (i << 9)) >> 2) - XBuffer * SCREEN_CENTERX;
-        int YPos               = ZBuffer + (3 * cosValue * (layerYPos / (i << 9)) >> 2) - YBuffer * SCREEN_CENTERX;
-        int lineBuffer         = 0;
-        while (lineBuffer < SCREEN_XSIZE) {
-            int tileX = XPos >> 12;
-            int tileY = YPos >> 12;
-            if (tileX > -1 && tileX < layerWidth && tileY > -1 && tileY < layerHeight) {
-                int chunk       = tile3DFloorBuffer[(YPos >> 16 << 8) + (XPos >> 16)];
-                byte *tilePixel = &tilesetGFXData[tiles128x128.gfxDataPos[chunk]];
-                switch (tiles128x128.direction[chunk]) {
-                    case FLIP_NO: tilePixel += 16 * (tileY & 0xF) + (tileX & 0xF); break;
-                    case FLIP_X: tilePixel += 16 * (tileY & 0xF) + 15 - (tileX & 0xF); break;
-                    case FLIP_Y: tilePixel += (tileX & 0xF) + SCREEN_YSIZE - 16 * (tileY & 0xF); break;
-                    case FLIP_XY: tilePixel += 15 - (tileX & 0xF) + SCREEN_YSIZE - 16 * (tileY & 0xF); break;
-                    default: break;
-                }
-                if (*tilePixel > 0)
-                    *frameBufferPtr = activePalette[*tilePixel];
-            }
-            ++frameBufferPtr;
-            ++lineBuffer;
-            XPos += XBuffer;
-            YPos += YBuffer;
+    if (Layer3DLinesChanged(&floor3DLineTable, layer)) {
+#if RETRO_USE_BAND_RENDERING
+        WaitForDrawBands(); // a floor that's still rasterizing reads the table
+#endif
+        int sinValue = sinM[layer->angle];
+        int cosValue = cosM[layer->angle];
+        for (int i = 4; i < ((SCREEN_YSIZE / 2) - 8); ++i) {
+            Layer3DLine *line = &floor3DLineTable.lines[i];
+            int depth         = layer->YPos / (i << 9);
+            line->XBuffer     = depth * -cosValue >> 8;
+            line->YBuffer     = sinValue * depth >> 8;
+            line->XPos        = (3 * sinValue * depth >> 2) - line->XBuffer * SCREEN_CENTERX;
+            line->YPos        = (3 * cosValue * depth >> 2) - line->YBuffer * SCREEN_CENTERX;
         }
     }
+
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        // every line only reads the table & the tiles, so the bands can each take their own rows
+        AddDrawCommand(DRAWCMD_3DFLOORLAYER, activeTileLayers[layerID], layer->XPos >> 4, layer->ZPos >> 4);
+        SubmitDrawCommands();
+        return;
+    }
+#endif
+    Draw3DFloorLines(activeTileLayers[layerID], layer->XPos >> 4, layer->ZPos >> 4);
 #endif
 #if RETRO_USING_C2D
 
@@ -1994,6 +2542,59 @@ void Draw3DFloorLayer(int layerID)
     // TODO: this
 #endif
 }
+// Rasterizes the lines of a 3D floor layer that fall between drawClipTop & drawClipBottom from floor3DLineTable
+void Draw3DFloorLines(int layoutID, int layerXPos, int ZBuffer)
+{
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+    TileLayer *layer = &stageLayouts[layoutID];
+    int layerWidth   = layer->width << 3; // in tiles, a floor tile is in bounds when all its pixels are
+    int layerHeight  = layer->height << 3;
+
+    // line i is drawn to row i + (SCREEN_YSIZE / 2) + 8, with the palette of gfxLineBuffer[(i - 4) / 2]
+    int firstLine = drawClipTop - ((SCREEN_YSIZE / 2) + 8);
+    int lastLine  = drawClipBottom - ((SCREEN_YSIZE / 2) + 8);
+    if (firstLine < 4)
+        firstLine = 4;
+    if (lastLine > (SCREEN_YSIZE / 2) - 8)
+        lastLine = (SCREEN_YSIZE / 2) - 8;
+
+    ushort *frameBufferPtr = &Engine.frameBuffer[(firstLine + (SCREEN_YSIZE / 2) + 8) * SCREEN_XSIZE];
+    for (int i = firstLine; i < lastLine; ++i) {
+        activePalette     = fullPalette[gfxLineBuffer[(i - 4) >> 1]];
+        activePalette32   = fullPalette32[gfxLineBuffer[(i - 4) >> 1]];
+        Layer3DLine *line = &floor3DLineTable.lines[i];
+        int XPos          = layerXPos + line->XPos;
+        int YPos          = ZBuffer + line->YPos;
+        int lineBuffer    = 0;
+        while (lineBuffer < SCREEN_XSIZE) {
+            int tileX = XPos >> 16;
+            int tileY = YPos >> 16;
+            int count = SCREEN_XSIZE - lineBuffer;
+            if (tileX > -1 && tileX < layerWidth && tileY > -1 && tileY < layerHeight) {
+                int chunk        = tile3DFloorBuffer[(tileY << 8) + tileX];
+                byte *tilePixels = &tilesetGFXData[tiles128x128.gfxDataPos[chunk]];
+                ushort *dst      = &frameBufferPtr[lineBuffer];
+                switch (tiles128x128.direction[chunk]) {
+                    case FLIP_NO: count = Draw3DFloorSpan(dst, tilePixels, FLIP_NO, XPos, YPos, line->XBuffer, line->YBuffer, count, activePalette); break;
+                    case FLIP_X: count = Draw3DFloorSpan(dst, tilePixels, FLIP_X, XPos, YPos, line->XBuffer, line->YBuffer, count, activePalette); break;
+                    case FLIP_Y: count = Draw3DFloorSpan(dst, tilePixels, FLIP_Y, XPos, YPos, line->XBuffer, line->YBuffer, count, activePalette); break;
+                    case FLIP_XY: count = Draw3DFloorSpan(dst, tilePixels, FLIP_XY, XPos, YPos, line->XBuffer, line->YBuffer, count, activePalette); break;
+                    default: count = Draw3DFloorSpan(dst, tilePixels, -1, XPos, YPos, line->XBuffer, line->YBuffer, count, activePalette); break;
+                }
+                lineBuffer += count;
+            }
+            else {
+                // off the layer, skip to wherever the line next changes tile
+                do {
+                    XPos += line->XBuffer;
+                    YPos += line->YBuffer;
+                } while (++lineBuffer < SCREEN_XSIZE && (XPos >> 16) == tileX && (YPos >> 16) == tileY);
+            }
+        }
+        frameBufferPtr += SCREEN_XSIZE;
+    }
+#endif
+}
 void Draw3DSkyLayer(int layerID)
 {
     TileLayer *layer = &stageLayouts[activeTileLayers[layerID]];
@@ -2005,70 +2606,29 @@ void Draw3DSkyLayer(int layerID)
     int layerXPos           = layer->XPos >> 4;
     int layerZPos           = layer->ZPos >> 4;
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
-    ushort *frameBufferPtr  = &Engine.frameBuffer[((SCREEN_YSIZE / 2) + 12) * SCREEN_XSIZE];
-    ushort *bufferPtr       = Engine.frameBuffer2x;
-    if (!drawStageGFXHQ)
-        bufferPtr = &Engine.frameBuffer[((SCREEN_YSIZE / 2) + 12) * SCREEN_XSIZE];
-    byte *linePtr           = &gfxLineBuffer[((SCREEN_YSIZE / 2) + 12)];
-
-    for (int i = TILE_SIZE / 2; i < SCREEN_YSIZE - TILE_SIZE; ++i) {
-        if (!(i & 1)) {
-            activePalette   = fullPalette[*linePtr];
-            activePalette32 = fullPalette32[*linePtr];
-            linePtr++;
-        }
-        int xBuffer    = layerYPos / (i << 8) * -cosValue >> 9;
-        int yBuffer    = sinValue * (layerYPos / (i << 8)) >> 9;
-        int XPos       = layerXPos + (3 * sinValue * (layerYPos / (i << 8)) >> 2) - xBuffer * SCREEN_XSIZE;
-        int YPos       = layerZPos + (3 * cosValue * (layerYPos / (i << 8)) >> 2) - yBuffer * SCREEN_XSIZE;
-        int lineBuffer = 0;
-        while (lineBuffer < SCREEN_XSIZE * 2) {
-            int tileX = XPos >> 12;
-            int tileY = YPos >> 12;
-            if (tileX > -1 && tileX < layerWidth && tileY > -1 && tileY < layerHeight) {
-                int chunk       = tile3DFloorBuffer[(YPos >> 16 << 8) + (XPos >> 16)];
-                byte *tilePixel = &tilesetGFXData[tiles128x128.gfxDataPos[chunk]];
-                switch (tiles128x128.direction[chunk]) {
-                    case FLIP_NO: tilePixel += TILE_SIZE * (tileY & 0xF) + (tileX & 0xF); break;
-                    case FLIP_X: tilePixel += TILE_SIZE * (tileY & 0xF) + 0xF - (tileX & 0xF); break;
-                    case FLIP_Y: tilePixel += (tileX & 0xF) + SCREEN_YSIZE - TILE_SIZE * (tileY & 0xF); break;
-                    case FLIP_XY: tilePixel += 0xF - (tileX & 0xF) + SCREEN_YSIZE - TILE_SIZE * (tileY & 0xF); break;
-                    default: break;
-                }
-
-                if (*tilePixel > 0)
-                    *bufferPtr = activePalette[*tilePixel];
-                else if (drawStageGFXHQ)
-                    *bufferPtr = *frameBufferPtr;
-            }
-            else if (drawStageGFXHQ) {
-                *bufferPtr = *frameBufferPtr;
-            }
-            if (lineBuffer & 1)
-                ++frameBufferPtr;
-            if (drawStageGFXHQ) {
-                bufferPtr++;
-            }
-            else if (lineBuffer & 1) {
-                ++bufferPtr;
-            }
-            lineBuffer++;
-            XPos += xBuffer;
-            YPos += yBuffer;
-        }
-        if (!(i & 1))
-            frameBufferPtr -= SCREEN_XSIZE;
-        if (!(i & 1) && !drawStageGFXHQ) {
-            bufferPtr -= SCREEN_XSIZE;
+    if (Layer3DLinesChanged(&sky3DLineTable, layer)) {
+#if RETRO_USE_BAND_RENDERING
+        WaitForDrawBands(); // a sky that's still rasterizing reads the table
+#endif
+        for (int i = TILE_SIZE / 2; i < SCREEN_YSIZE - TILE_SIZE; ++i) {
+            Layer3DLine *line = &sky3DLineTable.lines[i];
+            int depth         = layerYPos / (i << 8);
+            line->XBuffer     = depth * -cosValue >> 9;
+            line->YBuffer     = sinValue * depth >> 9;
+            line->XPos        = (3 * sinValue * depth >> 2) - line->XBuffer * SCREEN_XSIZE;
+            line->YPos        = (3 * cosValue * depth >> 2) - line->YBuffer * SCREEN_XSIZE;
         }
     }
 
-    if (drawStageGFXHQ) {
-        frameBufferPtr = &Engine.frameBuffer[((SCREEN_YSIZE / 2) + 12) * SCREEN_XSIZE];
-        int cnt        = ((SCREEN_YSIZE / 2) - 12) * SCREEN_XSIZE;
-        while (cnt--) *frameBufferPtr++ = 0xF81F; // Magenta
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_3DSKYLAYER, activeTileLayers[layerID], layerXPos, layerZPos, drawStageGFXHQ);
+        SubmitDrawCommands();
+        return;
     }
 #endif
+    Draw3DSkyLines(activeTileLayers[layerID], layerXPos, layerZPos, drawStageGFXHQ);
+#endif
 
 #if RETRO_USING_C2D
     int sx = 0, sy = 0;
@@ -2101,54 +2661,389 @@ void Draw3DSkyLayer(int layerID)
 #endif
 }
 
-void DrawRectangle(int XPos, int YPos, int width, int height, int R, int G, int B, int A)
+// Rasterizes the rows of a 3D sky layer that fall between drawClipTop & drawClipBottom from sky3DLineTable.
+// Each row is drawn from two lines at twice the width, into frameBuffer2x when HQ, where the row's then cleared to magenta for the overlay
+void Draw3DSkyLines(int layoutID, int layerXPos, int layerZPos, bool hq)
 {
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
-    if (width + XPos > SCREEN_XSIZE)
-        width = SCREEN_XSIZE - XPos;
-    if (XPos < 0) {
-        width += XPos;
-        XPos = 0;
-    }
+    TileLayer *layer = &stageLayouts[layoutID];
+    int layerWidth   = layer->width << 7;
+    int layerHeight  = layer->height << 7;
+
+    int firstRow = drawClipTop > (SCREEN_YSIZE / 2) + 12 ? drawClipTop : (SCREEN_YSIZE / 2) + 12;
+    int lastRow  = drawClipBottom;
+    for (int row = firstRow; row < lastRow; ++row) {
+        activePalette   = fullPalette[gfxLineBuffer[row]];
+        activePalette32 = fullPalette32[gfxLineBuffer[row]];
+
+        // lines 8 & 9 make up the first row, then 10 & 11...
+        int firstLine = TILE_SIZE / 2 + 2 * (row - ((SCREEN_YSIZE / 2) + 12));
+        for (int i = firstLine; i < firstLine + 2; ++i) {
+            ushort *frameBufferPtr = &Engine.frameBuffer[row * SCREEN_XSIZE];
+            ushort *bufferPtr      = hq ? &Engine.frameBuffer2x[(i - TILE_SIZE / 2) * SCREEN_XSIZE * 2] : frameBufferPtr;
+            int xBuffer            = sky3DLineTable.lines[i].XBuffer;
+            int yBuffer            = sky3DLineTable.lines[i].YBuffer;
+            int XPos               = layerXPos + sky3DLineTable.lines[i].XPos;
+            int YPos               = layerZPos + sky3DLineTable.lines[i].YPos;
+            int lineBuffer         = 0;
+            while (lineBuffer < SCREEN_XSIZE * 2) {
+                int tileX = XPos >> 12;
+                int tileY = YPos >> 12;
+                if (tileX > -1 && tileX < layerWidth && tileY > -1 && tileY < layerHeight) {
+                    int chunk       = tile3DFloorBuffer[(YPos >> 16 << 8) + (XPos >> 16)];
+                    byte *tilePixel = &tilesetGFXData[tiles128x128.gfxDataPos[chunk]];
+                    switch (tiles128x128.direction[chunk]) {
+                        case FLIP_NO: tilePixel += TILE_SIZE * (tileY & 0xF) + (tileX & 0xF); break;
+                        case FLIP_X: tilePixel += TILE_SIZE * (tileY & 0xF) + 0xF - (tileX & 0xF); break;
+                        case FLIP_Y: tilePixel += (tileX & 0xF) + SCREEN_YSIZE - TILE_SIZE * (tileY & 0xF); break;
+                        case FLIP_XY: tilePixel += 0xF - (tileX & 0xF) + SCREEN_YSIZE - TILE_SIZE * (tileY & 0xF); break;
+                        default: break;
+                    }
 
-    if (height + YPos > SCREEN_YSIZE)
-        height = SCREEN_YSIZE - YPos;
-    if (YPos < 0) {
-        height += YPos;
-        YPos = 0;
-    }
-    if (width <= 0 || height <= 0 || A <= 0)
-        return;
-    if (A > 0xFF)
-        A = 0xFF;
-    int pitch              = SCREEN_XSIZE - width;
-    ushort *frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
-    ushort clr             = RGB888_TO_RGB565(R, G, B);
-    if (A == 0xFF) {
-        int h = height;
-        while (h--) {
-            int w = width;
-            while (w--) {
-                *frameBufferPtr = clr;
-                ++frameBufferPtr;
+                    if (*tilePixel > 0)
+                        *bufferPtr = activePalette[*tilePixel];
+                    else if (hq)
+                        *bufferPtr = *frameBufferPtr;
+                }
+                else if (hq) {
+                    *bufferPtr = *frameBufferPtr;
+                }
+                if (lineBuffer & 1)
+                    ++frameBufferPtr;
+                if (hq)
+                    bufferPtr++;
+                else if (lineBuffer & 1)
+                    ++bufferPtr;
+                lineBuffer++;
+                XPos += xBuffer;
+                YPos += yBuffer;
             }
-            frameBufferPtr += pitch;
         }
+
+        if (hq)
+            FillSpan(&Engine.frameBuffer[row * SCREEN_XSIZE], 0xF81F, SCREEN_XSIZE); // Magenta
     }
-    else {
-        int h = height;
-        while (h--) {
-            int w = width;
-            while (w--) {
-                short *blendPtrB = &blendLookupTable[BLENDTABLE_XSIZE * (0xFF - A)];
-                short *blendPtrA = &blendLookupTable[BLENDTABLE_XSIZE * A];
-                *frameBufferPtr  = (blendPtrB[*frameBufferPtr & (BLENDTABLE_XSIZE-1)] + blendPtrA[((byte)(B >> 3) | (byte)(32 * (G >> 2))) & 0x1F])
-                                  | ((blendPtrB[(*frameBufferPtr & 0x7E0) >> 6] + blendPtrA[(clr & 0x7E0) >> 6]) << 6)
-                                  | ((blendPtrB[(*frameBufferPtr & 0xF800) >> 11] + blendPtrA[(clr & 0xF800) >> 11]) << 11);
-                ++frameBufferPtr;
-            }
-            frameBufferPtr += pitch;
+#endif
+}
+
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER && (RETRO_USING_SSE2 || RETRO_USING_NEON)
+// 8-lane RGB565 blends. These work out blendLookupTable/subtractLookupTable/tintLookupTable arithmetically, channel by channel,
+// so they give bit-identical results to the scalar table path they replace (the tables stay as the tail/fallback path)
+#if RETRO_USING_SSE2
+typedef __m128i PixelVector;
+
+inline PixelVector LoadPixels(const ushort *pixels) { return _mm_loadu_si128((const __m128i *)pixels); }
+inline void StorePixels(ushort *pixels, PixelVector v) { _mm_storeu_si128((__m128i *)pixels, v); }
+inline PixelVector SplatPixels(int value) { return _mm_set1_epi16((short)value); }
+inline PixelVector AndPixels(PixelVector a, PixelVector b) { return _mm_and_si128(a, b); }
+inline PixelVector OrPixels(PixelVector a, PixelVector b) { return _mm_or_si128(a, b); }
+inline PixelVector XorPixels(PixelVector a, PixelVector b) { return _mm_xor_si128(a, b); }
+inline PixelVector AddPixels(PixelVector a, PixelVector b) { return _mm_add_epi16(a, b); }
+inline PixelVector SubPixels(PixelVector a, PixelVector b) { return _mm_subs_epu16(a, b); } // clamps at 0
+inline PixelVector MulPixels(PixelVector a, PixelVector b) { return _mm_mullo_epi16(a, b); }
+inline PixelVector MinPixels(PixelVector a, PixelVector b) { return _mm_min_epi16(a, b); } // lanes never exceed 0x7FFF here
+// keeps dst where index is 0, blended everywhere else
+inline PixelVector MaskPixels(PixelVector index, PixelVector dst, PixelVector blended)
+{
+    PixelVector transparent = _mm_cmpeq_epi16(index, _mm_setzero_si128());
+    return _mm_or_si128(_mm_and_si128(transparent, dst), _mm_andnot_si128(transparent, blended));
+}
+#define ShiftPixelsLeft(v, n)  _mm_slli_epi16(v, n)
+#define ShiftPixelsRight(v, n) _mm_srli_epi16(v, n)
+#else
+typedef uint16x8_t PixelVector;
+
+inline PixelVector LoadPixels(const ushort *pixels) { return vld1q_u16(pixels); }
+inline void StorePixels(ushort *pixels, PixelVector v) { vst1q_u16(pixels, v); }
+inline PixelVector SplatPixels(int value) { return vdupq_n_u16((ushort)value); }
+inline PixelVector AndPixels(PixelVector a, PixelVector b) { return vandq_u16(a, b); }
+inline PixelVector OrPixels(PixelVector a, PixelVector b) { return vorrq_u16(a, b); }
+inline PixelVector XorPixels(PixelVector a, PixelVector b) { return veorq_u16(a, b); }
+inline PixelVector AddPixels(PixelVector a, PixelVector b) { return vaddq_u16(a, b); }
+inline PixelVector SubPixels(PixelVector a, PixelVector b) { return vqsubq_u16(a, b); } // clamps at 0
+inline PixelVector MulPixels(PixelVector a, PixelVector b) { return vmulq_u16(a, b); }
+inline PixelVector MinPixels(PixelVector a, PixelVector b) { return vminq_u16(a, b); }
+// keeps dst where index is 0, blended everywhere else
+inline PixelVector MaskPixels(PixelVector index, PixelVector dst, PixelVector blended)
+{
+    return vbslq_u16(vceqq_u16(index, vdupq_n_u16(0)), dst, blended);
+}
+#define ShiftPixelsLeft(v, n)  vshlq_n_u16(v, n)
+#define ShiftPixelsRight(v, n) vshrq_n_u16(v, n)
+#endif
+
+// the 5-bit channels the blend tables are indexed by (green drops its low bit)
+inline PixelVector GetChannelB(PixelVector v) { return AndPixels(v, SplatPixels(0x1F)); }
+inline PixelVector GetChannelG(PixelVector v) { return AndPixels(ShiftPixelsRight(v, 6), SplatPixels(0x1F)); }
+inline PixelVector GetChannelR(PixelVector v) { return ShiftPixelsRight(v, 11); }
+// blendLookupTable[BLENDTABLE_XSIZE * alpha + x]
+inline PixelVector BlendChannel(PixelVector x, PixelVector alpha) { return ShiftPixelsRight(MulPixels(x, alpha), 8); }
+// subtractLookupTable[BLENDTABLE_XSIZE * alpha + x], x is at most 0x1F so the xor is (BLENDTABLE_XSIZE - 1) - x
+inline PixelVector SubtractChannel(PixelVector x, PixelVector alpha) { return BlendChannel(XorPixels(x, SplatPixels(0x1F)), alpha); }
+
+inline PixelVector BlendAlphaPixels(PixelVector dst, PixelVector src, int alpha)
+{
+    PixelVector alphaA = SplatPixels((BLENDTABLE_YSIZE - 1) - alpha);
+    PixelVector alphaB = SplatPixels(alpha);
+    PixelVector b      = AddPixels(BlendChannel(GetChannelB(dst), alphaA), BlendChannel(GetChannelB(src), alphaB));
+    PixelVector g      = AddPixels(BlendChannel(GetChannelG(dst), alphaA), BlendChannel(GetChannelG(src), alphaB));
+    PixelVector r      = AddPixels(BlendChannel(GetChannelR(dst), alphaA), BlendChannel(GetChannelR(src), alphaB));
+    return OrPixels(b, OrPixels(ShiftPixelsLeft(g, 6), ShiftPixelsLeft(r, 11)));
+}
+
+// green is added at full 6-bit precision, with the table value doubled, the same as the scalar path's << 6 onto (dst & 0x7E0)
+inline PixelVector BlendAdditivePixels(PixelVector dst, PixelVector src, int alpha)
+{
+    PixelVector a = SplatPixels(alpha);
+    PixelVector b = MinPixels(AddPixels(GetChannelB(dst), BlendChannel(GetChannelB(src), a)), SplatPixels(0x1F));
+    PixelVector g = AddPixels(AndPixels(ShiftPixelsRight(dst, 5), SplatPixels(0x3F)), ShiftPixelsLeft(BlendChannel(GetChannelG(src), a), 1));
+    PixelVector r = MinPixels(AddPixels(GetChannelR(dst), BlendChannel(GetChannelR(src), a)), SplatPixels(0x1F));
+    return OrPixels(b, OrPixels(ShiftPixelsLeft(MinPixels(g, SplatPixels(0x3F)), 5), ShiftPixelsLeft(r, 11)));
+}
+
+inline PixelVector BlendSubtractivePixels(PixelVector dst, PixelVector src, int alpha)
+{
+    PixelVector a = SplatPixels(alpha);
+    PixelVector b = SubPixels(GetChannelB(dst), SubtractChannel(GetChannelB(src), a));
+    PixelVector g = SubPixels(AndPixels(ShiftPixelsRight(dst, 5), SplatPixels(0x3F)), ShiftPixelsLeft(SubtractChannel(GetChannelG(src), a), 1));
+    PixelVector r = SubPixels(GetChannelR(dst), SubtractChannel(GetChannelR(src), a));
+    return OrPixels(b, OrPixels(ShiftPixelsLeft(g, 5), ShiftPixelsLeft(r, 11)));
+}
+
+// tintLookupTable: grey level min((b + g + r) / 3 + 6, 31) in every channel. The sum is at most 93, where (sum * 171) >> 9 == sum / 3
+inline PixelVector TintPixels(PixelVector dst)
+{
+    PixelVector sum  = AddPixels(AddPixels(GetChannelB(dst), GetChannelG(dst)), GetChannelR(dst));
+    PixelVector grey = AddPixels(ShiftPixelsRight(MulPixels(sum, SplatPixels(171)), 9), SplatPixels(6));
+    return MulPixels(MinPixels(grey, SplatPixels(0x1F)), SplatPixels(0x841));
+}
+
+// Looks up 8 sprite pixels through palette, returning the OR of their indices so fully transparent runs can be skipped
+inline byte GatherSpritePixels(const byte *gfxData, int step, const ushort *palette, ushort *indices, ushort *colours)
+{
+    byte opaque = 0;
+    for (int i = 0; i < 8; ++i) {
+        byte index = gfxData[i * step];
+        indices[i] = index;
+        colours[i] = palette[index];
+        opaque |= index;
+    }
+    return opaque;
+}
+#endif
+
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+inline void DrawAlphaBlendedSpan(ushort *frameBufferPtr, const byte *gfxData, int count, const ushort *palette, int alpha)
+{
+#if RETRO_USING_SSE2 || RETRO_USING_NEON
+    while (count >= 8) {
+        ushort indices[8];
+        ushort colours[8];
+        if (GatherSpritePixels(gfxData, 1, palette, indices, colours)) {
+            PixelVector dst = LoadPixels(frameBufferPtr);
+            StorePixels(frameBufferPtr, MaskPixels(LoadPixels(indices), dst, BlendAlphaPixels(dst, LoadPixels(colours), alpha)));
         }
+        gfxData += 8;
+        frameBufferPtr += 8;
+        count -= 8;
+    }
+#endif
+
+    short *blendTablePtrA = &blendLookupTable[BLENDTABLE_XSIZE * ((BLENDTABLE_YSIZE - 1) - alpha)];
+    short *blendTablePtrB = &blendLookupTable[BLENDTABLE_XSIZE * alpha];
+    while (count--) {
+        if (*gfxData > 0) {
+            ushort colour   = palette[*gfxData];
+            *frameBufferPtr = (blendTablePtrA[*frameBufferPtr & (BLENDTABLE_XSIZE - 1)] + blendTablePtrB[colour & (BLENDTABLE_XSIZE - 1)])
+                              | ((blendTablePtrA[(*frameBufferPtr & 0x7E0) >> 6] + blendTablePtrB[(colour & 0x7E0) >> 6]) << 6)
+                              | ((blendTablePtrA[(*frameBufferPtr & 0xF800) >> 11] + blendTablePtrB[(colour & 0xF800) >> 11]) << 11);
+        }
+        ++gfxData;
+        ++frameBufferPtr;
+    }
+}
+
+inline void DrawAdditiveBlendedSpan(ushort *frameBufferPtr, const byte *gfxData, int count, const ushort *palette, int alpha)
+{
+#if RETRO_USING_SSE2 || RETRO_USING_NEON
+    while (count >= 8) {
+        ushort indices[8];
+        ushort colours[8];
+        if (GatherSpritePixels(gfxData, 1, palette, indices, colours)) {
+            PixelVector dst = LoadPixels(frameBufferPtr);
+            StorePixels(frameBufferPtr, MaskPixels(LoadPixels(indices), dst, BlendAdditivePixels(dst, LoadPixels(colours), alpha)));
+        }
+        gfxData += 8;
+        frameBufferPtr += 8;
+        count -= 8;
+    }
+#endif
+
+    short *blendTablePtr = &blendLookupTable[BLENDTABLE_XSIZE * alpha];
+    while (count--) {
+        if (*gfxData > 0) {
+            ushort colour   = palette[*gfxData];
+            int v20         = 0;
+            int v21         = 0;
+            int finalColour = 0;
+
+            if (((ushort)blendTablePtr[(colour & 0xF800) >> 11] << 11) + (*frameBufferPtr & 0xF800) <= 0xF800)
+                v20 = ((ushort)blendTablePtr[(colour & 0xF800) >> 11] << 11) + (ushort)(*frameBufferPtr & 0xF800);
+            else
+                v20 = 0xF800;
+            int v12 = ((ushort)blendTablePtr[(colour & 0x7E0) >> 6] << 6) + (*frameBufferPtr & 0x7E0);
+            if (v12 <= 0x7E0)
+                v21 = v12 | v20;
+            else
+                v21 = v20 | 0x7E0;
+            int v13 = (ushort)blendTablePtr[colour & (BLENDTABLE_XSIZE - 1)] + (*frameBufferPtr & 0x1F);
+            if (v13 <= 31)
+                finalColour = v13 | v21;
+            else
+                finalColour = v21 | 0x1F;
+            *frameBufferPtr = finalColour;
+        }
+        ++gfxData;
+        ++frameBufferPtr;
+    }
+}
+
+inline void DrawSubtractiveBlendedSpan(ushort *frameBufferPtr, const byte *gfxData, int count, const ushort *palette, int alpha)
+{
+#if RETRO_USING_SSE2 || RETRO_USING_NEON
+    while (count >= 8) {
+        ushort indices[8];
+        ushort colours[8];
+        if (GatherSpritePixels(gfxData, 1, palette, indices, colours)) {
+            PixelVector dst = LoadPixels(frameBufferPtr);
+            StorePixels(frameBufferPtr, MaskPixels(LoadPixels(indices), dst, BlendSubtractivePixels(dst, LoadPixels(colours), alpha)));
+        }
+        gfxData += 8;
+        frameBufferPtr += 8;
+        count -= 8;
+    }
+#endif
+
+    short *subBlendTable = &subtractLookupTable[BLENDTABLE_XSIZE * alpha];
+    while (count--) {
+        if (*gfxData > 0) {
+            ushort colour      = palette[*gfxData];
+            ushort finalColour = 0;
+            if ((*frameBufferPtr & 0xF800) - ((ushort)subBlendTable[(colour & 0xF800) >> 11] << 11) <= 0)
+                finalColour = 0;
+            else
+                finalColour = (ushort)(*frameBufferPtr & 0xF800) - ((ushort)subBlendTable[(colour & 0xF800) >> 11] << 11);
+            int v12 = (*frameBufferPtr & 0x7E0) - ((ushort)subBlendTable[(colour & 0x7E0) >> 6] << 6);
+            if (v12 > 0)
+                finalColour |= v12;
+            int v13 = (*frameBufferPtr & (BLENDTABLE_XSIZE - 1)) - (ushort)subBlendTable[colour & (BLENDTABLE_XSIZE - 1)];
+            if (v13 > 0)
+                finalColour |= v13;
+            *frameBufferPtr = finalColour;
+        }
+        ++gfxData;
+        ++frameBufferPtr;
+    }
+}
+
+inline void DrawTintSpan(ushort *frameBufferPtr, int count)
+{
+#if RETRO_USING_SSE2 || RETRO_USING_NEON
+    while (count >= 8) {
+        StorePixels(frameBufferPtr, TintPixels(LoadPixels(frameBufferPtr)));
+        frameBufferPtr += 8;
+        count -= 8;
+    }
+#endif
+
+    while (count--) {
+        *frameBufferPtr = tintLookupTable[*frameBufferPtr];
+        ++frameBufferPtr;
+    }
+}
+
+// Sets count pixels to colour, a vector register's worth at a time
+inline void FillSpan(ushort *frameBufferPtr, ushort colour, int count)
+{
+#if RETRO_USING_SSE2 || RETRO_USING_NEON
+    PixelVector fill = SplatPixels(colour);
+    while (count >= 8) {
+        StorePixels(frameBufferPtr, fill);
+        frameBufferPtr += 8;
+        count -= 8;
+    }
+#endif
+
+    while (count--) *frameBufferPtr++ = colour;
+}
+
+// Blends count pixels towards colour by alpha, like DrawAlphaBlendedSpan with every pixel opaque
+inline void BlendFillSpan(ushort *frameBufferPtr, ushort colour, int count, int alpha)
+{
+#if RETRO_USING_SSE2 || RETRO_USING_NEON
+    PixelVector fill = SplatPixels(colour);
+    while (count >= 8) {
+        StorePixels(frameBufferPtr, BlendAlphaPixels(LoadPixels(frameBufferPtr), fill, alpha));
+        frameBufferPtr += 8;
+        count -= 8;
+    }
+#endif
+
+    short *blendTablePtrA = &blendLookupTable[BLENDTABLE_XSIZE * ((BLENDTABLE_YSIZE - 1) - alpha)];
+    short *blendTablePtrB = &blendLookupTable[BLENDTABLE_XSIZE * alpha];
+    // colour's side of the blend is the same for every pixel
+    int fillB = blendTablePtrB[colour & (BLENDTABLE_XSIZE - 1)];
+    int fillG = blendTablePtrB[(colour & 0x7E0) >> 6];
+    int fillR = blendTablePtrB[(colour & 0xF800) >> 11];
+    while (count--) {
+        *frameBufferPtr = (blendTablePtrA[*frameBufferPtr & (BLENDTABLE_XSIZE - 1)] + fillB) | ((blendTablePtrA[(*frameBufferPtr & 0x7E0) >> 6] + fillG) << 6)
+                          | ((blendTablePtrA[(*frameBufferPtr & 0xF800) >> 11] + fillR) << 11);
+        ++frameBufferPtr;
+    }
+}
+#endif
+
+void DrawRectangle(int XPos, int YPos, int width, int height, int R, int G, int B, int A)
+{
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_RECTANGLE, XPos, YPos, width, height, R, G, B, A);
+        return;
+    }
+#endif
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+    if (width + XPos > SCREEN_XSIZE)
+        width = SCREEN_XSIZE - XPos;
+    if (XPos < 0) {
+        width += XPos;
+        XPos = 0;
+    }
+
+    if (height + YPos > drawClipBottom)
+        height = drawClipBottom - YPos;
+    if (YPos < drawClipTop) {
+        height -= drawClipTop - YPos;
+        YPos = drawClipTop;
+    }
+    if (width <= 0 || height <= 0 || A <= 0)
+        return;
+    if (A > 0xFF)
+        A = 0xFF;
+    ushort *frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
+    ushort clr             = RGB888_TO_RGB565(R, G, B);
+#if RETRO_USE_PALETTE_FADE
+    if (paletteFadeApplied)
+        clr = FadePaletteColour(clr); // it's drawn over pixels that are already faded
+#endif
+    // full width rects (fades, backgrounds) are one run of pixels
+    int count = width == SCREEN_XSIZE ? width * height : width;
+    int rows  = width == SCREEN_XSIZE ? 1 : height;
+    while (rows--) {
+        if (A == 0xFF)
+            FillSpan(frameBufferPtr, clr, count);
+        else
+            BlendFillSpan(frameBufferPtr, clr, count, A);
+        frameBufferPtr += SCREEN_XSIZE;
     }
 #endif
 
@@ -2161,38 +3056,17 @@ void DrawRectangle(int XPos, int YPos, int width, int height, int R, int G, int
 
 void SetFadeHQ(int R, int G, int B, int A)
 {
+    FlushDrawCommands();
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     if (A <= 0)
         return;
     if (A > 0xFF)
         A = 0xFF;
-    int pitch              = SCREEN_XSIZE * 2;
-    ushort *frameBufferPtr = Engine.frameBuffer2x;
-    ushort clr             = RGB888_TO_RGB565(R, G, B);
-    if (A == 0xFF) {
-        int h = SCREEN_YSIZE;
-        while (h--) {
-            int w = pitch;
-            while (w--) {
-                *frameBufferPtr = clr;
-                ++frameBufferPtr;
-            }
-        }
-    }
-    else {
-        int h = SCREEN_YSIZE;
-        while (h--) {
-            int w = pitch;
-            while (w--) {
-                short *blendPtrB = &blendLookupTable[BLENDTABLE_XSIZE * (0xFF - A)];
-                short *blendPtrA = &blendLookupTable[BLENDTABLE_XSIZE * A];
-                *frameBufferPtr  = (blendPtrB[*frameBufferPtr & (BLENDTABLE_XSIZE - 1)] + blendPtrA[((byte)(B >> 3) | (byte)(32 * (G >> 2))) & 0x1F])
-                                  | ((blendPtrB[(*frameBufferPtr & 0x7E0) >> 6] + blendPtrA[(clr & 0x7E0) >> 6]) << 6)
-                                  | ((blendPtrB[(*frameBufferPtr & 0xF800) >> 11] + blendPtrA[(clr & 0xF800) >> 11]) << 11);
-                ++frameBufferPtr;
-            }
-        }
-    }
+    ushort clr = RGB888_TO_RGB565(R, G, B);
+    if (A == 0xFF)
+        FillSpan(Engine.frameBuffer2x, clr, SCREEN_XSIZE * 2 * SCREEN_YSIZE);
+    else
+        BlendFillSpan(Engine.frameBuffer2x, clr, SCREEN_XSIZE * 2 * SCREEN_YSIZE, A);
 #endif
 
 #if RETRO_USING_C2D
@@ -2205,6 +3079,12 @@ void SetFadeHQ(int R, int G, int B, int A)
 
 void DrawTintRectangle(int XPos, int YPos, int width, int height)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_TINTRECTANGLE, XPos, YPos, width, height);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     if (width + XPos > SCREEN_XSIZE)
         width = SCREEN_XSIZE - XPos;
@@ -2221,16 +3101,18 @@ void DrawTintRectangle(int XPos, int YPos, int width, int height)
     }
     if (width <= 0 || height <= 0)
         return;
-    int yOffset = SCREEN_XSIZE - width;
-    for (ushort *frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];; frameBufferPtr += yOffset) {
-        height--;
-        if (!height)
-            break;
-        int w = width;
-        while (w--) {
-            *frameBufferPtr = tintLookupTable[*frameBufferPtr];
-            ++frameBufferPtr;
-        }
+    --height; // the bottom row has never been tinted
+
+    if (height + YPos > drawClipBottom)
+        height = drawClipBottom - YPos;
+    if (YPos < drawClipTop) {
+        height -= drawClipTop - YPos;
+        YPos = drawClipTop;
+    }
+    ushort *frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
+    while (height-- > 0) {
+        DrawTintSpan(frameBufferPtr, width);
+        frameBufferPtr += SCREEN_XSIZE;
     }
 #endif
 
@@ -2243,6 +3125,12 @@ void DrawTintRectangle(int XPos, int YPos, int width, int height)
 void DrawScaledTintMask(int direction, int XPos, int YPos, int pivotX, int pivotY, int scaleX, int scaleY, int width, int height, int sprX,
                                  int sprY, int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_SCALEDTINTMASK, direction, XPos, YPos, pivotX, pivotY, scaleX, scaleY, width, height, sprX, sprY, sheetID);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     int roundedYPos = 0;
     int roundedXPos = 0;
@@ -2274,8 +3162,8 @@ void DrawScaledTintMask(int direction, int XPos, int YPos, int pivotX, int pivot
         trueXPos = 0;
     }
 
-    if (height + trueYPos > SCREEN_YSIZE) {
-        height = SCREEN_YSIZE - trueYPos;
+    if (height + trueYPos > drawClipBottom) {
+        height = drawClipBottom - trueYPos;
     }
     if (trueYPos < 0) {
         sprY += trueYPos * -finalscaleY >> 11;
@@ -2283,6 +3171,12 @@ void DrawScaledTintMask(int direction, int XPos, int YPos, int pivotX, int pivot
         height += trueYPos;
         trueYPos = 0;
     }
+    // step through the rows above this band the same way the draw loop does
+    for (; trueYPos < drawClipTop && height > 0; ++trueYPos, --height) {
+        int offsetY = finalscaleY + roundedYPos;
+        sprY += offsetY >> 11;
+        roundedYPos = offsetY & 0x7FF;
+    }
 
     if (width <= 0 || height <= 0)
         return;
@@ -2346,8 +3240,78 @@ void DrawScaledTintMask(int direction, int XPos, int YPos, int pivotX, int pivot
 #endif
 }
 
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+// Draws count pixels of a sprite row through palette, skipping index 0. step is 1, or -1 to read the row backwards (FLIP_X)
+// The vector paths look up 8 colours at a time and blend them in with the transparency mask instead of branching per pixel
+inline void DrawSpriteSpan(ushort *frameBufferPtr, const byte *gfxData, int step, int count, const ushort *palette)
+{
+#if RETRO_USING_SSE2 || RETRO_USING_NEON
+    while (count >= 8) {
+        ushort indices[8];
+        ushort colours[8];
+        if (GatherSpritePixels(gfxData, step, palette, indices, colours))
+            StorePixels(frameBufferPtr, MaskPixels(LoadPixels(indices), LoadPixels(frameBufferPtr), LoadPixels(colours)));
+        gfxData += 8 * step;
+        frameBufferPtr += 8;
+        count -= 8;
+    }
+#endif
+
+    while (count--) {
+        if (*gfxData > 0)
+            *frameBufferPtr = palette[*gfxData];
+        gfxData += step;
+        ++frameBufferPtr;
+    }
+}
+
+// Draws count pixels of sheet row from column, walking step (1 or -1) across the sheet like DrawSpriteSpan
+// Sheets with a span table skip their transparent runs outright and copy opaque runs without testing each pixel
+inline void DrawSpriteRow(ushort *frameBufferPtr, const GFXSurface *surface, int row, int column, int step, int count, const ushort *palette)
+{
+    int first = step > 0 ? column : column - count + 1;
+    int last  = first + count;
+    // frames that poke outside their sheet read whatever is next to it in graphicData, same as always
+    if (surface->spanRowPosition < 0 || row < 0 || row >= surface->height || first < 0 || last > surface->width) {
+        DrawSpriteSpan(frameBufferPtr, &graphicData[surface->dataPosition + surface->width * row + column], step, count, palette);
+        return;
+    }
+
+    const GFXSpan *span   = &gfxSpanList[gfxSpanRows[surface->spanRowPosition + row]];
+    const GFXSpan *endPtr = &gfxSpanList[gfxSpanRows[surface->spanRowPosition + row + 1]];
+
+    // find the first span that reaches past the left edge
+    const GFXSpan *searchEnd = endPtr;
+    while (span < searchEnd) {
+        const GFXSpan *mid = span + (searchEnd - span) / 2;
+        if (mid->start + mid->length <= first)
+            span = mid + 1;
+        else
+            searchEnd = mid;
+    }
+
+    const byte *rowData = &graphicData[surface->dataPosition + surface->width * row];
+    for (; span < endPtr && span->start < last; ++span) {
+        int start           = span->start > first ? span->start : first;
+        int end             = span->start + span->length < last ? span->start + span->length : last;
+        const byte *gfxData = &rowData[start];
+        ushort *pixel       = &frameBufferPtr[step > 0 ? start - first : (last - 1) - start];
+        for (int x = start; x < end; ++x) {
+            *pixel = palette[*gfxData++];
+            pixel += step;
+        }
+    }
+}
+#endif
+
 void DrawSprite(int XPos, int YPos, int width, int height, int sprX, int sprY, int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_SPRITE, XPos, YPos, width, height, sprX, sprY, sheetID);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     if (width + XPos > SCREEN_XSIZE)
         width = SCREEN_XSIZE - XPos;
@@ -2356,35 +3320,25 @@ void DrawSprite(int XPos, int YPos, int width, int height, int sprX, int sprY, i
         width += XPos;
         XPos = 0;
     }
-    if (height + YPos > SCREEN_YSIZE)
-        height = SCREEN_YSIZE - YPos;
-    if (YPos < 0) {
-        sprY -= YPos;
-        height += YPos;
-        YPos = 0;
+    if (height + YPos > drawClipBottom)
+        height = drawClipBottom - YPos;
+    if (YPos < drawClipTop) {
+        sprY += drawClipTop - YPos;
+        height -= drawClipTop - YPos;
+        YPos = drawClipTop;
     }
     if (width <= 0 || height <= 0)
         return;
 
     GFXSurface *surface    = &gfxSurface[sheetID];
-    int pitch              = SCREEN_XSIZE - width;
-    int gfxPitch           = surface->width - width;
     byte *lineBuffer       = &gfxLineBuffer[YPos];
-    byte *gfxDataPtr       = &graphicData[sprX + surface->width * sprY + surface->dataPosition];
     ushort *frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
     while (height--) {
         activePalette   = fullPalette[*lineBuffer];
         activePalette32 = fullPalette32[*lineBuffer];
         lineBuffer++;
-        int w                    = width;
-        while (w--) {
-            if (*gfxDataPtr > 0)
-                *frameBufferPtr = activePalette[*gfxDataPtr];
-            ++gfxDataPtr;
-            ++frameBufferPtr;
-        }
-        frameBufferPtr += pitch;
-        gfxDataPtr += gfxPitch;
+        DrawSpriteRow(frameBufferPtr, surface, sprY++, sprX, 1, width, activePalette);
+        frameBufferPtr += SCREEN_XSIZE;
     }
 #endif
 
@@ -2397,6 +3351,12 @@ void DrawSprite(int XPos, int YPos, int width, int height, int sprX, int sprY, i
 
 void DrawSpriteFlipped(int XPos, int YPos, int width, int height, int sprX, int sprY, int direction, int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_SPRITEFLIPPED, XPos, YPos, width, height, sprX, sprY, direction, sheetID);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     int widthFlip = width;
     int heightFlip = height;
@@ -2410,112 +3370,54 @@ void DrawSpriteFlipped(int XPos, int YPos, int width, int height, int sprX, int
         widthFlip += XPos + XPos;
         XPos = 0;
     }
-    if (height + YPos > SCREEN_YSIZE) {
-        height = SCREEN_YSIZE - YPos;
+    if (height + YPos > drawClipBottom) {
+        height = drawClipBottom - YPos;
     }
-    if (YPos < 0) {
-        sprY -= YPos;
-        height += YPos;
-        heightFlip += YPos + YPos;
-        YPos = 0;
+    if (YPos < drawClipTop) {
+        sprY += drawClipTop - YPos;
+        height -= drawClipTop - YPos;
+        heightFlip -= 2 * (drawClipTop - YPos);
+        YPos = drawClipTop;
     }
     if (width <= 0 || height <= 0)
         return;
 
-    GFXSurface *surface = &gfxSurface[sheetID];
-    int pitch;
-    int gfxPitch;
-    byte *lineBuffer;
-    byte *gfxData;
-    ushort *frameBufferPtr;
+    if (direction < FLIP_NO || direction > FLIP_XY)
+        return;
+
+    // every direction is the same row copy, only the starting row/column & walking direction change
+    GFXSurface *surface    = &gfxSurface[sheetID];
+    byte *lineBuffer       = &gfxLineBuffer[YPos];
+    ushort *frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
+    int row                = sprY;
+    int column             = sprX;
+    int step               = 1;
+    int rowStep            = 1;
     switch (direction) {
-        case FLIP_NO:
-            pitch          = SCREEN_XSIZE - width;
-            gfxPitch       = surface->width - width;
-            lineBuffer     = &gfxLineBuffer[YPos];
-            gfxData        = &graphicData[sprX + surface->width * sprY + surface->dataPosition];
-            frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
-
-            while (height--) {
-                activePalette   = fullPalette[*lineBuffer];
-                activePalette32 = fullPalette32[*lineBuffer];
-                lineBuffer++;
-                int w                  = width;
-                while (w--) {
-                    if (*gfxData > 0)
-                        *frameBufferPtr = activePalette[*gfxData];
-                    ++gfxData;
-                    ++frameBufferPtr;
-                }
-                frameBufferPtr += pitch;
-                gfxData += gfxPitch;
-            }
-            break;
+        case FLIP_NO: break;
         case FLIP_X:
-            pitch          = SCREEN_XSIZE - width;
-            gfxPitch       = width + surface->width;
-            lineBuffer     = &gfxLineBuffer[YPos];
-            gfxData        = &graphicData[widthFlip - 1 + sprX + surface->width * sprY + surface->dataPosition];
-            frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
-            while (height--) {
-                activePalette   = fullPalette[*lineBuffer];
-                activePalette32 = fullPalette32[*lineBuffer];
-                lineBuffer++;
-                int w                  = width;
-                while (w--) {
-                    if (*gfxData > 0)
-                        *frameBufferPtr = activePalette[*gfxData];
-                    --gfxData;
-                    ++frameBufferPtr;
-                }
-                frameBufferPtr += pitch;
-                gfxData += gfxPitch;
-            }
+            column = widthFlip - 1 + sprX;
+            step   = -1;
             break;
         case FLIP_Y:
-            pitch          = SCREEN_XSIZE - width;
-            gfxPitch       = width + surface->width;
-            lineBuffer     = &gfxLineBuffer[YPos];
-            gfxData        = &gfxLineBuffer[YPos];
-            gfxData        = &graphicData[sprX + surface->width * (sprY + heightFlip - 1) + surface->dataPosition];
-            frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
-            while (height--) {
-                activePalette   = fullPalette[*lineBuffer];
-                activePalette32 = fullPalette32[*lineBuffer];
-                lineBuffer++;
-                int w                  = width;
-                while (w--) {
-                    if (*gfxData > 0)
-                        *frameBufferPtr = activePalette[*gfxData];
-                    ++gfxData;
-                    ++frameBufferPtr;
-                }
-                frameBufferPtr += pitch;
-                gfxData -= gfxPitch;
-            }
+            row     = sprY + heightFlip - 1;
+            rowStep = -1;
             break;
         case FLIP_XY:
-            pitch          = SCREEN_XSIZE - width;
-            gfxPitch       = surface->width - width;
-            lineBuffer     = &gfxLineBuffer[YPos];
-            gfxData        = &graphicData[widthFlip - 1 + sprX + surface->width * (sprY + heightFlip - 1) + surface->dataPosition];
-            frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
-            while (height--) {
-                activePalette   = fullPalette[*lineBuffer];
-                activePalette32 = fullPalette32[*lineBuffer];
-                lineBuffer++;
-                int w                  = width;
-                while (w--) {
-                    if (*gfxData > 0)
-                        *frameBufferPtr = activePalette[*gfxData];
-                    --gfxData;
-                    ++frameBufferPtr;
-                }
-                frameBufferPtr += pitch;
-                gfxData -= gfxPitch;
-            }
+            column  = widthFlip - 1 + sprX;
+            row     = sprY + heightFlip - 1;
+            step    = -1;
+            rowStep = -1;
             break;
-        default: break;
+    }
+
+    while (height--) {
+        activePalette   = fullPalette[*lineBuffer];
+        activePalette32 = fullPalette32[*lineBuffer];
+        lineBuffer++;
+        DrawSpriteRow(frameBufferPtr, surface, row, column, step, width, activePalette);
+        frameBufferPtr += SCREEN_XSIZE;
+        row += rowStep;
     }
 #endif
 
@@ -2528,6 +3430,12 @@ void DrawSpriteFlipped(int XPos, int YPos, int width, int height, int sprX, int
 void DrawSpriteScaled(int direction, int XPos, int YPos, int pivotX, int pivotY, int scaleX, int scaleY, int width, int height, int sprX,
                                int sprY, int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_SPRITESCALED, direction, XPos, YPos, pivotX, pivotY, scaleX, scaleY, width, height, sprX, sprY, sheetID);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     int roundedYPos = 0;
     int roundedXPos = 0;
@@ -2559,8 +3467,8 @@ void DrawSpriteScaled(int direction, int XPos, int YPos, int pivotX, int pivotY,
         trueXPos = 0;
     }
 
-    if (height + trueYPos > SCREEN_YSIZE) {
-        height = SCREEN_YSIZE - trueYPos;
+    if (height + trueYPos > drawClipBottom) {
+        height = drawClipBottom - trueYPos;
     }
     if (trueYPos < 0) {
         sprY += trueYPos * -finalscaleY >> 11;
@@ -2568,6 +3476,12 @@ void DrawSpriteScaled(int direction, int XPos, int YPos, int pivotX, int pivotY,
         height += trueYPos;
         trueYPos = 0;
     }
+    // step through the rows above this band the same way the draw loop does
+    for (; trueYPos < drawClipTop && height > 0; ++trueYPos, --height) {
+        int offsetY = finalscaleY + roundedYPos;
+        sprY += offsetY >> 11;
+        roundedYPos = offsetY & 0x7FF;
+    }
 
     if (width <= 0 || height <= 0)
         return;
@@ -2647,6 +3561,12 @@ void DrawSpriteScaled(int direction, int XPos, int YPos, int pivotX, int pivotY,
 void DrawSpriteRotated(int direction, int XPos, int YPos, int pivotX, int pivotY, int sprX, int sprY, int width, int height, int rotation,
                                 int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_SPRITEROTATED, direction, XPos, YPos, pivotX, pivotY, sprX, sprY, width, height, rotation, sheetID);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     int sprXPos    = (pivotX + sprX) << 9;
     int sprYPos    = (pivotY + sprY) << 9;
@@ -2709,16 +3629,16 @@ void DrawSpriteRotated(int direction, int XPos, int YPos, int pivotX, int pivotY
         if (yPositions[i] < top)
             top = yPositions[i];
     }
-    if (top < 0)
-        top = 0;
+    if (top < drawClipTop)
+        top = drawClipTop;
 
     int bottom = 0;
     for (int i = 0; i < 4; ++i) {
         if (yPositions[i] > bottom)
             bottom = yPositions[i];
     }
-    if (bottom > SCREEN_YSIZE)
-        bottom = SCREEN_YSIZE;
+    if (bottom > drawClipBottom)
+        bottom = drawClipBottom;
     int maxY = bottom - top;
 
     if (maxX <= 0 || maxY <= 0)
@@ -2837,6 +3757,12 @@ void DrawSpriteRotated(int direction, int XPos, int YPos, int pivotX, int pivotY
 void DrawSpriteRotozoom(int direction, int XPos, int YPos, int pivotX, int pivotY, int sprX, int sprY, int width, int height, int rotation,
                                  int scale, int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_SPRITEROTOZOOM, direction, XPos, YPos, pivotX, pivotY, sprX, sprY, width, height, rotation, scale, sheetID);
+        return;
+    }
+#endif
     if (scale == 0)
         return;
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
@@ -2905,16 +3831,16 @@ void DrawSpriteRotozoom(int direction, int XPos, int YPos, int pivotX, int pivot
         if (yPositions[i] < top)
             top = yPositions[i];
     }
-    if (top < 0)
-        top = 0;
+    if (top < drawClipTop)
+        top = drawClipTop;
 
     int bottom = 0;
     for (int i = 0; i < 4; ++i) {
         if (yPositions[i] > bottom)
             bottom = yPositions[i];
     }
-    if (bottom > SCREEN_YSIZE)
-        bottom = SCREEN_YSIZE;
+    if (bottom > drawClipBottom)
+        bottom = drawClipBottom;
     int maxY = bottom - top;
 
     if (maxX <= 0 || maxY <= 0)
@@ -2996,6 +3922,12 @@ void DrawSpriteRotozoom(int direction, int XPos, int YPos, int pivotX, int pivot
 
 void DrawBlendedSprite(int XPos, int YPos, int width, int height, int sprX, int sprY, int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_BLENDEDSPRITE, XPos, YPos, width, height, sprX, sprY, sheetID);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     if (width + XPos > SCREEN_XSIZE)
         width = SCREEN_XSIZE - XPos;
@@ -3004,12 +3936,12 @@ void DrawBlendedSprite(int XPos, int YPos, int width, int height, int sprX, int
         width += XPos;
         XPos = 0;
     }
-    if (height + YPos > SCREEN_YSIZE)
-        height = SCREEN_YSIZE - YPos;
-    if (YPos < 0) {
-        sprY -= YPos;
-        height += YPos;
-        YPos = 0;
+    if (height + YPos > drawClipBottom)
+        height = drawClipBottom - YPos;
+    if (YPos < drawClipTop) {
+        sprY += drawClipTop - YPos;
+        height -= drawClipTop - YPos;
+        YPos = drawClipTop;
     }
     if (width <= 0 || height <= 0)
         return;
@@ -3048,6 +3980,12 @@ void DrawBlendedSprite(int XPos, int YPos, int width, int height, int sprX, int
 
 void DrawAlphaBlendedSprite(int XPos, int YPos, int width, int height, int sprX, int sprY, int alpha, int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_ALPHABLENDEDSPRITE, XPos, YPos, width, height, sprX, sprY, alpha, sheetID);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     if (width + XPos > SCREEN_XSIZE)
         width = SCREEN_XSIZE - XPos;
@@ -3056,12 +3994,12 @@ void DrawAlphaBlendedSprite(int XPos, int YPos, int width, int height, int sprX,
         width += XPos;
         XPos = 0;
     }
-    if (height + YPos > SCREEN_YSIZE)
-        height = SCREEN_YSIZE - YPos;
-    if (YPos < 0) {
-        sprY -= YPos;
-        height += YPos;
-        YPos = 0;
+    if (height + YPos > drawClipBottom)
+        height = drawClipBottom - YPos;
+    if (YPos < drawClipTop) {
+        sprY += drawClipTop - YPos;
+        height -= drawClipTop - YPos;
+        YPos = drawClipTop;
     }
     if (width <= 0 || height <= 0 || alpha <= 0)
         return;
@@ -3069,8 +4007,6 @@ void DrawAlphaBlendedSprite(int XPos, int YPos, int width, int height, int sprX,
     if (alpha > 0xFF)
         alpha = 0xFF;
     GFXSurface *surface    = &gfxSurface[sheetID];
-    int pitch              = SCREEN_XSIZE - width;
-    int gfxPitch           = surface->width - width;
     byte *lineBuffer       = &gfxLineBuffer[YPos];
     byte *gfxData          = &graphicData[sprX + surface->width * sprY + surface->dataPosition];
     ushort *frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
@@ -3079,15 +4015,9 @@ void DrawAlphaBlendedSprite(int XPos, int YPos, int width, int height, int sprX,
             activePalette   = fullPalette[*lineBuffer];
             activePalette32 = fullPalette32[*lineBuffer];
             lineBuffer++;
-            int w                  = width;
-            while (w--) {
-                if (*gfxData > 0)
-                    *frameBufferPtr = activePalette[*gfxData];
-                ++gfxData;
-                ++frameBufferPtr;
-            }
-            frameBufferPtr += pitch;
-            gfxData += gfxPitch;
+            DrawSpriteSpan(frameBufferPtr, gfxData, 1, width, activePalette);
+            frameBufferPtr += SCREEN_XSIZE;
+            gfxData += surface->width;
         }
     }
     else {
@@ -3095,21 +4025,9 @@ void DrawAlphaBlendedSprite(int XPos, int YPos, int width, int height, int sprX,
             activePalette   = fullPalette[*lineBuffer];
             activePalette32 = fullPalette32[*lineBuffer];
             lineBuffer++;
-            int w                  = width;
-            while (w--) {
-                if (*gfxData > 0) {
-                    ushort colour         = activePalette[*gfxData];
-                    short *blendTablePtrA = &blendLookupTable[BLENDTABLE_XSIZE * ((BLENDTABLE_YSIZE-1) - alpha)];
-                    short *blendTablePtrB = &blendLookupTable[BLENDTABLE_XSIZE * alpha];
-                    *frameBufferPtr = (blendTablePtrA[*frameBufferPtr & (BLENDTABLE_XSIZE - 1)] + blendTablePtrB[colour & (BLENDTABLE_XSIZE - 1)])
-                                      | ((blendTablePtrA[(*frameBufferPtr & 0x7E0) >> 6] + blendTablePtrB[(colour & 0x7E0) >> 6]) << 6)
-                                      | ((blendTablePtrA[(*frameBufferPtr & 0xF800) >> 11] + blendTablePtrB[(colour & 0xF800) >> 11]) << 11);
-                }
-                ++gfxData;
-                ++frameBufferPtr;
-            }
-            frameBufferPtr += pitch;
-            gfxData += gfxPitch;
+            DrawAlphaBlendedSpan(frameBufferPtr, gfxData, width, activePalette, alpha);
+            frameBufferPtr += SCREEN_XSIZE;
+            gfxData += surface->width;
         }
     }
 #endif
@@ -3122,6 +4040,12 @@ void DrawAlphaBlendedSprite(int XPos, int YPos, int width, int height, int sprX,
 }
 void DrawAdditiveBlendedSprite(int XPos, int YPos, int width, int height, int sprX, int sprY, int alpha, int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_ADDITIVEBLENDEDSPRITE, XPos, YPos, width, height, sprX, sprY, alpha, sheetID);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     if (width + XPos > SCREEN_XSIZE)
         width = SCREEN_XSIZE - XPos;
@@ -3130,12 +4054,12 @@ void DrawAdditiveBlendedSprite(int XPos, int YPos, int width, int height, int sp
         width += XPos;
         XPos = 0;
     }
-    if (height + YPos > SCREEN_YSIZE)
-        height = SCREEN_YSIZE - YPos;
-    if (YPos < 0) {
-        sprY -= YPos;
-        height += YPos;
-        YPos = 0;
+    if (height + YPos > drawClipBottom)
+        height = drawClipBottom - YPos;
+    if (YPos < drawClipTop) {
+        sprY += drawClipTop - YPos;
+        height -= drawClipTop - YPos;
+        YPos = drawClipTop;
     }
     if (width <= 0 || height <= 0 || alpha <= 0)
         return;
@@ -3143,10 +4067,7 @@ void DrawAdditiveBlendedSprite(int XPos, int YPos, int width, int height, int sp
     if (alpha > 0xFF)
         alpha = 0xFF;
 
-    short *blendTablePtr   = &blendLookupTable[BLENDTABLE_XSIZE * alpha];
     GFXSurface *surface    = &gfxSurface[sheetID];
-    int pitch              = SCREEN_XSIZE - width;
-    int gfxPitch           = surface->width - width;
     byte *lineBuffer       = &gfxLineBuffer[YPos];
     byte *gfxData          = &graphicData[sprX + surface->width * sprY + surface->dataPosition];
     ushort *frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
@@ -3155,35 +4076,9 @@ void DrawAdditiveBlendedSprite(int XPos, int YPos, int width, int height, int sp
         activePalette   = fullPalette[*lineBuffer];
         activePalette32 = fullPalette32[*lineBuffer];
         lineBuffer++;
-        int w                  = width;
-        while (w--) {
-            if (*gfxData > 0) {
-                ushort colour   = activePalette[*gfxData];
-                int v20         = 0;
-                int v21         = 0;
-                int finalColour = 0;
-
-                if (((ushort)blendTablePtr[(colour & 0xF800) >> 11] << 11) + (*frameBufferPtr & 0xF800) <= 0xF800)
-                    v20 = ((ushort)blendTablePtr[(colour & 0xF800) >> 11] << 11) + (ushort)(*frameBufferPtr & 0xF800);
-                else
-                    v20 = 0xF800;
-                int v12 = ((ushort)blendTablePtr[(colour & 0x7E0) >> 6] << 6) + (*frameBufferPtr & 0x7E0);
-                if (v12 <= 0x7E0)
-                    v21 = v12 | v20;
-                else
-                    v21 = v20 | 0x7E0;
-                int v13 = (ushort)blendTablePtr[colour & (BLENDTABLE_XSIZE-1)] + (*frameBufferPtr & 0x1F);
-                if (v13 <= 31)
-                    finalColour = v13 | v21;
-                else
-                    finalColour = v21 | 0x1F;
-                *frameBufferPtr = finalColour;
-            }
-            ++gfxData;
-            ++frameBufferPtr;
-        }
-        frameBufferPtr += pitch;
-        gfxData += gfxPitch;
+        DrawAdditiveBlendedSpan(frameBufferPtr, gfxData, width, activePalette, alpha);
+        frameBufferPtr += SCREEN_XSIZE;
+        gfxData += surface->width;
     }
 #endif
 
@@ -3196,6 +4091,12 @@ void DrawAdditiveBlendedSprite(int XPos, int YPos, int width, int height, int sp
 }
 void DrawSubtractiveBlendedSprite(int XPos, int YPos, int width, int height, int sprX, int sprY, int alpha, int sheetID)
 {
+#if RETRO_USE_BAND_RENDERING
+    if (recordDrawCommands) {
+        AddDrawCommand(DRAWCMD_SUBTRACTIVEBLENDEDSPRITE, XPos, YPos, width, height, sprX, sprY, alpha, sheetID);
+        return;
+    }
+#endif
 #if RETRO_RENDERTYPE == RETRO_SW_RENDER
     if (width + XPos > SCREEN_XSIZE)
         width = SCREEN_XSIZE - XPos;
@@ -3204,12 +4105,12 @@ void DrawSubtractiveBlendedSprite(int XPos, int YPos, int width, int height, int
         width += XPos;
         XPos = 0;
     }
-    if (height + YPos > SCREEN_YSIZE)
-        height = SCREEN_YSIZE - YPos;
-    if (YPos < 0) {
-        sprY -= YPos;
-        height += YPos;
-        YPos = 0;
+    if (height + YPos > drawClipBottom)
+        height = drawClipBottom - YPos;
+    if (YPos < drawClipTop) {
+        sprY += drawClipTop - YPos;
+        height -= drawClipTop - YPos;
+        YPos = drawClipTop;
     }
     if (width <= 0 || height <= 0 || alpha <= 0)
         return;
@@ -3217,10 +4118,7 @@ void DrawSubtractiveBlendedSprite(int XPos, int YPos, int width, int height, int
     if (alpha > 0xFF)
         alpha = 0xFF;
 
-    short *subBlendTable   = &subtractLookupTable[BLENDTABLE_XSIZE * alpha];
     GFXSurface *surface    = &gfxSurface[sheetID];
-    int pitch              = SCREEN_XSIZE - width;
-    int gfxPitch           = surface->width - width;
     byte *lineBuffer       = &gfxLineBuffer[YPos];
     byte *gfxData          = &graphicData[sprX + surface->width * sprY + surface->dataPosition];
     ushort *frameBufferPtr = &Engine.frameBuffer[XPos + SCREEN_XSIZE * YPos];
@@ -3229,28 +4127,9 @@ void DrawSubtractiveBlendedSprite(int XPos, int YPos, int width, int height, int
         activePalette   = fullPalette[*lineBuffer];
         activePalette32 = fullPalette32[*lineBuffer];
         lineBuffer++;
-        int w                  = width;
-        while (w--) {
-            if (*gfxData > 0) {
-                ushort colour      = activePalette[*gfxData];
-                ushort finalColour = 0;
-                if ((*frameBufferPtr & 0xF800) - ((ushort)subBlendTable[(colour & 0xF800) >> 11] << 11) <= 0)
-                    finalColour = 0;
-                else
-                    finalColour = (ushort)(*frameBufferPtr & 0xF800) - ((ushort)subBlendTable[(colour & 0xF800) >> 11] << 11);
-                int v12 = (*frameBufferPtr & 0x7E0) - ((ushort)subBlendTable[(colour & 0x7E0) >> 6] << 6);
-                if (v12 > 0)
-                    finalColour |= v12;
-                int v13 = (*frameBufferPtr & (BLENDTABLE_XSIZE - 1)) - (ushort)subBlendTable[colour & (BLENDTABLE_XSIZE - 1)];
-                if (v13 > 0)
-                    finalColour |= v13;
-                *frameBufferPtr = finalColour;
-            }
-            ++gfxData;
-            ++frameBufferPtr;
-        }
-        frameBufferPtr += pitch;
-        gfxData += gfxPitch;
+        DrawSubtractiveBlendedSpan(frameBufferPtr, gfxData, width, activePalette, alpha);
+        frameBufferPtr += SCREEN_XSIZE;
+        gfxData += surface->width;
     }
 #endif
 
@@ -3365,6 +4244,7 @@ void DrawObjectAnimation(void *objScr, void *ent, int XPos, int YPos)
 
 void DrawFace(void *v, uint colour)
 {
+    FlushDrawCommands();
     Vertex *verts = (Vertex *)v;
 
     int alpha = (colour & 0x7F000000) >> 23;
@@ -3431,14 +4311,18 @@ void DrawFace(void *v, uint colour)
         faceLineEnd[i]   = -100000;
     }
 
-    processScanEdge(&verts[vertexA], &verts[vertexB]);
-    processScanEdge(&verts[vertexA], &verts[vertexC]);
-    processScanEdge(&verts[vertexA], &verts[vertexD]);
-    processScanEdge(&verts[vertexB], &verts[vertexC]);
-    processScanEdge(&verts[vertexC], &verts[vertexD]);
-    processScanEdge(&verts[vertexB], &verts[vertexD]);
+    ProcessScanEdge(&verts[vertexA], &verts[vertexB]);
+    ProcessScanEdge(&verts[vertexA], &verts[vertexC]);
+    ProcessScanEdge(&verts[vertexA], &verts[vertexD]);
+    ProcessScanEdge(&verts[vertexB], &verts[vertexC]);
+    ProcessScanEdge(&verts[vertexC], &verts[vertexD]);
+    ProcessScanEdge(&verts[vertexB], &verts[vertexD]);
 
     ushort colour16 = RGB888_TO_RGB565(((colour >> 16) & 0xFF), ((colour >> 8) & 0xFF), ((colour >> 0) & 0xFF));
+#if RETRO_USE_PALETTE_FADE
+    if (paletteFadeApplied)
+        colour16 = FadePaletteColour(colour16);
+#endif
 
     ushort *frameBufferPtr = &Engine.frameBuffer[SCREEN_XSIZE * faceTop];
     if (alpha == 255) {
@@ -3503,6 +4387,7 @@ void DrawFace(void *v, uint colour)
 }
 void DrawTexturedFace(void *v, byte sheetID)
 {
+    FlushDrawCommands();
     Vertex *verts = (Vertex *)v;
 
     if (verts[0].x < 0 && verts[1].x < 0 && verts[2].x < 0 && verts[3].x < 0)
@@ -3564,12 +4449,12 @@ void DrawTexturedFace(void *v, byte sheetID)
         faceLineEnd[i]   = -100000;
     }
 
-    processScanEdgeUV(&verts[vertexA], &verts[vertexB]);
-    processScanEdgeUV(&verts[vertexA], &verts[vertexC]);
-    processScanEdgeUV(&verts[vertexA], &verts[vertexD]);
-    processScanEdgeUV(&verts[vertexB], &verts[vertexC]);
-    processScanEdgeUV(&verts[vertexC], &verts[vertexD]);
-    processScanEdgeUV(&verts[vertexB], &verts[vertexD]);
+    ProcessScanEdgeUV(&verts[vertexA], &verts[vertexB]);
+    ProcessScanEdgeUV(&verts[vertexA], &verts[vertexC]);
+    ProcessScanEdgeUV(&verts[vertexA], &verts[vertexD]);
+    ProcessScanEdgeUV(&verts[vertexB], &verts[vertexC]);
+    ProcessScanEdgeUV(&verts[vertexC], &verts[vertexD]);
+    ProcessScanEdgeUV(&verts[vertexB], &verts[vertexD]);
 
     ushort *frameBufferPtr = &Engine.frameBuffer[SCREEN_XSIZE * faceTop];
     byte *sheetPtr         = &graphicData[gfxSurface[sheetID].dataPosition];
@@ -3830,3 +4715,252 @@ void DrawTextMenu(void *menu, int XPos, int YPos)
         default: return;
     }
 }
+
+#if !RETRO_USE_ORIGINAL_CODE && RETRO_RENDERTYPE == RETRO_SW_RENDER
+// Span self checks (see RunSelfCheck). Drawing a span one pixel at a time only ever runs the scalar tail of each span function, the
+// same code a RETRO_USE_SIMD=0 build runs for every pixel, so each case draws a random span both ways & compares the two buffers
+#define SPANCHECK_SIZE  (0x200)
+#define SPANCHECK_COUNT (0x4000)
+
+enum SpanCheckModes {
+    SPANCHECK_SPRITE,
+    SPANCHECK_SPRITEFLIPPED,
+    SPANCHECK_ALPHA,
+    SPANCHECK_ADDITIVE,
+    SPANCHECK_SUBTRACTIVE,
+    SPANCHECK_TINT,
+    SPANCHECK_FILL,
+    SPANCHECK_BLENDFILL,
+    SPANCHECK_MODECOUNT,
+};
+
+const char *spanCheckNames[SPANCHECK_MODECOUNT] = { "sprite span", "flipped sprite span", "alpha blended span", "additive blended span",
+                                                    "subtractive blended span", "tint span", "fill span", "blended fill span" };
+
+ushort spanCheckPalette[PALETTE_SIZE];
+byte spanCheckSprite[SPANCHECK_SIZE];
+ushort spanCheckPixels[2][SPANCHECK_SIZE];
+
+void DrawCheckSpan(int mode, ushort *frameBufferPtr, const byte *gfxData, int count, int alpha)
+{
+    switch (mode) {
+        case SPANCHECK_SPRITE: DrawSpriteSpan(frameBufferPtr, gfxData, 1, count, spanCheckPalette); break;
+        case SPANCHECK_SPRITEFLIPPED: DrawSpriteSpan(frameBufferPtr, gfxData, -1, count, spanCheckPalette); break;
+        case SPANCHECK_ALPHA: DrawAlphaBlendedSpan(frameBufferPtr, gfxData, count, spanCheckPalette, alpha); break;
+        case SPANCHECK_ADDITIVE: DrawAdditiveBlendedSpan(frameBufferPtr, gfxData, count, spanCheckPalette, alpha); break;
+        case SPANCHECK_SUBTRACTIVE: DrawSubtractiveBlendedSpan(frameBufferPtr, gfxData, count, spanCheckPalette, alpha); break;
+        case SPANCHECK_TINT: DrawTintSpan(frameBufferPtr, count); break;
+        case SPANCHECK_FILL: FillSpan(frameBufferPtr, spanCheckPalette[1], count); break;
+        case SPANCHECK_BLENDFILL: BlendFillSpan(frameBufferPtr, spanCheckPalette[1], count, alpha); break;
+    }
+}
+
+// a random palette & frame buffer row, and a sprite row of transparent runs and opaque runs (which can still hold the odd 0)
+void SetupSpanCheck()
+{
+    for (int i = 0; i < PALETTE_SIZE; ++i) spanCheckPalette[i] = SelfCheckRandom();
+    bool opaque = false;
+    for (int i = 0; i < SPANCHECK_SIZE; ++i) {
+        if (!(SelfCheckRandom() & 7))
+            opaque = !opaque;
+        spanCheckSprite[i]    = opaque ? SelfCheckRandom() & 0xFF : 0;
+        spanCheckPixels[0][i] = SelfCheckRandom();
+        spanCheckPixels[1][i] = spanCheckPixels[0][i];
+    }
+}
+
+// Every channel of the blends is worked out on its own, by the tables and the vector path alike. So a span of every src channel value
+// over every dst channel value, at every alpha, covers every input the blend tables have. The tint is checked on all 65536 colours
+#define BLENDCHECK_CHANNELS (0x40)
+#define BLENDCHECK_SIZE     (BLENDCHECK_CHANNELS * BLENDCHECK_CHANNELS)
+
+ushort blendCheckPixels[2][BLENDCHECK_SIZE];
+byte blendCheckSprite[BLENDCHECK_SIZE];
+
+// colours 0 to 63 hold every value of every channel: x in blue & green (all 6 bits), red counting down so a mixed up channel shows
+inline ushort GetCheckChannelColour(int x) { return ((0x1F - (x & 0x1F)) << 11) | (x << 5) | (x & 0x1F); }
+
+// Draws both blendCheckPixels rows through mode, in spans of random length so every pixel lands on each part of the vector loop &
+// the scalar tail across the runs, and returns how many pixels differ
+int DrawBlendCheck(int mode, int alpha)
+{
+    int count = 0;
+    for (int i = 0; i < BLENDCHECK_SIZE; i += count) {
+        count = SelfCheckRandom() % SPANCHECK_SIZE;
+        if (count > BLENDCHECK_SIZE - i)
+            count = BLENDCHECK_SIZE - i;
+        DrawCheckSpan(mode, &blendCheckPixels[0][i], &blendCheckSprite[i], count, alpha);
+    }
+    for (int i = 0; i < BLENDCHECK_SIZE; ++i) DrawCheckSpan(mode, &blendCheckPixels[1][i], &blendCheckSprite[i], 1, alpha);
+
+    int failures = 0;
+    for (int i = 0; i < BLENDCHECK_SIZE; ++i) {
+        if (blendCheckPixels[0][i] != blendCheckPixels[1][i])
+            ++failures;
+    }
+    return failures;
+}
+
+int CheckBlendChannels()
+{
+    for (int s = 0; s < BLENDCHECK_CHANNELS; ++s) {
+        spanCheckPalette[s + 1] = GetCheckChannelColour(s);
+        for (int d = 0; d < BLENDCHECK_CHANNELS; ++d) blendCheckSprite[s * BLENDCHECK_CHANNELS + d] = s + 1;
+    }
+
+    int failures = 0;
+    for (int mode = SPANCHECK_ALPHA; mode <= SPANCHECK_SUBTRACTIVE; ++mode) {
+        int modeFailures = 0;
+        for (int alpha = 0; alpha < BLENDTABLE_YSIZE; ++alpha) {
+            for (int i = 0; i < BLENDCHECK_SIZE; ++i) {
+                blendCheckPixels[0][i] = GetCheckChannelColour(i % BLENDCHECK_CHANNELS);
+                blendCheckPixels[1][i] = blendCheckPixels[0][i];
+            }
+            modeFailures += DrawBlendCheck(mode, alpha);
+        }
+
+        char name[0x40];
+        sprintf(name, "%s, every channel & alpha", spanCheckNames[mode]);
+        ReportSelfCheck(name, modeFailures, BLENDTABLE_YSIZE * BLENDCHECK_SIZE);
+        failures += modeFailures;
+    }
+
+    int tintFailures = 0;
+    for (int c = 0; c < TINTTABLE_SIZE; c += BLENDCHECK_SIZE) {
+        for (int i = 0; i < BLENDCHECK_SIZE; ++i) {
+            blendCheckPixels[0][i] = c + i;
+            blendCheckPixels[1][i] = c + i;
+        }
+        tintFailures += DrawBlendCheck(SPANCHECK_TINT, 0);
+    }
+    ReportSelfCheck("tint span, every colour", tintFailures, TINTTABLE_SIZE);
+    return failures + tintFailures;
+}
+
+int CheckDrawingSpans()
+{
+    int failures = 0;
+    for (int mode = 0; mode < SPANCHECK_MODECOUNT; ++mode) {
+        int modeFailures = 0;
+        for (int c = 0; c < SPANCHECK_COUNT; ++c) {
+            SetupSpanCheck();
+            // unaligned starts & every length, including the ones too short for a vector
+            int offset = SelfCheckRandom() % 0x10;
+            int count  = SelfCheckRandom() % (SPANCHECK_SIZE - 0x10);
+            int step   = mode == SPANCHECK_SPRITEFLIPPED ? -1 : 1;
+            byte *gfxData = step > 0 ? &spanCheckSprite[offset] : &spanCheckSprite[SPANCHECK_SIZE - 1 - offset];
+            int alpha     = SelfCheckRandom() & 0xFF;
+
+            DrawCheckSpan(mode, &spanCheckPixels[0][offset], gfxData, count, alpha);
+            for (int i = 0; i < count; ++i) DrawCheckSpan(mode, &spanCheckPixels[1][offset + i], gfxData + i * step, 1, alpha);
+            if (memcmp(spanCheckPixels[0], spanCheckPixels[1], sizeof(spanCheckPixels[0])))
+                ++modeFailures;
+        }
+        ReportSelfCheck(spanCheckNames[mode], modeFailures, SPANCHECK_COUNT);
+        failures += modeFailures;
+    }
+    return failures + CheckBlendChannels();
+}
+// Times the full screen fills, best of SPANBENCH_RUNS. The plain loop is ClearScreen's
+#define SPANBENCH_RUNS (0x100)
+
+enum SpanBenchModes {
+    SPANBENCH_PLAINFILL,
+    SPANBENCH_STDFILL,
+    SPANBENCH_FILLSPAN,
+    SPANBENCH_BLENDFILLSPAN,
+    SPANBENCH_MODECOUNT,
+};
+
+const char *spanBenchNames[SPANBENCH_MODECOUNT] = { "plain loop fill", "std::fill", "FillSpan", "BlendFillSpan, alpha 0x80" };
+
+void BenchmarkDrawingSpans()
+{
+    // sized at run time like ClearScreen's, a constant size lets the compiler fill it differently
+    int size                = SCREEN_XSIZE * SCREEN_YSIZE;
+    ushort *spanBenchPixels = (ushort *)malloc(size * sizeof(ushort));
+    for (int mode = 0; mode < SPANBENCH_MODECOUNT; ++mode) {
+        long long best = 0;
+        for (int r = 0; r < SPANBENCH_RUNS; ++r) {
+            ushort colour   = SelfCheckRandom();
+            long long start = GetBenchmarkTime();
+            switch (mode) {
+                case SPANBENCH_PLAINFILL: {
+                    ushort *frameBufferPtr = spanBenchPixels;
+                    int count              = size;
+                    while (count--) *frameBufferPtr++ = colour;
+                    break;
+                }
+                case SPANBENCH_STDFILL: std::fill(spanBenchPixels, spanBenchPixels + size, colour); break;
+                case SPANBENCH_FILLSPAN: FillSpan(spanBenchPixels, colour, size); break;
+                case SPANBENCH_BLENDFILLSPAN: BlendFillSpan(spanBenchPixels, colour, size, 0x80); break;
+            }
+            long long time = GetBenchmarkTime() - start;
+            if (!r || time < best)
+                best = time;
+        }
+        printf("%s, %d pixels: %.1f us\n", spanBenchNames[mode], size, best / 1000.0);
+    }
+    free(spanBenchPixels);
+}
+
+#if RETRO_USE_DIRTY_RECTS
+enum DirtyRectBenchModes {
+    DIRTYBENCH_FULLUPLOAD,
+    DIRTYBENCH_REDRAWN,
+    DIRTYBENCH_STATIC,
+    DIRTYBENCH_MODECOUNT,
+};
+
+const char *dirtyBenchNames[DIRTYBENCH_MODECOUNT] = { "full frame upload copy", "dirty rect diff & upload copy, full redraw",
+                                                      "dirty rect diff, static frame" };
+
+// Times what RenderRenderDevice does on the CPU to hand a frame to the screen texture, best of SPANBENCH_RUNS
+// A full redraw (anything that scrolls) pays for the diff on top of the upload, a static frame pays for the diff instead of it
+void BenchmarkDirtyRects()
+{
+    int size                  = SCREEN_XSIZE * SCREEN_YSIZE;
+    ushort *frameBufferStore  = Engine.frameBuffer;
+    ushort *presentedStore    = presentedFrameBuffer;
+    bool presentedValidStore  = presentedFrameValid;
+    ushort *dirtyBenchTexture = (ushort *)malloc(size * sizeof(ushort));
+    Engine.frameBuffer        = (ushort *)malloc(size * sizeof(ushort));
+    presentedFrameBuffer      = (ushort *)malloc(size * sizeof(ushort));
+
+    for (int mode = 0; mode < DIRTYBENCH_MODECOUNT; ++mode) {
+        long long best = 0;
+        for (int r = 0; r < SPANBENCH_RUNS; ++r) {
+            ushort colour = SelfCheckRandom();
+            for (int i = 0; i < size; ++i) {
+                Engine.frameBuffer[i]   = colour + i;
+                presentedFrameBuffer[i] = mode == DIRTYBENCH_STATIC ? colour + i : ~(colour + i);
+            }
+            presentedFrameValid = true;
+
+            SDL_Rect dirtyRect;
+            long long start = GetBenchmarkTime();
+            if (mode == DIRTYBENCH_FULLUPLOAD) {
+                memcpy(dirtyBenchTexture, Engine.frameBuffer, size * sizeof(ushort));
+            }
+            else if (GetDirtyRect(&dirtyRect)) {
+                for (int y = dirtyRect.y; y < dirtyRect.y + dirtyRect.h; ++y) {
+                    memcpy(&dirtyBenchTexture[y * SCREEN_XSIZE + dirtyRect.x], &Engine.frameBuffer[y * SCREEN_XSIZE + dirtyRect.x],
+                           dirtyRect.w * sizeof(ushort));
+                }
+            }
+            long long time = GetBenchmarkTime() - start;
+            if (!r || time < best)
+                best = time;
+        }
+        printf("%s, %d pixels: %.1f us\n", dirtyBenchNames[mode], size, best / 1000.0);
+    }
+
+    free(Engine.frameBuffer);
+    free(presentedFrameBuffer);
+    free(dirtyBenchTexture);
+    Engine.frameBuffer   = frameBufferStore;
+    presentedFrameBuffer = presentedStore;
+    presentedFrameValid  = presentedValidStore;
+}
+#endif
+#endif
@@ -4,17 +4,41 @@
 #define SPRITESHEETS_MAX (16)
 #define SURFACE_MAX      (24)
 #define GFXDATA_MAX      (0x400000)
+#define GFXSPAN_MAX      (0x40000)
+#define GFXSPANROW_MAX   (0x8000)
 
 #define BLENDTABLE_YSIZE (0x100)
 #define BLENDTABLE_XSIZE (0x20)
 #define BLENDTABLE_SIZE  (BLENDTABLE_XSIZE * BLENDTABLE_YSIZE)
-#define TINTTABLE_SIZE (0x1000)
+#define TINTTABLE_SIZE   (0x10000)
 
 #define DRAWLAYER_COUNT (0x7)
 
+#define DRAWCOMMAND_COUNT (0x400)
+#define DRAWBAND_MAX      (0x8)
+
+#define TILEROWCACHE_COUNT (9 * 2) // a low & high plane for each of the LAYER_COUNT layouts
+
 enum FlipFlags { FLIP_NO, FLIP_X, FLIP_Y, FLIP_XY };
 enum InkFlags { INK_NONE, INK_BLEND, INK_ALPHA, INK_ADD, INK_SUB };
 enum DrawFXFlags { FX_SCALE, FX_ROTATE, FX_ROTOZOOM, FX_INK, FX_TINT, FX_FLIP };
+enum DrawCommandTypes {
+    DRAWCMD_SPRITE,
+    DRAWCMD_SPRITEFLIPPED,
+    DRAWCMD_BLENDEDSPRITE,
+    DRAWCMD_ALPHABLENDEDSPRITE,
+    DRAWCMD_ADDITIVEBLENDEDSPRITE,
+    DRAWCMD_SUBTRACTIVEBLENDEDSPRITE,
+    DRAWCMD_RECTANGLE,
+    DRAWCMD_TINTRECTANGLE,
+    DRAWCMD_SPRITESCALED,
+    DRAWCMD_SPRITEROTATED,
+    DRAWCMD_SPRITEROTOZOOM,
+    DRAWCMD_SCALEDTINTMASK,
+    DRAWCMD_HLINESCROLLLAYER,
+    DRAWCMD_3DFLOORLAYER,
+    DRAWCMD_3DSKYLAYER,
+};
 
 struct DrawListEntry
 {
@@ -22,6 +46,48 @@ struct DrawListEntry
     int listSize;
 };
 
+// A run of opaque (non-zero) pixels in one row of a sprite sheet
+struct GFXSpan
+{
+    ushort start;
+    ushort length;
+};
+
+// A recorded draw call, params are the arguments of the function type maps to
+struct DrawCommand
+{
+    byte type;
+    int params[12];
+};
+
+// The part of a layer an H-scroll line was last built from, the row itself lives in tileRowCacheData
+struct TileRowCacheLine
+{
+    int cacheID;
+    int chunkX;
+    int tileYPos;
+    int layerWidth;
+    bool blank; // nothing on the line is on this plane
+};
+
+// Where a 3D floor/sky line starts, relative to the layer's X & Z, and how far it moves per pixel
+struct Layer3DLine
+{
+    int XBuffer;
+    int YBuffer;
+    int XPos;
+    int YPos;
+};
+
+// The lines of a 3D layer, kept until the layer's height or angle changes
+struct Layer3DLineTable
+{
+    int YPos;
+    int angle;
+    int screenWidth; // -1 until the table's first built
+    Layer3DLine lines[SCREEN_YSIZE];
+};
+
 struct GFXSurface
 {
     char fileName[0x40];
@@ -30,6 +96,7 @@ struct GFXSurface
     int widthShift;
     int depth;
     int dataPosition;
+    int spanRowPosition; // first entry in gfxSpanRows, -1 if the sheet has no span table
 };
 
 extern short blendLookupTable[BLENDTABLE_SIZE];
@@ -47,6 +114,41 @@ extern DrawListEntry drawListEntries[DRAWLAYER_COUNT];
 extern int gfxDataPosition;
 extern GFXSurface gfxSurface[SURFACE_MAX];
 extern byte graphicData[GFXDATA_MAX];
+extern int gfxSpanPosition;
+extern int gfxSpanRowPosition;
+// span tables are only built for the software renderer, so these grow (up to GFXSPAN_MAX & GFXSPANROW_MAX) as sheets need them
+extern GFXSpan *gfxSpanList;
+extern int gfxSpanListSize;
+extern int *gfxSpanRows;
+extern int gfxSpanRowsSize;
+
+// rows [drawClipTop, drawClipBottom) of the screen the current thread may draw to
+extern RETRO_BAND_LOCAL int drawClipTop;
+extern RETRO_BAND_LOCAL int drawClipBottom;
+
+#if RETRO_USE_BAND_RENDERING
+extern RETRO_BAND_LOCAL bool recordDrawCommands;
+extern int drawBandCount;
+extern DrawCommand drawCommands[2][DRAWCOMMAND_COUNT];
+extern int drawCommandList;
+extern int drawCommandCount;
+#endif
+
+#if RETRO_RENDERTYPE == RETRO_SW_RENDER
+extern Layer3DLineTable floor3DLineTable;
+extern Layer3DLineTable sky3DLineTable;
+#endif
+
+#if RETRO_USE_DIRTY_RECTS
+extern ushort *presentedFrameBuffer;
+extern bool presentedFrameValid;
+#endif
+
+#if RETRO_USE_TILEROW_CACHE
+extern TileRowCacheLine tileRowCache[TILEROWCACHE_COUNT][SCREEN_YSIZE];
+extern byte *tileRowCacheData;
+extern int tileRowCacheID;
+#endif
 
 int InitRenderDevice();
 void RenderRenderDevice();
@@ -54,10 +156,49 @@ void ReleaseRenderDevice();
 
 void GenerateBlendLookupTable();
 
+// Band Rendering
+void FlushDrawCommands();
+#if RETRO_USE_BAND_RENDERING
+void SubmitDrawCommands();
+void WaitForDrawBands();
+void ReleaseDrawBands();
+
+inline void AddDrawCommand(byte type, int p0 = 0, int p1 = 0, int p2 = 0, int p3 = 0, int p4 = 0, int p5 = 0, int p6 = 0, int p7 = 0, int p8 = 0,
+                           int p9 = 0, int p10 = 0, int p11 = 0)
+{
+    if (drawCommandCount == DRAWCOMMAND_COUNT)
+        SubmitDrawCommands();
+    DrawCommand *command = &drawCommands[drawCommandList][drawCommandCount++];
+    command->type        = type;
+    command->params[0]   = p0;
+    command->params[1]   = p1;
+    command->params[2]   = p2;
+    command->params[3]   = p3;
+    command->params[4]   = p4;
+    command->params[5]   = p5;
+    command->params[6]   = p6;
+    command->params[7]   = p7;
+    command->params[8]   = p8;
+    command->params[9]   = p9;
+    command->params[10]  = p10;
+    command->params[11]  = p11;
+}
+#endif
+
+// Call after changing a layout, the chunks or the tileset so H-scroll lines stop reusing what they drew before
+inline void InvalidateTileRowCache()
+{
+#if RETRO_USE_TILEROW_CACHE
+    ++tileRowCacheID;
+#endif
+}
+
 inline void ClearGraphicsData()
 {
     for (int i = 0; i < SURFACE_MAX; ++i) StrCopy(gfxSurface[i].fileName, "");
-    gfxDataPosition = 0;
+    gfxDataPosition    = 0;
+    gfxSpanPosition    = 0;
+    gfxSpanRowPosition = 0;
 }
 void ClearScreen(byte index);
 
@@ -70,9 +211,12 @@ void DrawStageGFX();
 
 // TileLayer Drawing
 void DrawHLineScrollLayer(int layerID);
+void DrawHLineScrollLines(int layoutID, int yscrollOffset, int deformationOffset, int deformationOffsetW, bool aboveMidPoint);
 void DrawVLineScrollLayer(int layerID);
 void Draw3DFloorLayer(int layerID);
+void Draw3DFloorLines(int layoutID, int layerXPos, int ZBuffer);
 void Draw3DSkyLayer(int layerID);
+void Draw3DSkyLines(int layoutID, int layerXPos, int layerZPos, bool hq);
 
 // Shape Drawing
 void DrawRectangle(int XPos, int YPos, int width, int height, int R, int G, int B, int A);
@@ -113,4 +257,12 @@ void DrawStageTextEntry(void *menu, int rowID, int XPos, int YPos, int textHighl
 void DrawBlendedTextMenuEntry(void *menu, int rowID, int XPos, int YPos, int textHighlight);
 void DrawBitmapText(void *menu, int XPos, int YPos, int scale, int spacing, int rowStart, int rowCount);
 
+#if !RETRO_USE_ORIGINAL_CODE && RETRO_RENDERTYPE == RETRO_SW_RENDER
+int CheckDrawingSpans();
+void BenchmarkDrawingSpans();
+#if RETRO_USE_DIRTY_RECTS
+void BenchmarkDirtyRects();
+#endif
+#endif
+
 #endif // !DRAWING_H
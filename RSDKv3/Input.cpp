@@ -1,4 +1,5 @@
 #include "RetroEngine.hpp"
+#include <time.h>
 
 InputData keyPress = InputData();
 InputData keyDown  = InputData();
@@ -14,6 +15,104 @@ int touches = 0;
 InputButton inputDevice[INPUT_MAX];
 int inputType = 0;
 
+#if !RETRO_USE_ORIGINAL_CODE
+// Replay files are a "RPL" signature + the rand() seed, then the press & hold masks of every inputDevice entry for each ProcessInput call
+byte inputReplayMode          = INPUTREPLAY_NONE;
+int inputReplayFrame          = 0;
+FileIO *inputReplayFile       = nullptr;
+const char replaySignature[4] = { 'R', 'P', 'L', 0 };
+
+bool StartInputRecording(const char *filePath)
+{
+    StopInputReplay();
+    inputReplayFile = fOpen(filePath, "wb");
+    if (!inputReplayFile) {
+        PrintLog("ERROR: Couldn't open file '%s' for writing!", filePath);
+        return false;
+    }
+
+    uint seed = (uint)time(NULL);
+    srand(seed);
+    byte seedBytes[4] = { (byte)seed, (byte)(seed >> 8), (byte)(seed >> 16), (byte)(seed >> 24) };
+    fWrite(replaySignature, 1, 4, inputReplayFile);
+    fWrite(seedBytes, 1, 4, inputReplayFile);
+
+    inputReplayMode  = INPUTREPLAY_RECORD;
+    inputReplayFrame = 0;
+    PrintLog("Recording input to '%s'", filePath);
+    return true;
+}
+
+bool StartInputReplay(const char *filePath)
+{
+    StopInputReplay();
+    inputReplayFile = fOpen(filePath, "rb");
+    if (!inputReplayFile) {
+        PrintLog("ERROR: Couldn't open replay '%s'!", filePath);
+        return false;
+    }
+
+    char signature[4];
+    byte seedBytes[4];
+    if (fRead(signature, 1, 4, inputReplayFile) != 4 || memcmp(signature, replaySignature, 4) || fRead(seedBytes, 1, 4, inputReplayFile) != 4) {
+        PrintLog("ERROR: '%s' isn't a valid replay file!", filePath);
+        fClose(inputReplayFile);
+        inputReplayFile = nullptr;
+        return false;
+    }
+    // rand() drives FUNC_RAND, so it has to start from the same seed the recording did
+    srand(seedBytes[0] | (seedBytes[1] << 8) | (seedBytes[2] << 16) | (seedBytes[3] << 24));
+
+    inputReplayMode  = INPUTREPLAY_PLAYBACK;
+    inputReplayFrame = 0;
+    PrintLog("Playing back input from '%s'", filePath);
+    return true;
+}
+
+void StopInputReplay()
+{
+    if (inputReplayFile)
+        fClose(inputReplayFile);
+    inputReplayFile = nullptr;
+    inputReplayMode = INPUTREPLAY_NONE;
+}
+
+void WriteReplayInput()
+{
+    ushort press = 0, hold = 0;
+    for (int i = 0; i < INPUT_MAX; ++i) {
+        press |= inputDevice[i].press << i;
+        hold |= inputDevice[i].hold << i;
+    }
+    byte frame[4] = { (byte)press, (byte)(press >> 8), (byte)hold, (byte)(hold >> 8) };
+    fWrite(frame, 1, 4, inputReplayFile);
+    ++inputReplayFrame;
+}
+
+void ReadReplayInput()
+{
+    byte frame[4];
+    if (inputReplayMode != INPUTREPLAY_PLAYBACK || fRead(frame, 1, 4, inputReplayFile) != 4) {
+        if (inputReplayMode == INPUTREPLAY_PLAYBACK) {
+            PrintLog("Replay finished after %d frames", inputReplayFrame);
+            fClose(inputReplayFile);
+            inputReplayFile = nullptr;
+            inputReplayMode = INPUTREPLAY_FINISHED;
+        }
+        for (int i = 0; i < INPUT_MAX; ++i) inputDevice[i].setReleased();
+        return;
+    }
+
+    ushort press = frame[0] | (frame[1] << 8);
+    ushort hold  = frame[2] | (frame[3] << 8);
+    for (int i = 0; i < INPUT_MAX; ++i) {
+        inputDevice[i].press = (press >> i) & 1;
+        inputDevice[i].hold  = (hold >> i) & 1;
+    }
+    ++inputReplayFrame;
+}
+#endif
+
 int LSTICK_DEADZONE   = 20000;
 int RSTICK_DEADZONE   = 20000;
 int LTRIGGER_DEADZONE = 20000;
@@ -80,6 +179,14 @@ bool getControllerButton(byte buttonID)
 
 void ProcessInput()
 {
+#if !RETRO_USE_ORIGINAL_CODE
+    // replays (and headless runs, which have no input devices) never touch the real inputs
+    if (inputReplayMode == INPUTREPLAY_PLAYBACK || inputReplayMode == INPUTREPLAY_FINISHED || RETRO_USE_HEADLESS) {
+        ReadReplayInput();
+        return;
+    }
+#endif
+
 #if RETRO_USING_SDL2
     int length           = 0;
     const byte *keyState = SDL_GetKeyboardState(&length);
@@ -241,6 +348,11 @@ void ProcessInput()
         inputDevice[INPUT_ANY].setReleased();
     }
 #endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+    if (inputReplayMode == INPUTREPLAY_RECORD)
+        WriteReplayInput();
+#endif
 }
 
 void CheckKeyPress(InputData *input, byte flags)
@@ -114,8 +114,26 @@ extern byte keyState[SDLK_LAST];
 extern SDL_Joystick *controller;
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+enum InputReplayModes {
+    INPUTREPLAY_NONE,
+    INPUTREPLAY_RECORD,
+    INPUTREPLAY_PLAYBACK,
+    INPUTREPLAY_FINISHED,
+};
+
+extern byte inputReplayMode;
+extern int inputReplayFrame;
+#endif
+
 void ProcessInput();
 
+#if !RETRO_USE_ORIGINAL_CODE
+bool StartInputRecording(const char *filePath);
+bool StartInputReplay(const char *filePath);
+void StopInputReplay();
+#endif
+
 void CheckKeyPress(InputData *input, byte Flags);
 void CheckKeyDown(InputData *input, byte Flags);
 
@@ -3,6 +3,17 @@
 int objectLoop    = 0;
 int curObjectType = 0;
 Entity objectEntityList[ENTITY_COUNT];
+uint entitySlotList[ENTITYSLOT_COUNT];
+uint pausedSlotList[ENTITYSLOT_COUNT];
+
+// the slots in each drawListEntries list, which holds them in slot order while drawListsKept is set
+uint drawListSlots[DRAWLAYER_COUNT][ENTITYSLOT_COUNT];
+// the slots added to each list by the objects processed so far this frame
+uint frameDrawListSlots[DRAWLAYER_COUNT][ENTITYSLOT_COUNT];
+bool drawListsKept      = false;
+bool buildingDrawLists  = false;
+bool appendingDrawLists = false;
+bool drawListsEdited    = false;
 
 char typeNames[OBJECT_COUNT][0x40];
 
@@ -24,6 +35,129 @@ void SetObjectTypeName(const char *objectName, int objectID)
     printLog("Set Object (%d) name to: %s", objectID, objectName);
 }
 
+void RefreshEntitySlots()
+{
+    drawListsKept = false;
+    for (int i = 0; i < ENTITYSLOT_COUNT; ++i) {
+        entitySlotList[i] = 0;
+        pausedSlotList[i] = 0;
+    }
+    for (int i = 0; i < ENTITY_COUNT; ++i) {
+        if (objectEntityList[i].type)
+            entitySlotList[i >> 5] |= 1u << (i & 0x1F);
+        if (objectEntityList[i].priority == PRIORITY_ACTIVE_PAUSED)
+            pausedSlotList[i >> 5] |= 1u << (i & 0x1F);
+    }
+}
+
+static inline int LowestSetBit(uint bits)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(bits);
+#else
+    int bit = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+static inline int SetBitCount(uint bits)
+{
+#if defined(__GNUC__)
+    return __builtin_popcount(bits);
+#else
+    int count = 0;
+    for (; bits; bits &= bits - 1) ++count;
+    return count;
+#endif
+}
+
+// Returns the first non-blank slot at or after slot, or ENTITY_COUNT if there are none.
+// The word is re-read every call so entities spawned ahead of objectLoop are still picked up this frame
+int NextEntitySlot(int slot)
+{
+    while (slot < ENTITY_COUNT) {
+        uint bits = entitySlotList[slot >> 5] >> (slot & 0x1F);
+        if (bits)
+            return slot + LowestSetBit(bits);
+        slot = (slot | 0x1F) + 1;
+    }
+    return ENTITY_COUNT;
+}
+
+// Rewrites drawListEntries[layer] from frameDrawListSlots, starting at the first block that differs from the list it holds
+static void RebuildDrawList(int layer, int firstBlock)
+{
+    DrawListEntry *list = &drawListEntries[layer];
+    uint *slots         = frameDrawListSlots[layer];
+
+    int pos = 0;
+    for (int block = 0; block < firstBlock; ++block) pos += SetBitCount(slots[block]);
+    for (int block = firstBlock; block < ENTITYSLOT_COUNT; ++block) {
+        for (uint bits = slots[block]; bits; bits &= bits - 1) list->entityRefs[pos++] = (block << 5) + LowestSetBit(bits);
+    }
+    list->listSize = pos;
+}
+
+// The draw lists are kept from frame to frame. While objects are processed, the slots that would've been added to each list are only
+// noted in frameDrawListSlots, then EndDrawLists rewrites just the lists whose slots changed
+static void BeginDrawLists()
+{
+    memset(frameDrawListSlots, 0, sizeof(frameDrawListSlots));
+    buildingDrawLists  = true;
+    appendingDrawLists = false;
+    drawListsEdited    = false;
+}
+
+static inline void AddDrawListEntity(int layer, int slot)
+{
+    frameDrawListSlots[layer][slot >> 5] |= 1u << (slot & 0x1F);
+    if (appendingDrawLists)
+        drawListEntries[layer].entityRefs[drawListEntries[layer].listSize++] = slot;
+}
+
+static void EndDrawLists()
+{
+    buildingDrawLists = false;
+    if (appendingDrawLists) {
+        // a script used the lists this frame, so the rest of them were appended to directly like the original did
+        appendingDrawLists = false;
+        drawListsKept      = !drawListsEdited;
+        if (drawListsKept)
+            memcpy(drawListSlots, frameDrawListSlots, sizeof(drawListSlots));
+        return;
+    }
+
+    for (int layer = 0; layer < DRAWLAYER_COUNT; ++layer) {
+        int block = 0;
+        if (drawListsKept) {
+            while (block < ENTITYSLOT_COUNT && frameDrawListSlots[layer][block] == drawListSlots[layer][block]) ++block;
+            if (block == ENTITYSLOT_COUNT)
+                continue;
+        }
+        RebuildDrawList(layer, block);
+        memcpy(drawListSlots[layer], frameDrawListSlots[layer], sizeof(drawListSlots[layer]));
+    }
+    drawListsKept = true;
+}
+
+void SyncDrawLists(bool editing)
+{
+    if (buildingDrawLists && !appendingDrawLists) {
+        // fill the lists with just the objects processed so far, then append the rest straight to them
+        for (int layer = 0; layer < DRAWLAYER_COUNT; ++layer) RebuildDrawList(layer, 0);
+        appendingDrawLists = true;
+    }
+    if (editing) {
+        // edited lists no longer match drawListSlots, the next frame rebuilds all of them
+        drawListsKept   = false;
+        drawListsEdited = true;
+    }
+}
+
 void ProcessStartupObjects()
 {
     scriptFrameCount           = 0;
@@ -31,101 +165,407 @@ void ProcessStartupObjects()
     activePlayer               = 0;
     activePlayerCount          = 1;
     scriptEng.arrayPosition[2] = TEMPENTITY_START;
-    Entity *entity             = &objectEntityList[TEMPENTITY_START];
     for (int i = 0; i < OBJECT_COUNT; ++i) {
         ObjectScript *scriptInfo    = &objectScriptList[i];
         objectLoop                  = TEMPENTITY_START;
         curObjectType               = i;
         scriptInfo->frameListOffset = scriptFrameCount;
         scriptInfo->spriteSheetID   = 0;
-        entity->type                = i;
+        SetObjectEntityType(TEMPENTITY_START, i);
         if (scriptData[scriptInfo->subStartup.scriptCodePtr] > 0)
-            ProcessScript(scriptInfo->subStartup.scriptCodePtr, scriptInfo->subStartup.jumpTablePtr, SUB_SETUP);
+            ProcessObjectScript(i, &scriptInfo->subStartup, SUB_SETUP);
         scriptInfo->frameCount = scriptFrameCount - scriptInfo->frameListOffset;
     }
-    entity->type  = 0;
+    SetObjectEntityType(TEMPENTITY_START, OBJ_TYPE_BLANKOBJECT);
     curObjectType = 0;
 }
 
+enum EntityActivity { ENTITY_IDLE, ENTITY_RUN, ENTITY_REMOVE };
+
+// ProcessObjects' priority/bounds test, ENTITY_REMOVE is a PRIORITY_ACTIVE_BOUNDS_REMOVE entity that left the screen
+static inline int GetEntityActivity(Entity *entity)
+{
+    int x = 0, y = 0;
+    switch (entity->priority) {
+        case PRIORITY_ACTIVE_BOUNDS:
+            x = entity->XPos >> 16;
+            y = entity->YPos >> 16;
+            if (x > xScrollOffset - OBJECT_BORDER_X1 && x < OBJECT_BORDER_X2 + xScrollOffset && y > yScrollOffset - OBJECT_BORDER_Y1
+                && y < yScrollOffset + OBJECT_BORDER_Y2)
+                return ENTITY_RUN;
+            return ENTITY_IDLE;
+        case PRIORITY_ACTIVE: return ENTITY_RUN;
+        case PRIORITY_ACTIVE_PAUSED: return ENTITY_RUN;
+        case PRIORITY_ACTIVE_XBOUNDS:
+            x = entity->XPos >> 16;
+            if (x > xScrollOffset - OBJECT_BORDER_X1 && x < OBJECT_BORDER_X2 + xScrollOffset)
+                return ENTITY_RUN;
+            return ENTITY_IDLE;
+        case PRIORITY_ACTIVE_BOUNDS_REMOVE:
+            x = entity->XPos >> 16;
+            y = entity->YPos >> 16;
+            if (x <= xScrollOffset - OBJECT_BORDER_X1 || x >= OBJECT_BORDER_X2 + xScrollOffset || y <= yScrollOffset - OBJECT_BORDER_Y1
+                || y >= yScrollOffset + OBJECT_BORDER_Y2)
+                return ENTITY_REMOVE;
+            return ENTITY_RUN;
+        case PRIORITY_INACTIVE: return ENTITY_IDLE;
+        default: return ENTITY_IDLE;
+    }
+}
+
 void ProcessObjects()
 {
-    for (int i = 0; i < DRAWLAYER_COUNT; ++i) drawListEntries[i].listSize = 0;
+    BeginDrawLists();
 
-    for (objectLoop = 0; objectLoop < ENTITY_COUNT; ++objectLoop) {
-        bool active = false;
-        int x = 0, y = 0;
+    // Blank slots never run or draw, so only walk the occupied ones (still in slot order)
+    for (objectLoop = NextEntitySlot(0); objectLoop < ENTITY_COUNT; objectLoop = NextEntitySlot(objectLoop + 1)) {
         Entity *entity = &objectEntityList[objectLoop];
-        switch (entity->priority) {
-            case PRIORITY_ACTIVE_BOUNDS:
-                x      = entity->XPos >> 16;
-                y      = entity->YPos >> 16;
-                active = x > xScrollOffset - OBJECT_BORDER_X1 && x < OBJECT_BORDER_X2 + xScrollOffset
-                         && y > yScrollOffset - OBJECT_BORDER_Y1 && y < yScrollOffset + OBJECT_BORDER_Y2;
-                break;
-            case PRIORITY_ACTIVE: active = true; break;
-            case PRIORITY_ACTIVE_PAUSED: active = true; break;
-            case PRIORITY_ACTIVE_XBOUNDS:
-                x      = entity->XPos >> 16;
-                active = x > xScrollOffset - OBJECT_BORDER_X1 && x < OBJECT_BORDER_X2 + xScrollOffset;
-                break;
-            case PRIORITY_ACTIVE_BOUNDS_REMOVE:
-                x = entity->XPos >> 16;
-                y = entity->YPos >> 16;
-                if (x <= xScrollOffset - OBJECT_BORDER_X1 || x >= OBJECT_BORDER_X2 + xScrollOffset
-                    || y <= yScrollOffset - OBJECT_BORDER_Y1 || y >= yScrollOffset + OBJECT_BORDER_Y2) {
-                    active       = false;
-                    entity->type = OBJ_TYPE_BLANKOBJECT;
-                }
-                else {
-                    active = true;
-                }
-                break;
-            case PRIORITY_INACTIVE: active = false; break;
-            default: break;
-        }
-        if (active && entity->type > OBJ_TYPE_BLANKOBJECT) {
+        int activity   = GetEntityActivity(entity);
+        if (activity == ENTITY_REMOVE)
+            SetObjectEntityType(objectLoop, OBJ_TYPE_BLANKOBJECT);
+        if (activity == ENTITY_RUN && entity->type > OBJ_TYPE_BLANKOBJECT) {
             ObjectScript *scriptInfo = &objectScriptList[entity->type];
             activePlayer             = 0;
             if (scriptData[scriptInfo->subMain.scriptCodePtr] > 0)
-                ProcessScript(scriptInfo->subMain.scriptCodePtr, scriptInfo->subMain.jumpTablePtr, SUB_MAIN);
+                ProcessObjectScript(entity->type, &scriptInfo->subMain, SUB_MAIN);
             if (scriptData[scriptInfo->subPlayerInteraction.scriptCodePtr] > 0) {
                 while (activePlayer < activePlayerCount) {
                     if (playerList[activePlayer].objectInteractions)
-                        ProcessScript(scriptInfo->subPlayerInteraction.scriptCodePtr, scriptInfo->subPlayerInteraction.jumpTablePtr,
-                                      SUB_PLAYERINTERACTION);
+                        ProcessObjectScript(entity->type, &scriptInfo->subPlayerInteraction, SUB_PLAYERINTERACTION);
                     ++activePlayer;
                 }
             }
 
             if (entity->drawOrder < DRAWLAYER_COUNT)
-                drawListEntries[entity->drawOrder].entityRefs[drawListEntries[entity->drawOrder].listSize++] = objectLoop;
+                AddDrawListEntity(entity->drawOrder, objectLoop);
         }
     }
+    EndDrawLists();
 }
 
 void ProcessPausedObjects()
 {
-    for (int i = 0; i < DRAWLAYER_COUNT; ++i) drawListEntries[i].listSize = 0;
+    BeginDrawLists();
 
-    for (objectLoop = 0; objectLoop < ENTITY_COUNT; ++objectLoop) {
-        Entity *entity = &objectEntityList[objectLoop];
+    // Only PRIORITY_ACTIVE_PAUSED entities run here, the masks are re-read after each one in case its scripts changed them
+    for (int block = 0; block < ENTITYSLOT_COUNT; ++block) {
+        uint pending = entitySlotList[block] & pausedSlotList[block];
+        while (pending) {
+            int bit        = LowestSetBit(pending);
+            objectLoop     = (block << 5) + bit;
+            Entity *entity = &objectEntityList[objectLoop];
 
-        if (entity->priority == PRIORITY_ACTIVE_PAUSED && entity->type > OBJ_TYPE_BLANKOBJECT) {
             ObjectScript *scriptInfo = &objectScriptList[entity->type];
             activePlayer             = 0;
             if (scriptData[scriptInfo->subMain.scriptCodePtr] > 0)
-                ProcessScript(scriptInfo->subMain.scriptCodePtr, scriptInfo->subMain.jumpTablePtr, SUB_MAIN);
+                ProcessObjectScript(entity->type, &scriptInfo->subMain, SUB_MAIN);
             if (scriptData[scriptInfo->subPlayerInteraction.scriptCodePtr] > 0) {
                 while (activePlayer < PLAYER_COUNT) {
                     if (playerList[activePlayer].objectInteractions)
-                        ProcessScript(scriptInfo->subPlayerInteraction.scriptCodePtr, scriptInfo->subPlayerInteraction.jumpTablePtr,
-                                      SUB_PLAYERINTERACTION);
+                        ProcessObjectScript(entity->type, &scriptInfo->subPlayerInteraction, SUB_PLAYERINTERACTION);
                     ++activePlayer;
                 }
             }
 
             if (entity->drawOrder < DRAWLAYER_COUNT)
-                drawListEntries[entity->drawOrder].entityRefs[drawListEntries[entity->drawOrder].listSize++] = objectLoop;
+                AddDrawListEntity(entity->drawOrder, objectLoop);
+
+            pending = entitySlotList[block] & pausedSlotList[block] & ~((2u << bit) - 1);
+        }
+    }
+    EndDrawLists();
+}
+
+#if !RETRO_USE_ORIGINAL_CODE
+// Activation check & benchmark (see RunSelfCheck). The vector kernel here builds the masks & draw lists in one pass over a packed
+// position/priority view, but ProcessObjects keeps the scalar GetEntityActivity walk: scripts move, spawn & re-order entities
+// mid-walk, so the kernel's results would only hold up to the first script run. It's kept here so the two can be re-timed
+#define BOUNDSCHECK_COUNT (0x400)
+#define BOUNDSBENCH_RUNS  (0x40)
+
+struct BoundsCheckResult {
+    uint activeMask[ENTITYSLOT_COUNT];
+    uint removeMask[ENTITYSLOT_COUNT];
+    int listSize[DRAWLAYER_COUNT];
+    ushort lists[DRAWLAYER_COUNT][ENTITY_COUNT];
+};
+
+Entity boundsCheckEntities[ENTITY_COUNT];
+uint boundsCheckSlots[ENTITYSLOT_COUNT];
+BoundsCheckResult boundsCheckResults[2];
+
+// the packed view the kernel reads, padded out to whole blocks
+int boundsViewX[ENTITYSLOT_COUNT * 32];
+int boundsViewY[ENTITYSLOT_COUNT * 32];
+int boundsViewPriority[ENTITYSLOT_COUNT * 32];
+byte boundsViewDrawOrder[ENTITYSLOT_COUNT * 32];
+
+// What ProcessObjects does to pick the entities to run & fill the draw lists, minus the scripts
+static void GetEntityBoundsScalar(BoundsCheckResult *result)
+{
+    for (int layer = 0; layer < DRAWLAYER_COUNT; ++layer) result->listSize[layer] = 0;
+    for (int block = 0; block < ENTITYSLOT_COUNT; ++block) {
+        uint active = 0, remove = 0;
+        for (uint bits = boundsCheckSlots[block]; bits; bits &= bits - 1) {
+            int bit        = LowestSetBit(bits);
+            int slot       = (block << 5) + bit;
+            Entity *entity = &boundsCheckEntities[slot];
+            switch (GetEntityActivity(entity)) {
+                case ENTITY_RUN:
+                    active |= 1u << bit;
+                    if (entity->drawOrder < DRAWLAYER_COUNT)
+                        result->lists[entity->drawOrder][result->listSize[entity->drawOrder]++] = slot;
+                    break;
+                case ENTITY_REMOVE: remove |= 1u << bit; break;
+                default: break;
+            }
+        }
+        result->activeMask[block] = active;
+        result->removeMask[block] = remove;
+    }
+}
+
+// The kernel needs this every frame, ProcessObjects' scripts write the entities directly
+static void GatherEntityBoundsView()
+{
+    for (int i = 0; i < ENTITY_COUNT; ++i) {
+        Entity *entity         = &boundsCheckEntities[i];
+        boundsViewX[i]         = entity->XPos >> 16;
+        boundsViewY[i]         = entity->YPos >> 16;
+        boundsViewPriority[i]  = entity->priority;
+        boundsViewDrawOrder[i] = entity->drawOrder;
+    }
+    for (int i = ENTITY_COUNT; i < ENTITYSLOT_COUNT * 32; ++i) {
+        boundsViewX[i]         = 0;
+        boundsViewY[i]         = 0;
+        boundsViewPriority[i]  = PRIORITY_INACTIVE;
+        boundsViewDrawOrder[i] = DRAWLAYER_COUNT;
+    }
+}
+
+#if RETRO_USING_NEON
+// collapses a 4 lane compare result into 4 bits, like _mm_movemask_ps
+static inline uint NeonMoveMask(uint32x4_t mask)
+{
+    static const uint32_t laneBitsData[4] = { 1, 2, 4, 8 };
+    uint32x4_t bits                       = vandq_u32(mask, vld1q_u32(laneBitsData));
+    uint32x2_t sum                        = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+    return vget_lane_u32(vpadd_u32(sum, sum), 0);
+}
+#endif
+
+static void GetEntityBoundsKernel(BoundsCheckResult *result)
+{
+    int minX = xScrollOffset - OBJECT_BORDER_X1;
+    int maxX = OBJECT_BORDER_X2 + xScrollOffset;
+    int minY = yScrollOffset - OBJECT_BORDER_Y1;
+    int maxY = yScrollOffset + OBJECT_BORDER_Y2;
+#if RETRO_USING_SSE2
+    __m128i vMinX    = _mm_set1_epi32(minX);
+    __m128i vMaxX    = _mm_set1_epi32(maxX);
+    __m128i vMinY    = _mm_set1_epi32(minY);
+    __m128i vMaxY    = _mm_set1_epi32(maxY);
+    __m128i vBounds  = _mm_set1_epi32(PRIORITY_ACTIVE_BOUNDS);
+    __m128i vActive  = _mm_set1_epi32(PRIORITY_ACTIVE);
+    __m128i vPaused  = _mm_set1_epi32(PRIORITY_ACTIVE_PAUSED);
+    __m128i vXBounds = _mm_set1_epi32(PRIORITY_ACTIVE_XBOUNDS);
+    __m128i vRemove  = _mm_set1_epi32(PRIORITY_ACTIVE_BOUNDS_REMOVE);
+#elif RETRO_USING_NEON
+    int32x4_t vMinX    = vdupq_n_s32(minX);
+    int32x4_t vMaxX    = vdupq_n_s32(maxX);
+    int32x4_t vMinY    = vdupq_n_s32(minY);
+    int32x4_t vMaxY    = vdupq_n_s32(maxY);
+    int32x4_t vBounds  = vdupq_n_s32(PRIORITY_ACTIVE_BOUNDS);
+    int32x4_t vActive  = vdupq_n_s32(PRIORITY_ACTIVE);
+    int32x4_t vPaused  = vdupq_n_s32(PRIORITY_ACTIVE_PAUSED);
+    int32x4_t vXBounds = vdupq_n_s32(PRIORITY_ACTIVE_XBOUNDS);
+    int32x4_t vRemove  = vdupq_n_s32(PRIORITY_ACTIVE_BOUNDS_REMOVE);
+#endif
+
+    for (int layer = 0; layer < DRAWLAYER_COUNT; ++layer) result->listSize[layer] = 0;
+    for (int block = 0; block < ENTITYSLOT_COUNT; ++block) {
+        int *posX     = &boundsViewX[block << 5];
+        int *posY     = &boundsViewY[block << 5];
+        int *priority = &boundsViewPriority[block << 5];
+        uint active = 0, remove = 0;
+#if RETRO_USING_SSE2
+        for (int i = 0; i < 32; i += 4) {
+            __m128i x = _mm_loadu_si128((__m128i *)&posX[i]);
+            __m128i y = _mm_loadu_si128((__m128i *)&posY[i]);
+            __m128i p = _mm_loadu_si128((__m128i *)&priority[i]);
+
+            __m128i inX  = _mm_and_si128(_mm_cmpgt_epi32(x, vMinX), _mm_cmplt_epi32(x, vMaxX));
+            __m128i inXY = _mm_and_si128(inX, _mm_and_si128(_mm_cmpgt_epi32(y, vMinY), _mm_cmplt_epi32(y, vMaxY)));
+            __m128i pRem = _mm_cmpeq_epi32(p, vRemove);
+
+            __m128i act = _mm_and_si128(_mm_or_si128(_mm_cmpeq_epi32(p, vBounds), pRem), inXY);
+            act         = _mm_or_si128(act, _mm_or_si128(_mm_cmpeq_epi32(p, vActive), _mm_cmpeq_epi32(p, vPaused)));
+            act         = _mm_or_si128(act, _mm_and_si128(_mm_cmpeq_epi32(p, vXBounds), inX));
+
+            active |= (uint)_mm_movemask_ps(_mm_castsi128_ps(act)) << i;
+            remove |= (uint)_mm_movemask_ps(_mm_castsi128_ps(_mm_andnot_si128(inXY, pRem))) << i;
+        }
+#elif RETRO_USING_NEON
+        for (int i = 0; i < 32; i += 4) {
+            int32x4_t x = vld1q_s32(&posX[i]);
+            int32x4_t y = vld1q_s32(&posY[i]);
+            int32x4_t p = vld1q_s32(&priority[i]);
+
+            uint32x4_t inX  = vandq_u32(vcgtq_s32(x, vMinX), vcltq_s32(x, vMaxX));
+            uint32x4_t inXY = vandq_u32(inX, vandq_u32(vcgtq_s32(y, vMinY), vcltq_s32(y, vMaxY)));
+            uint32x4_t pRem = vceqq_s32(p, vRemove);
+
+            uint32x4_t act = vandq_u32(vorrq_u32(vceqq_s32(p, vBounds), pRem), inXY);
+            act            = vorrq_u32(act, vorrq_u32(vceqq_s32(p, vActive), vceqq_s32(p, vPaused)));
+            act            = vorrq_u32(act, vandq_u32(vceqq_s32(p, vXBounds), inX));
+
+            active |= NeonMoveMask(act) << i;
+            remove |= NeonMoveMask(vbicq_u32(pRem, inXY)) << i;
+        }
+#else
+        for (int i = 0; i < 32; ++i) {
+            bool inX  = posX[i] > minX && posX[i] < maxX;
+            bool inXY = inX && posY[i] > minY && posY[i] < maxY;
+            switch (priority[i]) {
+                case PRIORITY_ACTIVE_BOUNDS: active |= (uint)inXY << i; break;
+                case PRIORITY_ACTIVE:
+                case PRIORITY_ACTIVE_PAUSED: active |= 1u << i; break;
+                case PRIORITY_ACTIVE_XBOUNDS: active |= (uint)inX << i; break;
+                case PRIORITY_ACTIVE_BOUNDS_REMOVE:
+                    active |= (uint)inXY << i;
+                    remove |= (uint)!inXY << i;
+                    break;
+                default: break;
+            }
+        }
+#endif
+        active &= boundsCheckSlots[block];
+        remove &= boundsCheckSlots[block];
+        result->activeMask[block] = active;
+        result->removeMask[block] = remove;
+
+        for (; active; active &= active - 1) {
+            int slot  = (block << 5) + LowestSetBit(active);
+            int layer = boundsViewDrawOrder[slot];
+            if (layer < DRAWLAYER_COUNT)
+                result->lists[layer][result->listSize[layer]++] = slot;
+        }
+    }
+}
+
+// a position around the camera range min to max, a quarter of them on or right next to one of the bounds
+static int GetBoundsCheckPosition(int min, int max)
+{
+    int pos = 0;
+    if (!(SelfCheckRandom() & 3))
+        pos = ((SelfCheckRandom() & 1) ? min : max) + (int)(SelfCheckRandom() % 3) - 1;
+    else
+        pos = min - 0x100 + (int)(SelfCheckRandom() % (uint)(max - min + 0x200));
+    return (int)(((uint)pos << 16) | (SelfCheckRandom() & 0xFFFF));
+}
+
+// occupancy is out of 0x100. The check mixes every priority (& a few out of range ones) right around the camera, stageLayout is more
+// like a stage's: mostly PRIORITY_ACTIVE_BOUNDS, spread over the whole map so most of them are off screen
+static void SetupBoundsCheck(int occupancy, bool stageLayout)
+{
+    xScrollOffset    = SelfCheckRandom() % 0x4000;
+    yScrollOffset    = SelfCheckRandom() % 0x800;
+    OBJECT_BORDER_X2 = SCREEN_XSIZE + 0x80;
+    memset(boundsCheckSlots, 0, sizeof(boundsCheckSlots));
+    for (int i = 0; i < ENTITY_COUNT; ++i) {
+        Entity *entity = &boundsCheckEntities[i];
+        entity->type   = OBJ_TYPE_BLANKOBJECT;
+        if ((int)(SelfCheckRandom() & 0xFF) < occupancy)
+            entity->type = 1 + SelfCheckRandom() % (OBJECT_COUNT - 1);
+        if (stageLayout) {
+            entity->priority  = (SelfCheckRandom() & 7) ? PRIORITY_ACTIVE_BOUNDS : PRIORITY_ACTIVE;
+            entity->drawOrder = 3;
+            entity->XPos      = (int)(SelfCheckRandom() % 0x4400) << 16;
+            entity->YPos      = (int)(SelfCheckRandom() % 0x900) << 16;
+        }
+        else {
+            entity->priority  = SelfCheckRandom() % (PRIORITY_INACTIVE + 2);
+            entity->drawOrder = SelfCheckRandom() % (DRAWLAYER_COUNT + 1);
+            entity->XPos      = GetBoundsCheckPosition(xScrollOffset - OBJECT_BORDER_X1, OBJECT_BORDER_X2 + xScrollOffset);
+            entity->YPos      = GetBoundsCheckPosition(yScrollOffset - OBJECT_BORDER_Y1, yScrollOffset + OBJECT_BORDER_Y2);
+        }
+        if (entity->type)
+            boundsCheckSlots[i >> 5] |= 1u << (i & 0x1F);
+    }
+}
+
+static bool CompareBoundsResults(BoundsCheckResult *a, BoundsCheckResult *b)
+{
+    if (memcmp(a->activeMask, b->activeMask, sizeof(a->activeMask)) || memcmp(a->removeMask, b->removeMask, sizeof(a->removeMask))
+        || memcmp(a->listSize, b->listSize, sizeof(a->listSize)))
+        return false;
+    for (int layer = 0; layer < DRAWLAYER_COUNT; ++layer) {
+        if (memcmp(a->lists[layer], b->lists[layer], a->listSize[layer] * sizeof(ushort)))
+            return false;
+    }
+    return true;
+}
+
+int CheckEntityBounds()
+{
+    int storeXScroll  = xScrollOffset;
+    int storeYScroll  = yScrollOffset;
+    int storeBorderX2 = OBJECT_BORDER_X2;
+    int failures      = 0;
+    for (int c = 0; c < BOUNDSCHECK_COUNT; ++c) {
+        SetupBoundsCheck(SelfCheckRandom() % 0x101, SelfCheckRandom() & 1);
+        GetEntityBoundsScalar(&boundsCheckResults[0]);
+        GatherEntityBoundsView();
+        GetEntityBoundsKernel(&boundsCheckResults[1]);
+        if (!CompareBoundsResults(&boundsCheckResults[0], &boundsCheckResults[1]))
+            ++failures;
+    }
+    xScrollOffset    = storeXScroll;
+    yScrollOffset    = storeYScroll;
+    OBJECT_BORDER_X2 = storeBorderX2;
+    ReportSelfCheck("entity bounds kernel", failures, BOUNDSCHECK_COUNT);
+    return failures;
+}
+
+// Times the scalar walk against the gather & the kernel at ENTITY_COUNT entities, best of BOUNDSBENCH_RUNS. The kernel on its own
+// is what a packed view kept up to date for free would cost
+void BenchmarkEntityBounds()
+{
+    int storeXScroll  = xScrollOffset;
+    int storeYScroll  = yScrollOffset;
+    int storeBorderX2 = OBJECT_BORDER_X2;
+    int occupancy[]   = { 0x33, 0xAB, 0x100 };
+    for (int l = 0; l < 2; ++l) {
+        for (int o = 0; o < 3; ++o) {
+            long long best[3] = { 0, 0, 0 };
+            for (int r = 0; r < BOUNDSBENCH_RUNS; ++r) {
+                SetupBoundsCheck(occupancy[o], l == 0);
+
+                long long start = GetBenchmarkTime();
+                GetEntityBoundsScalar(&boundsCheckResults[0]);
+                long long time = GetBenchmarkTime() - start;
+                if (!r || time < best[0])
+                    best[0] = time;
+
+                start = GetBenchmarkTime();
+                GatherEntityBoundsView();
+                time = GetBenchmarkTime() - start;
+                if (!r || time < best[1])
+                    best[1] = time;
+
+                start = GetBenchmarkTime();
+                GetEntityBoundsKernel(&boundsCheckResults[1]);
+                time = GetBenchmarkTime() - start;
+                if (!r || time < best[2])
+                    best[2] = time;
+            }
+            printf("entity activation, %d entities %d%% occupied, %s: scalar %.2f us, kernel %.2f us + %.2f us packed view gather\n",
+                   ENTITY_COUNT, occupancy[o] * 100 / 0x100, l == 0 ? "stage layout" : "mixed priorities", best[0] / 1000.0,
+                   best[2] / 1000.0, best[1] / 1000.0);
         }
     }
-}
\ No newline at end of file
+    xScrollOffset    = storeXScroll;
+    yScrollOffset    = storeYScroll;
+    OBJECT_BORDER_X2 = storeBorderX2;
+}
+#endif
@@ -4,26 +4,29 @@
 #define ENTITY_COUNT (0x4A0)
 #define TEMPENTITY_START (ENTITY_COUNT - 0x80)
 #define OBJECT_COUNT (0x100)
+#define ENTITYSLOT_COUNT ((ENTITY_COUNT + 31) / 32)
 
+// Fields read by the activation and draw list passes are grouped in the first 16 bytes
+// so those passes don't drag values[] etc into the cache
 struct Entity {
     int XPos;
     int YPos;
-    int values[8];
-    int scale;
-    int rotation;
-    int animationTimer;
-    int animationSpeed;
     byte type;
-    byte propertyValue;
-    byte state;
     byte priority;
     byte drawOrder;
+    byte propertyValue;
+    byte state;
     byte direction;
     byte inkEffect;
     byte alpha;
     byte animation;
     byte prevAnimation;
     byte frame;
+    int scale;
+    int rotation;
+    int animationTimer;
+    int animationSpeed;
+    int values[8];
 };
 
 enum ObjectTypes {
@@ -42,6 +45,8 @@ enum ObjectPriority {
 extern int objectLoop;
 extern int curObjectType;
 extern Entity objectEntityList[ENTITY_COUNT];
+extern uint entitySlotList[ENTITYSLOT_COUNT];
+extern uint pausedSlotList[ENTITYSLOT_COUNT];
 
 extern char typeNames[OBJECT_COUNT][0x40];
 
@@ -50,10 +55,40 @@ extern int OBJECT_BORDER_X2;
 extern const int OBJECT_BORDER_Y1;
 extern const int OBJECT_BORDER_Y2;
 
+// Every write to Entity::type must go through here so entitySlotList stays in sync
+inline void SetObjectEntityType(int slot, byte type)
+{
+    objectEntityList[slot].type = type;
+    if (type)
+        entitySlotList[slot >> 5] |= 1u << (slot & 0x1F);
+    else
+        entitySlotList[slot >> 5] &= ~(1u << (slot & 0x1F));
+}
+
+// Same as above for Entity::priority, pausedSlotList lets ProcessPausedObjects skip everything that can't run while paused
+inline void SetObjectEntityPriority(int slot, byte priority)
+{
+    objectEntityList[slot].priority = priority;
+    if (priority == PRIORITY_ACTIVE_PAUSED)
+        pausedSlotList[slot >> 5] |= 1u << (slot & 0x1F);
+    else
+        pausedSlotList[slot >> 5] &= ~(1u << (slot & 0x1F));
+}
+
+void RefreshEntitySlots();
+int NextEntitySlot(int slot);
+// Anything that reads (editing = false) or changes (editing = true) drawListEntries outside of drawing them must call this first
+void SyncDrawLists(bool editing);
+
 void ProcessStartupObjects();
 void ProcessObjects();
 void ProcessPausedObjects();
 
 void SetObjectTypeName(const char *objectName, int objectID);
 
+#if !RETRO_USE_ORIGINAL_CODE
+int CheckEntityBounds();
+void BenchmarkEntityBounds();
+#endif
+
 #endif // !OBJECT_H
@@ -2,11 +2,11 @@
 
 // Palettes (as RGB888 Colours)
 PaletteEntry fullPalette32[PALETTE_COUNT][PALETTE_SIZE];
-PaletteEntry *activePalette32 = fullPalette32[0];
+RETRO_BAND_LOCAL PaletteEntry *activePalette32 = fullPalette32[0];
 
 // Palettes (as RGB565 Colours)
 ushort fullPalette[PALETTE_COUNT][PALETTE_SIZE];
-ushort *activePalette = fullPalette[0]; // Ptr to the 256 colour set thats active
+RETRO_BAND_LOCAL ushort *activePalette = fullPalette[0]; // Ptr to the 256 colour set thats active
 
 byte gfxLineBuffer[SCREEN_YSIZE]; // Pointers to active palette
 int GFX_LINESIZE;
@@ -27,6 +27,17 @@ int texPaletteNum = 0;
 
 uint gfxPalette16to32[0x10000];
 
+#if RETRO_USE_PALETTE_FADE
+ushort paletteFadeSource[PALETTE_COUNT][PALETTE_SIZE];
+bool paletteFadeApplied = false;
+
+// the palette's side of the blend, and the fade colour's side which is the same for every entry
+short *paletteFadeTable = NULL;
+int paletteFadeR        = 0;
+int paletteFadeG        = 0;
+int paletteFadeB        = 0;
+#endif
+
 void LoadPalette(const char *filePath, int paletteID, int startPaletteIndex, int startIndex, int endIndex)
 {
     FileInfo info;
@@ -61,6 +72,7 @@ void SetLimitedFade(byte paletteID, byte R, byte G, byte B, ushort alpha, int st
 {
     if (paletteID >= PALETTE_COUNT)
         return;
+    FlushDrawCommands();
     paletteMode     = 1;
     activePalette   = fullPalette[paletteID];
     activePalette32 = fullPalette32[paletteID];
@@ -83,4 +95,78 @@ void SetLimitedFade(byte paletteID, byte R, byte G, byte B, ushort alpha, int st
             activePalette[i] |= 1;
         }
     }
+#if RETRO_USE_PALETTE_FADE
+    RefadePalette(activePalette, startIndex, endIndex);
+#endif
+}
+
+#if RETRO_USE_PALETTE_FADE
+// The same blend DrawRectangle does to every pixel of a fade, done to one colour
+ushort FadePaletteColour(ushort colour)
+{
+    return (paletteFadeTable[colour & (BLENDTABLE_XSIZE - 1)] + paletteFadeB) | ((paletteFadeTable[(colour & 0x7E0) >> 6] + paletteFadeG) << 6)
+           | ((paletteFadeTable[(colour & 0xF800) >> 11] + paletteFadeR) << 11);
+}
+
+void BeginPaletteFade(byte R, byte G, byte B, int A)
+{
+    if (paletteFadeApplied)
+        return;
+    ushort colour    = RGB888_TO_RGB565(R, G, B);
+    short *fadeTable = &blendLookupTable[BLENDTABLE_XSIZE * A];
+    paletteFadeTable = &blendLookupTable[BLENDTABLE_XSIZE * ((BLENDTABLE_YSIZE - 1) - A)];
+    paletteFadeR     = fadeTable[(colour & 0xF800) >> 11];
+    paletteFadeG     = fadeTable[(colour & 0x7E0) >> 6];
+    paletteFadeB     = fadeTable[colour & (BLENDTABLE_XSIZE - 1)];
+    ResumePaletteFade();
+}
+
+// Puts the real colours back, returns if there was a fade to put back with ResumePaletteFade
+bool SuspendPaletteFade()
+{
+    if (!paletteFadeApplied)
+        return false;
+    FlushDrawCommands();
+    memcpy(fullPalette, paletteFadeSource, sizeof(fullPalette));
+    paletteFadeApplied = false;
+    return true;
+}
+
+void ResumePaletteFade()
+{
+    memcpy(paletteFadeSource, fullPalette, sizeof(fullPalette));
+    for (int p = 0; p < PALETTE_COUNT; ++p) {
+        for (int c = 0; c < PALETTE_SIZE; ++c) fullPalette[p][c] = FadePaletteColour(paletteFadeSource[p][c]);
+    }
+    paletteFadeApplied = true;
+}
+
+// Palette writes go straight to fullPalette. While the fade's applied, this keeps the real colours they wrote to entries
+// [startIndex, endIndex) of palette (one of the fullPalette rows) and fades just those entries
+void RefadePalette(ushort *palette, int startIndex, int endIndex)
+{
+    if (!paletteFadeApplied)
+        return;
+    ushort *source = paletteFadeSource[(palette - fullPalette[0]) / PALETTE_SIZE];
+    for (int i = startIndex; i < endIndex; ++i) {
+        source[i]  = palette[i];
+        palette[i] = FadePaletteColour(palette[i]);
+    }
+}
+
+// Each colour's faded on its own, so rotating the faded entries of palette is right as is. The real ones get rotated the same way here
+void RotatePaletteFadeSource(ushort *palette, int startIndex, int endIndex, bool right)
+{
+    ushort *source = paletteFadeSource[(palette - fullPalette[0]) / PALETTE_SIZE];
+    if (right) {
+        ushort startClr = source[endIndex];
+        for (int i = endIndex; i > startIndex; --i) source[i] = source[i - 1];
+        source[startIndex] = startClr;
+    }
+    else {
+        ushort startClr = source[startIndex];
+        for (int i = startIndex; i < endIndex; ++i) source[i] = source[i + 1];
+        source[endIndex] = startClr;
+    }
 }
+#endif
@@ -20,8 +20,8 @@ struct PaletteEntry {
 // Palettes (as RGB565 Colours)
 extern PaletteEntry fullPalette32[PALETTE_COUNT][PALETTE_SIZE];
 extern ushort fullPalette[PALETTE_COUNT][PALETTE_SIZE];
-extern ushort *activePalette; // Ptr to the 256 colour set thats active
-extern PaletteEntry *activePalette32;
+extern RETRO_BAND_LOCAL ushort *activePalette; // Ptr to the 256 colour set thats active
+extern RETRO_BAND_LOCAL PaletteEntry *activePalette32;
 
 extern byte gfxLineBuffer[SCREEN_YSIZE]; // Pointers to active palette
 extern int GFX_LINESIZE;
@@ -51,10 +51,27 @@ extern uint gfxPalette16to32[0x10000];
     else if (renderType == RENDER_HW)                                                                                                                \
         colour = RGB888_TO_RGB5551(r, g, b);
 
+// Drawing.cpp, draws queued up by band rendering have to land before the palette they were drawn with changes
+void FlushDrawCommands();
+
+#if RETRO_USE_PALETTE_FADE
+// While a stage's fade is applied to the palettes, fullPalette holds the faded colours & these are the real ones
+extern ushort paletteFadeSource[PALETTE_COUNT][PALETTE_SIZE];
+extern bool paletteFadeApplied;
+
+void BeginPaletteFade(byte R, byte G, byte B, int A);
+bool SuspendPaletteFade();
+void ResumePaletteFade();
+ushort FadePaletteColour(ushort colour);
+void RefadePalette(ushort *palette, int startIndex, int endIndex);
+void RotatePaletteFadeSource(ushort *palette, int startIndex, int endIndex, bool right);
+#endif
+
 void LoadPalette(const char *filePath, int paletteID, int startPaletteIndex, int startIndex, int endIndex);
 
 inline void SetActivePalette(byte newActivePal, int startLine, int endLine)
 {
+    FlushDrawCommands();
     if (renderType == RENDER_SW) {
         if (newActivePal < PALETTE_COUNT)
             for (int l = startLine; l < endLine && l < SCREEN_YSIZE; l++) gfxLineBuffer[l] = newActivePal;
@@ -71,6 +88,7 @@ inline void SetActivePalette(byte newActivePal, int startLine, int endLine)
 
 inline void SetPaletteEntry(byte paletteIndex, byte index, byte r, byte g, byte b)
 {
+    FlushDrawCommands();
     if (paletteIndex != 0xFF) {
         PACK_RGB888(fullPalette[paletteIndex][index], r, g, b);
         fullPalette32[paletteIndex][index].r = r;
@@ -93,20 +111,34 @@ inline void SetPaletteEntry(byte paletteIndex, byte index, byte r, byte g, byte
                 activePalette[index] |= 1;
         }
     }
+#if RETRO_USE_PALETTE_FADE
+    RefadePalette(paletteIndex != 0xFF ? fullPalette[paletteIndex] : activePalette, index, index + 1);
+#endif
 }
 
 inline void CopyPalette(byte src, byte dest)
 {
+    FlushDrawCommands();
     if (src < PALETTE_COUNT && dest < PALETTE_COUNT) {
         for (int i = 0; i < PALETTE_SIZE; ++i) {
             fullPalette[dest][i]   = fullPalette[src][i];
             fullPalette32[dest][i] = fullPalette32[src][i];
         }
+#if RETRO_USE_PALETTE_FADE
+        // that copied the faded colours, the real ones go along with them
+        if (paletteFadeApplied)
+            memcpy(paletteFadeSource[dest], paletteFadeSource[src], sizeof(paletteFadeSource[dest]));
+#endif
     }
 }
 
 inline void RotatePalette(byte startIndex, byte endIndex, bool right)
 {
+    FlushDrawCommands();
+#if RETRO_USE_PALETTE_FADE
+    if (paletteFadeApplied)
+        RotatePaletteFadeSource(activePalette, startIndex, endIndex, right);
+#endif
     if (right) {
         ushort startClr         = activePalette[endIndex];
         PaletteEntry startClr32 = activePalette32[endIndex];
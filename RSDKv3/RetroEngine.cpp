@@ -38,6 +38,9 @@ bool ProcessEvents()
         switch (Engine.sdlEvents.type) {
 #if RETRO_USING_SDL2
             case SDL_WINDOWEVENT:
+#if RETRO_USE_DIRTY_RECTS
+                presentedFrameValid = false; // resized, exposed etc, so the next frame gets presented in full
+#endif
                 switch (Engine.sdlEvents.window.event) {
                     case SDL_WINDOWEVENT_MAXIMIZED: {
                         SDL_RestoreWindow(Engine.window);
@@ -63,6 +66,10 @@ bool ProcessEvents()
                 break;
             case SDL_APP_WILLENTERFOREGROUND: Engine.hasFocus = true; break;
             case SDL_APP_TERMINATING: Engine.gameMode = ENGINE_EXITGAME; return false;
+#if RETRO_USE_DIRTY_RECTS
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET: presentedFrameValid = false; break;
+#endif
 
 #endif
 
@@ -357,17 +364,22 @@ void RetroEngine::Run()
     unsigned long long targetFreq = SDL_GetPerformanceFrequency() / Engine.refreshRate;
     unsigned long long curTicks   = 0;
     unsigned long long prevTicks  = 0;
+#if RETRO_USE_HEADLESS
+    unsigned long long startTicks = SDL_GetPerformanceCounter();
+#endif
 
     while (running) {
-#if !RETRO_USE_ORIGINAL_CODE
-        if (!vsync) {
+#if !RETRO_USE_ORIGINAL_CODE && !RETRO_USE_HEADLESS
+        if (!vsync && !benchmarkActive) {
             curTicks = SDL_GetPerformanceCounter();
             if (curTicks < prevTicks + targetFreq)
                 continue;
             prevTicks = curTicks;
         }
 #endif
+#if !RETRO_USE_HEADLESS
         running = ProcessEvents();
+#endif
 
         // Focus Checks
         if (!((disableFocusPause + 1) & 2)) {
@@ -385,6 +397,9 @@ void RetroEngine::Run()
         if (!(Engine.focusState & 1)) {
             for (int s = 0; s < gameSpeed; ++s) {
                 ProcessInput();
+#if !RETRO_USE_ORIGINAL_CODE
+                ApplyBenchmarkInput();
+#endif
 
                 if (!masterPaused || frameStep) {
                     switch (gameMode) {
@@ -441,17 +456,46 @@ void RetroEngine::Run()
                         case ENGINE_WAIT: break;
 
                         case ENGINE_VIDEOWAIT:
+#if RETRO_USE_HEADLESS
+                            // video timing follows the wall clock, so skip them entirely to keep runs deterministic
+                            StopVideoPlayback();
+                            ResumeSound();
+                            gameMode = ENGINE_MAINGAME;
+#else
                             if (ProcessVideo() == 1)
                                 gameMode = ENGINE_MAINGAME;
+#endif
                             break;
 
                         default: break;
                     }
                 }
+
+#if !RETRO_USE_ORIGINAL_CODE
+                ++simFrame;
+                if (stateHashLog) {
+                    char hashBuf[0x20];
+                    sprintf(hashBuf, "%d %08X\n", simFrame, GetEngineStateHash());
+                    fWrite(hashBuf, 1, strlen(hashBuf), stateHashLog);
+                }
+                if ((frameLimit && simFrame >= frameLimit) || inputReplayMode == INPUTREPLAY_FINISHED)
+                    running = false;
+#endif
             }
         }
 
+#if !RETRO_USE_HEADLESS
+#if !RETRO_USE_ORIGINAL_CODE
+        MarkBenchmarkPhase(-1);
+#endif
         FlipScreen();
+#if !RETRO_USE_ORIGINAL_CODE
+        MarkBenchmarkPhase(BENCHPHASE_FLIP);
+#endif
+#endif
+#if !RETRO_USE_ORIGINAL_CODE
+        UpdateBenchmark();
+#endif
 
 #if RETRO_USING_OPENGL && RETRO_USING_SDL2
         SDL_GL_SwapWindow(Engine.window);
@@ -470,6 +514,19 @@ void RetroEngine::Run()
 #endif
     }
 
+#if RETRO_USE_HEADLESS
+    double runTime = (SDL_GetPerformanceCounter() - startTicks) / (double)SDL_GetPerformanceFrequency();
+    printf("%d frames in %.3fs (%.1f fps), final state hash %08X\n", simFrame, runTime, runTime > 0 ? simFrame / runTime : 0.0,
+           GetEngineStateHash());
+#endif
+#if !RETRO_USE_ORIGINAL_CODE
+    StopInputReplay();
+    if (stateHashLog) {
+        fClose(stateHashLog);
+        stateHashLog = nullptr;
+    }
+#endif
+
     ReleaseAudioDevice();
     StopVideoPlayback();
     ReleaseRenderDevice();
@@ -483,6 +540,88 @@ void RetroEngine::Run()
 #endif
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// FNV-1a over the simulation state, pointers are swapped for list indices so hashes match between runs
+uint GetEngineStateHash()
+{
+    uint hash = 0x811C9DC5;
+#define HashData(data, size)                                                                                                                         \
+    for (size_t h = 0; h < (size); ++h) hash = (hash ^ ((const byte *)(data))[h]) * 0x01000193;
+
+#define HashValue(value) HashData(&(value), sizeof(value))
+
+    HashData(objectEntityList, sizeof(objectEntityList));
+    for (int p = 0; p < PLAYER_COUNT; ++p) {
+        // member by member, Player has padding that a copy of it doesn't keep the contents of
+        Player *player = &playerList[p];
+        HashValue(player->entityNo);
+        HashValue(player->XPos);
+        HashValue(player->YPos);
+        HashValue(player->XVelocity);
+        HashValue(player->YVelocity);
+        HashValue(player->speed);
+        HashValue(player->screenXPos);
+        HashValue(player->screenYPos);
+        HashValue(player->angle);
+        HashValue(player->timer);
+        HashValue(player->lookPos);
+        HashValue(player->values);
+        HashValue(player->collisionMode);
+        HashValue(player->skidding);
+        HashValue(player->pushing);
+        HashValue(player->collisionPlane);
+        HashValue(player->controlMode);
+        HashValue(player->controlLock);
+        HashValue(player->topSpeed);
+        HashValue(player->acceleration);
+        HashValue(player->deceleration);
+        HashValue(player->airAcceleration);
+        HashValue(player->airDeceleration);
+        HashValue(player->gravityStrength);
+        HashValue(player->jumpStrength);
+        HashValue(player->jumpCap);
+        HashValue(player->rollingAcceleration);
+        HashValue(player->rollingDeceleration);
+        HashValue(player->visible);
+        HashValue(player->tileCollisions);
+        HashValue(player->objectInteractions);
+        HashValue(player->left);
+        HashValue(player->right);
+        HashValue(player->up);
+        HashValue(player->down);
+        HashValue(player->jumpPress);
+        HashValue(player->jumpHold);
+        HashValue(player->followPlayer1);
+        HashValue(player->trackScroll);
+        HashValue(player->gravity);
+        HashValue(player->water);
+        HashValue(player->flailing);
+        int animationFile = player->animationFile ? (int)(player->animationFile - animationFileList) + 1 : 0;
+        int boundEntity   = player->boundEntity ? (int)(player->boundEntity - objectEntityList) + 1 : 0;
+        HashValue(animationFile);
+        HashValue(boundEntity);
+    }
+    HashData(&scriptEng, sizeof(scriptEng));
+    // the last drawn frame too, so replays can also check renderer changes (e.g. RenderBands) are pixel identical
+    if (Engine.frameBuffer)
+        HashData(Engine.frameBuffer, SCREEN_XSIZE * SCREEN_YSIZE * sizeof(ushort));
+
+#undef HashValue
+#undef HashData
+    return hash;
+}
+
+bool OpenStateHashLog(const char *filePath)
+{
+    Engine.stateHashLog = fOpen(filePath, "w");
+    if (!Engine.stateHashLog) {
+        PrintLog("ERROR: Couldn't open file '%s' for writing!", filePath);
+        return false;
+    }
+    return true;
+}
+#endif
+
 #if RETRO_USE_MOD_LOADER
 const tinyxml2::XMLElement *FirstXMLChildElement(tinyxml2::XMLDocument *doc, const tinyxml2::XMLElement *elementPtr, const char *name)
 {
@@ -1234,9 +1373,9 @@ void RetroEngine::Callback(int callbackID)
             PauseSound();
             for (int o = 0; o < OBJECT_COUNT; ++o) {
                 if (StrComp("PauseMenu", typeNames[o])) {
-                    objectEntityList[9].type      = o;
+                    SetObjectEntityType(9, o);
                     objectEntityList[9].drawOrder = 6;
-                    objectEntityList[9].priority  = PRIORITY_ALWAYS;
+                    SetObjectEntityPriority(9, PRIORITY_ALWAYS);
                     if (activeStageList == STAGELIST_SPECIAL)
                         stageLayouts[0].type = LAYER_3DFLOOR;
                     for (int s = 0; s < globalSFXCount + stageSFXCount; ++s) {
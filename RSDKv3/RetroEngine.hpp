@@ -14,6 +14,11 @@
 #define RETRO_USE_MOD_LOADER (!RETRO_USE_ORIGINAL_CODE && 1)
 #endif
 
+// Runs the engine with no window, audio device, vsync or frame limiter, meant for input replays & regression runs (see main.cpp)
+#ifndef RETRO_USE_HEADLESS
+#define RETRO_USE_HEADLESS (0)
+#endif
+
 // Forces all DLC flags to be disabled, this should be enabled in any public releases
 #ifndef RSDK_AUTOBUILD
 #define RSDK_AUTOBUILD (0)
@@ -29,6 +34,68 @@
 #include <regex>
 #endif
 
+// ================
+// SIMD
+// ================
+// Setting this to 0 forces the scalar fallbacks of every vectorized routine
+#ifndef RETRO_USE_SIMD
+#define RETRO_USE_SIMD (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+#if RETRO_USE_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define RETRO_USING_SSE2 (1)
+#define RETRO_USING_NEON (0)
+#elif RETRO_USE_SIMD && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define RETRO_USING_SSE2 (0)
+#define RETRO_USING_NEON (1)
+#else
+#define RETRO_USING_SSE2 (0)
+#define RETRO_USING_NEON (0)
+#endif
+
+// ================
+// THREADING
+// ================
+// Lets the software renderer split stage drawing into horizontal bands that worker threads rasterize in parallel ("RenderBands" in settings.ini)
+#ifndef RETRO_USE_BAND_RENDERING
+#define RETRO_USE_BAND_RENDERING (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+#if RETRO_USE_BAND_RENDERING
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+// renderer state every band thread keeps its own copy of
+#define RETRO_BAND_LOCAL thread_local
+#else
+#define RETRO_BAND_LOCAL
+#endif
+
+// ================
+// CACHES
+// ================
+// Lets H-scroll layer lines that haven't scrolled reuse the tile row they were built from last frame
+#ifndef RETRO_USE_TILEROW_CACHE
+#define RETRO_USE_TILEROW_CACHE (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Lets the tile row cache keep FLIP_X, FLIP_Y & FLIP_XY copies of the stage tileset, so every tile reads forwards ("FlippedTileset" in settings.ini)
+#ifndef RETRO_USE_FLIPPED_TILESET
+#define RETRO_USE_FLIPPED_TILESET (RETRO_USE_TILEROW_CACHE && 1)
+#endif
+
+// Lets a fade over the whole stage be applied to the palettes it's drawn with, instead of to every pixel once it's drawn ("PaletteFade" in settings.ini)
+#ifndef RETRO_USE_PALETTE_FADE
+#define RETRO_USE_PALETTE_FADE (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Lets 3D scenes drop faces that can't draw anything before sorting them, 0 sorts & draws every face like the original (make replaycheck-3d)
+#ifndef RETRO_USE_3D_FACE_CULL
+#define RETRO_USE_3D_FACE_CULL (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
 // ================
 // STANDARD TYPES
 // ================
@@ -125,6 +192,13 @@ typedef unsigned int uint;
 #define RETRO_USING_SDL2 (0)
 #endif
 
+// Only uploads the part of each frame that changed to the screen texture, and doesn't render unchanged frames when vsync is off
+// Off by default: anything that scrolls redraws the whole frame, so the diff is paid on top of a full upload (see -selfcheck)
+// Worth turning on (-DRETRO_USE_DIRTY_RECTS=1) where the game mostly sits on static screens, an SDL2 build is needed for it
+#ifndef RETRO_USE_DIRTY_RECTS
+#define RETRO_USE_DIRTY_RECTS (0)
+#endif
+
 #if RETRO_PLATFORM == RETRO_iOS || RETRO_PLATFORM == RETRO_ANDROID || RETRO_PLATFORM == RETRO_WP7
 #define RETRO_GAMEPLATFORM (RETRO_MOBILE)
 #elif RETRO_PLATFORM == RETRO_UWP
@@ -470,6 +544,15 @@ public:
 
     bool showPaletteOverlay = false;
     bool useHQModes         = true;
+    int renderBands         = 1; // threads DrawStageGFX is rasterized on, 0 = one per core (up to DRAWBAND_MAX), 1 = off
+    bool deferredDrawing    = false; // rasterize stage draws on the band threads while the scripts carry on, instead of in between them
+    bool flippedTileset     = true;  // keep pre-flipped copies of the stage tileset, costs 3x the tileset (768KB)
+    bool paletteFade        = false; // fade stages by fading the palettes, frames that draw blended effects still fade every pixel
+    bool cullBackFaces      = false; // skip 3D faces that wind anticlockwise on screen, only safe if every model's faces wind the same way
+
+    int simFrame         = 0;       // logical frames processed since startup
+    int frameLimit       = 0;       // exits after this many logical frames, 0 = no limit
+    FileIO *stateHashLog = nullptr; // gets a state hash per logical frame if set
 #endif
 
     void Init();
@@ -570,4 +653,9 @@ public:
 };
 
 extern RetroEngine Engine;
+
+#if !RETRO_USE_ORIGINAL_CODE
+uint GetEngineStateHash();
+bool OpenStateHashLog(const char *filePath);
+#endif
 #endif // !RETROENGINE_H
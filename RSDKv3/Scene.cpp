@@ -78,6 +78,9 @@ Tiles128x128 tiles128x128;
 CollisionMasks collisionMasks[2];
 
 byte tilesetGFXData[TILESET_SIZE];
+#if RETRO_USE_FLIPPED_TILESET
+byte *flippedTilesetGFXData = NULL;
+#endif
 
 ushort tile3DFloorBuffer[0x13334];
 bool drawStageGFXHQ = false;
@@ -105,6 +108,10 @@ void InitFirstStage()
 
 void ProcessStage(void)
 {
+#if RETRO_USE_SCRIPT_PROFILER
+    NextScriptProfileFrame();
+#endif
+
     switch (stageMode) {
         case STAGEMODE_LOAD: // Startup
 #if RETRO_USING_C2D
@@ -130,8 +137,9 @@ void ProcessStage(void)
             cameraShakeX  = 0;
             cameraShakeY  = 0;
 
-            vertexCount = 0;
-            faceCount   = 0;
+            vertexCount     = 0;
+            faceCount       = 0;
+            drawList3DCount = 0;
             for (int i = 0; i < PLAYER_COUNT; ++i) {
                 MEM_ZERO(playerList[i]);
                 playerList[i].visible            = 1;
@@ -228,7 +236,13 @@ void ProcessStage(void)
 			}
 
             // Update
+#if !RETRO_USE_ORIGINAL_CODE
+            MarkBenchmarkPhase(-1);
+#endif
             ProcessObjects();
+#if !RETRO_USE_ORIGINAL_CODE
+            MarkBenchmarkPhase(BENCHPHASE_OBJECTS);
+#endif
 
             if (cameraTarget > -1) {
                 if (cameraEnabled == 1) {
@@ -245,8 +259,14 @@ void ProcessStage(void)
                     SetPlayerLockedScreenPosition(&playerList[cameraTarget]);
                 }
             }
+#if !RETRO_USE_ORIGINAL_CODE
+            MarkBenchmarkPhase(BENCHPHASE_CAMERA);
+#endif
 
             DrawStageGFX();
+#if !RETRO_USE_ORIGINAL_CODE
+            MarkBenchmarkPhase(BENCHPHASE_DRAW);
+#endif
             break;
         case STAGEMODE_PAUSED:
             drawStageGFXHQ = false;
@@ -480,6 +500,18 @@ void LoadStageFiles(void)
     else {
         printLog("Reloading Scene %s - %s", stageListNames[activeStageList], stageList[activeStageList][stageListPosition].name);
     }
+    DecodeScriptCode();
+#if RETRO_USE_PALETTE_FADE
+    ScanPaletteFadeScripts();
+#endif
+#if RETRO_USE_NATIVE_SCRIPTS
+    LinkNativeScripts();
+#endif
+#if RETRO_USE_SCRIPT_PROFILER
+    LinkScriptProfiles();
+#endif
+    if (exportNativeScripts)
+        ExportNativeScripts();
     LoadStageChunks();
     for (int i = 0; i < TRACK_COUNT; ++i) SetMusicTrack((char *)"", i, 0, 0);
     for (int i = 0; i < ENTITY_COUNT; ++i) {
@@ -510,6 +542,8 @@ void LoadStageFiles(void)
         objectEntityList[i].values[7]      = 0;
     }
     LoadActLayout();
+    InvalidateTileRowCache();
+    RefreshEntitySlots();
     Init3DFloorBuffer(0);
     ProcessStartupObjects();
     xScrollA = (playerList[0].XPos >> 16) - SCREEN_CENTERX;
@@ -1000,8 +1034,22 @@ void LoadStageGIFFile(int stageID)
         }
 
         CloseFile();
+        BuildFlippedTileset();
     }
 }
+void BuildFlippedTileset()
+{
+#if RETRO_USE_FLIPPED_TILESET
+    if (!Engine.flippedTileset || renderType != RENDER_SW)
+        return;
+
+    if (!flippedTilesetGFXData) {
+        flippedTilesetGFXData = new byte[3 * TILESET_SIZE];
+        printLog("Using flipped tileset: %d bytes on top of the %d byte tileset", 3 * TILESET_SIZE, TILESET_SIZE);
+    }
+    for (int t = 0; t < TILE_COUNT; ++t) BuildFlippedTile(t);
+#endif
+}
 void LoadStageGFXFile(int stageID)
 {
     FileInfo info;
@@ -1049,6 +1097,7 @@ void LoadStageGFXFile(int stageID)
         }
 
         CloseFile();
+        BuildFlippedTileset();
     }
 }
 
@@ -1075,6 +1124,7 @@ void ResetBackgroundSettings()
 
 void SetLayerDeformation(int selectedDef, int waveLength, int waveWidth, int waveType, int YPos, int waveSize)
 {
+    FlushDrawCommands();
     int *deformPtr = nullptr;
     switch (selectedDef) {
         case DEFORM_FG: deformPtr = bgDeformationData0; break;
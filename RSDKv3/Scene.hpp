@@ -187,6 +187,10 @@ extern Tiles128x128 tiles128x128;
 extern CollisionMasks collisionMasks[2];
 
 extern byte tilesetGFXData[TILESET_SIZE];
+#if RETRO_USE_FLIPPED_TILESET
+// FLIP_X, FLIP_Y & FLIP_XY copies of tilesetGFXData one after another, NULL if they aren't being kept
+extern byte *flippedTilesetGFXData;
+#endif
 
 extern ushort tile3DFloorBuffer[0x13334];
 extern bool drawStageGFXHQ;
@@ -217,6 +221,28 @@ void LoadStageChunks();
 void LoadStageCollisions();
 void LoadStageGIFFile(int stageID);
 void LoadStageGFXFile(int stageID);
+void BuildFlippedTileset();
+
+// Refreshes the flipped copies of one tile after it's been written to
+inline void BuildFlippedTile(int tile)
+{
+#if RETRO_USE_FLIPPED_TILESET
+    if (!flippedTilesetGFXData)
+        return;
+    byte *srcPtr    = &tilesetGFXData[TILE_DATASIZE * tile];
+    byte *flipXPtr  = &flippedTilesetGFXData[TILE_DATASIZE * tile];
+    byte *flipYPtr  = flipXPtr + TILESET_SIZE;
+    byte *flipXYPtr = flipYPtr + TILESET_SIZE;
+    for (int y = 0; y < TILE_SIZE; ++y) {
+        for (int x = 0; x < TILE_SIZE; ++x) {
+            byte index                                   = srcPtr[TILE_SIZE * y + x];
+            flipXPtr[TILE_SIZE * y + (0xF - x)]          = index;
+            flipYPtr[TILE_SIZE * (0xF - y) + x]          = index;
+            flipXYPtr[TILE_SIZE * (0xF - y) + (0xF - x)] = index;
+        }
+    }
+#endif
+}
 
 inline void Init3DFloorBuffer(int layerID)
 {
@@ -231,10 +257,13 @@ inline void Init3DFloorBuffer(int layerID)
 
 inline void Copy16x16Tile(ushort dest, ushort src)
 {
+    FlushDrawCommands(); // queued layer draws may still be reading the tileset
+    InvalidateTileRowCache();
     byte *destPtr = &tilesetGFXData[TILELAYER_CHUNK_W * dest];
     byte *srcPtr  = &tilesetGFXData[TILELAYER_CHUNK_W * src];
     int cnt       = TILE_DATASIZE;
     while (cnt--) *destPtr++ = *srcPtr++;
+    BuildFlippedTile(dest);
 }
 
 void SetLayerDeformation(int selectedDef, int waveLength, int waveType, int deformType, int YPos, int waveSize);
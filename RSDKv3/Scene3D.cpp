@@ -13,10 +13,15 @@ Vertex vertexBuffer[VERTEXBUFFER_SIZE];
 Vertex vertexBufferT[VERTEXBUFFER_SIZE];
 
 DrawListEntry3D drawList3D[FACEBUFFER_SIZE];
+DrawListEntry3D drawList3DBuffer[FACEBUFFER_SIZE]; // Sort3DDrawList's scratch list
+int drawList3DCount = 0;
 
 int projectionX = 136;
 int projectionY = 160;
 
+int vertexScreenX[VERTEXBUFFER_SIZE];
+int vertexScreenY[VERTEXBUFFER_SIZE];
+
 int faceLineStart[SCREEN_YSIZE];
 int faceLineEnd[SCREEN_YSIZE];
 int faceLineStartU[SCREEN_YSIZE];
@@ -24,7 +29,7 @@ int faceLineEndU[SCREEN_YSIZE];
 int faceLineStartV[SCREEN_YSIZE];
 int faceLineEndV[SCREEN_YSIZE];
 
-void setIdentityMatrix(Matrix *matrix)
+void SetIdentityMatrix(Matrix *matrix)
 {
     matrix->values[0][0] = 0x100;
     matrix->values[0][1] = 0;
@@ -43,7 +48,7 @@ void setIdentityMatrix(Matrix *matrix)
     matrix->values[3][2] = 0;
     matrix->values[3][3] = 0x100;
 }
-void matrixMultiply(Matrix *matrixA, Matrix *matrixB)
+void MatrixMultiply(Matrix *matrixA, Matrix *matrixB)
 {
     int output[16];
 
@@ -56,7 +61,7 @@ void matrixMultiply(Matrix *matrixA, Matrix *matrixB)
 
     for (int i = 0; i < 0x10; ++i) matrixA->values[i / 4][i % 4] = output[i];
 }
-void matrixTranslateXYZ(Matrix *matrix, int XPos, int YPos, int ZPos)
+void MatrixTranslateXYZ(Matrix *matrix, int XPos, int YPos, int ZPos)
 {
     matrix->values[0][0] = 0x100;
     matrix->values[0][1] = 0;
@@ -75,7 +80,7 @@ void matrixTranslateXYZ(Matrix *matrix, int XPos, int YPos, int ZPos)
     matrix->values[3][2] = ZPos;
     matrix->values[3][3] = 0x100;
 }
-void matrixScaleXYZ(Matrix *matrix, int scaleX, int scaleY, int scaleZ)
+void MatrixScaleXYZ(Matrix *matrix, int scaleX, int scaleY, int scaleZ)
 {
     matrix->values[0][0] = scaleX;
     matrix->values[0][1] = 0;
@@ -94,13 +99,13 @@ void matrixScaleXYZ(Matrix *matrix, int scaleX, int scaleY, int scaleZ)
     matrix->values[3][2] = 0;
     matrix->values[3][3] = 0x100;
 }
-void matrixRotateX(Matrix *matrix, int rotationX)
+void MatrixRotateX(Matrix *matrix, int rotationX)
 {
     if (rotationX < 0)
         rotationX = 0x200 - rotationX;
     rotationX &= 0x1FF;
-    int sine             = sinVal512[rotationX] >> 1;
-    int cosine           = cosVal512[rotationX] >> 1;
+    int sine             = sin512LookupTable[rotationX] >> 1;
+    int cosine           = cos512LookupTable[rotationX] >> 1;
     matrix->values[0][0] = 0x100;
     matrix->values[0][1] = 0;
     matrix->values[0][2] = 0;
@@ -118,13 +123,13 @@ void matrixRotateX(Matrix *matrix, int rotationX)
     matrix->values[3][2] = 0;
     matrix->values[3][3] = 0x100;
 }
-void matrixRotateY(Matrix *matrix, int rotationY)
+void MatrixRotateY(Matrix *matrix, int rotationY)
 {
     if (rotationY < 0)
         rotationY = 0x200 - rotationY;
     rotationY &= 0x1FF;
-    int sine             = sinVal512[rotationY] >> 1;
-    int cosine           = cosVal512[rotationY] >> 1;
+    int sine             = sin512LookupTable[rotationY] >> 1;
+    int cosine           = cos512LookupTable[rotationY] >> 1;
     matrix->values[0][0] = cosine;
     matrix->values[0][1] = 0;
     matrix->values[0][2] = sine;
@@ -142,13 +147,13 @@ void matrixRotateY(Matrix *matrix, int rotationY)
     matrix->values[3][2] = 0;
     matrix->values[3][3] = 0x100;
 }
-void matrixRotateZ(Matrix *matrix, int rotationZ)
+void MatrixRotateZ(Matrix *matrix, int rotationZ)
 {
     if (rotationZ < 0)
         rotationZ = 0x200 - rotationZ;
     rotationZ &= 0x1FF;
-    int sine            = sinVal512[rotationZ] >> 1;
-    int cosine          = cosVal512[rotationZ] >> 1;
+    int sine            = sin512LookupTable[rotationZ] >> 1;
+    int cosine          = cos512LookupTable[rotationZ] >> 1;
     matrix->values[0][0] = cosine;
     matrix->values[0][1] = 0;
     matrix->values[0][2] = sine;
@@ -166,7 +171,7 @@ void matrixRotateZ(Matrix *matrix, int rotationZ)
     matrix->values[3][2] = 0;
     matrix->values[3][3] = 0x100;
 }
-void matrixRotateXYZ(Matrix *matrix, int rotationX, int rotationY, int rotationZ)
+void MatrixRotateXYZ(Matrix *matrix, int rotationX, int rotationY, int rotationZ)
 {
     if (rotationX < 0)
         rotationX = 0x200 - rotationX;
@@ -177,12 +182,12 @@ void matrixRotateXYZ(Matrix *matrix, int rotationX, int rotationY, int rotationZ
     if (rotationZ < 0)
         rotationZ = 0x200 - rotationZ;
     rotationZ &= 0x1FF;
-    int sineX   = sinVal512[rotationX] >> 1;
-    int cosineX = cosVal512[rotationX] >> 1;
-    int sineY   = sinVal512[rotationY] >> 1;
-    int cosineY = cosVal512[rotationY] >> 1;
-    int sineZ   = sinVal512[rotationZ] >> 1;
-    int cosineZ = cosVal512[rotationZ] >> 1;
+    int sineX   = sin512LookupTable[rotationX] >> 1;
+    int cosineX = cos512LookupTable[rotationX] >> 1;
+    int sineY   = sin512LookupTable[rotationY] >> 1;
+    int cosineY = cos512LookupTable[rotationY] >> 1;
+    int sineZ   = sin512LookupTable[rotationZ] >> 1;
+    int cosineZ = cos512LookupTable[rotationZ] >> 1;
 
     matrix->values[0][0] = (sineZ * (sineY * sineX >> 8) >> 8) + (cosineZ * cosineY >> 8);
     matrix->values[0][1] = (sineZ * cosineY >> 8) - (cosineZ * (sineY * sineX >> 8) >> 8);
@@ -201,72 +206,278 @@ void matrixRotateXYZ(Matrix *matrix, int rotationX, int rotationY, int rotationZ
     matrix->values[3][2] = 0;
     matrix->values[3][3] = 0x100;
 }
-void transformVertexBuffer()
+#if RETRO_USING_SSE2
+// 32 bit multiply keeping the low half of each product, SSE2 only has one for the even lanes
+static inline __m128i MultiplyInts(__m128i a, __m128i b)
+{
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
+// a * b >> 8, the product wrapping like the vector multiplies' do (which is what the int maths always did, it just wasn't defined)
+static inline int FixedMultiply(int a, int b) { return (int)((uint)a * (uint)b) >> 8; }
+
+// TransformVertexList without the vector paths, the self check compares them against it
+static void TransformVertexListScalar(Matrix *matrix, Vertex *src, Vertex *dst, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        int vx   = src[i].x;
+        int vy   = src[i].y;
+        int vz   = src[i].z;
+        dst[i].x = FixedMultiply(vx, matrix->values[0][0]) + FixedMultiply(vy, matrix->values[1][0]) + FixedMultiply(vz, matrix->values[2][0])
+                   + matrix->values[3][0];
+        dst[i].y = FixedMultiply(vx, matrix->values[0][1]) + FixedMultiply(vy, matrix->values[1][1]) + FixedMultiply(vz, matrix->values[2][1])
+                   + matrix->values[3][1];
+        dst[i].z = FixedMultiply(vx, matrix->values[0][2]) + FixedMultiply(vy, matrix->values[1][2]) + FixedMultiply(vz, matrix->values[2][2])
+                   + matrix->values[3][2];
+    }
+}
+
+// Transforms count verts from src into dst (which can be the same list), leaving u & v alone
+// Every product is shifted down on its own before they're summed, so the vector paths round exactly like the scalar one
+static void TransformVertexList(Matrix *matrix, Vertex *src, Vertex *dst, int count)
+{
+#if RETRO_USING_SSE2
+    // a vert's x, y & z go through as one vector, the 4th lane being u which gets put back
+    __m128i row0  = _mm_setr_epi32(matrix->values[0][0], matrix->values[0][1], matrix->values[0][2], 0);
+    __m128i row1  = _mm_setr_epi32(matrix->values[1][0], matrix->values[1][1], matrix->values[1][2], 0);
+    __m128i row2  = _mm_setr_epi32(matrix->values[2][0], matrix->values[2][1], matrix->values[2][2], 0);
+    __m128i row3  = _mm_setr_epi32(matrix->values[3][0], matrix->values[3][1], matrix->values[3][2], 0);
+    __m128i uLane = _mm_setr_epi32(0, 0, 0, -1);
+    for (int i = 0; i < count; ++i) {
+        __m128i vert = _mm_loadu_si128((__m128i *)&src[i]);
+        __m128i x    = _mm_srai_epi32(MultiplyInts(_mm_shuffle_epi32(vert, _MM_SHUFFLE(0, 0, 0, 0)), row0), 8);
+        __m128i y    = _mm_srai_epi32(MultiplyInts(_mm_shuffle_epi32(vert, _MM_SHUFFLE(1, 1, 1, 1)), row1), 8);
+        __m128i z    = _mm_srai_epi32(MultiplyInts(_mm_shuffle_epi32(vert, _MM_SHUFFLE(2, 2, 2, 2)), row2), 8);
+        __m128i out  = _mm_add_epi32(_mm_add_epi32(x, y), _mm_add_epi32(z, row3));
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_or_si128(out, _mm_and_si128(_mm_loadu_si128((__m128i *)&dst[i]), uLane)));
+    }
+#elif RETRO_USING_NEON
+    int32x4_t row0 = { matrix->values[0][0], matrix->values[0][1], matrix->values[0][2], 0 };
+    int32x4_t row1 = { matrix->values[1][0], matrix->values[1][1], matrix->values[1][2], 0 };
+    int32x4_t row2 = { matrix->values[2][0], matrix->values[2][1], matrix->values[2][2], 0 };
+    int32x4_t row3 = { matrix->values[3][0], matrix->values[3][1], matrix->values[3][2], 0 };
+    for (int i = 0; i < count; ++i) {
+        int32x4_t x   = vshrq_n_s32(vmulq_s32(vdupq_n_s32(src[i].x), row0), 8);
+        int32x4_t y   = vshrq_n_s32(vmulq_s32(vdupq_n_s32(src[i].y), row1), 8);
+        int32x4_t z   = vshrq_n_s32(vmulq_s32(vdupq_n_s32(src[i].z), row2), 8);
+        int32x4_t out = vaddq_s32(vaddq_s32(x, y), vaddq_s32(z, row3));
+        vst1q_s32(&dst[i].x, vsetq_lane_s32(dst[i].u, out, 3));
+    }
+#else
+    TransformVertexListScalar(matrix, src, dst, count);
+#endif
+}
+
+void TransformVertexBuffer()
 {
     for (int y = 0; y < 4; ++y) {
         for (int x = 0; x < 4; ++x) {
             matFinal.values[y][x] = matWorld.values[y][x];
         }
     }
-    matrixMultiply(&matFinal, &matView);
+    MatrixMultiply(&matFinal, &matView);
 
     if (vertexCount <= 0)
         return;
 
-    int inVertexID  = 0;
-    int outVertexID = 0;
-    do {
-        int vx       = vertexBuffer[inVertexID].x;
-        int vy       = vertexBuffer[inVertexID].y;
-        int vz       = vertexBuffer[inVertexID].z;
-        Vertex *vert = &vertexBufferT[inVertexID++];
-
-        vert->x = (vx * matFinal.values[0][0] >> 8) + (vy * matFinal.values[1][0] >> 8) + (vz * matFinal.values[2][0] >> 8) + matFinal.values[3][0];
-        vert->y = (vx * matFinal.values[0][1] >> 8) + (vy * matFinal.values[1][1] >> 8) + (vz * matFinal.values[2][1] >> 8) + matFinal.values[3][1];
-        vert->z = (vx * matFinal.values[0][2] >> 8) + (vy * matFinal.values[1][2] >> 8) + (vz * matFinal.values[2][2] >> 8) + matFinal.values[3][2];
-    } while (++outVertexID != vertexCount);
+    TransformVertexList(&matFinal, vertexBuffer, vertexBufferT, vertexCount);
 }
-void transformVerticies(Matrix *matrix, int startIndex, int endIndex)
+void TransformVerticies(Matrix *matrix, int startIndex, int endIndex)
 {
     if (startIndex > endIndex)
         return;
 
-    do {
-        int vx       = vertexBuffer[startIndex].x;
-        int vy       = vertexBuffer[startIndex].y;
-        int vz       = vertexBuffer[startIndex].z;
-        Vertex *vert = &vertexBuffer[startIndex];
-        vert->x      = (vx * matrix->values[0][0] >> 8) + (vy * matrix->values[1][0] >> 8) + (vz * matrix->values[2][0] >> 8) + matrix->values[3][0];
-        vert->y      = (vx * matrix->values[0][1] >> 8) + (vy * matrix->values[1][1] >> 8) + (vz * matrix->values[2][1] >> 8) + matrix->values[3][1];
-        vert->z      = (vx * matrix->values[0][2] >> 8) + (vy * matrix->values[1][2] >> 8) + (vz * matrix->values[2][2] >> 8) + matrix->values[3][2];
-    } while (++startIndex < endIndex);
+    // startIndex == endIndex still does that one vert
+    int count = endIndex > startIndex ? endIndex - startIndex : 1;
+    TransformVertexList(matrix, &vertexBuffer[startIndex], &vertexBuffer[startIndex], count);
 }
-void sort3DDrawList()
+// ProjectVertexList without the vector paths, the self check compares them against it
+static void ProjectVertexListScalar(Vertex *verts, int count, int *screenX, int *screenY)
 {
-    for (int i = 0; i < faceCount; ++i) {
-        drawList3D[i].depth = (vertexBufferT[faceBuffer[i].d].z + vertexBufferT[faceBuffer[i].c].z + vertexBufferT[faceBuffer[i].b].z
-                               + vertexBufferT[faceBuffer[i].a].z)
-                              >> 2;
-        drawList3D[i].faceID = i;
+    for (int i = 0; i < count; ++i) {
+        Vertex *vert = &verts[i];
+        if (vert->z <= 0x100)
+            continue;
+        screenX[i] = SCREEN_CENTERX + (int)((uint)projectionX * (uint)vert->x) / vert->z;
+        screenY[i] = SCREEN_CENTERY - (int)((uint)projectionY * (uint)vert->y) / vert->z;
+    }
+}
+
+// Projects count verts onto the screen, verts at or behind z 0x100 are left alone (no face using them gets drawn)
+static void ProjectVertexList(Vertex *verts, int count, int *screenX, int *screenY)
+{
+#if RETRO_USING_SSE2
+    // x * projectionX & y * projectionY wrap like the int maths does, then both are divided by z together as doubles,
+    // which always truncates to the same quotient an int divide gives
+    __m128i projection = _mm_setr_epi32(projectionX, 0, projectionY, 0);
+    for (int i = 0; i < count; ++i) {
+        Vertex *vert = &verts[i];
+        if (vert->z <= 0x100)
+            continue;
+        __m128i pos      = _mm_mul_epu32(_mm_setr_epi32(vert->x, 0, vert->y, 0), projection);
+        __m128i quotient = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(pos, _MM_SHUFFLE(3, 1, 2, 0))), _mm_set1_pd(vert->z)));
+        screenX[i]       = SCREEN_CENTERX + _mm_cvtsi128_si32(quotient);
+        screenY[i]       = SCREEN_CENTERY - _mm_cvtsi128_si32(_mm_shuffle_epi32(quotient, _MM_SHUFFLE(1, 1, 1, 1)));
     }
+#elif RETRO_USING_NEON && defined(__aarch64__)
+    int32x2_t projection = { projectionX, projectionY };
+    for (int i = 0; i < count; ++i) {
+        Vertex *vert = &verts[i];
+        if (vert->z <= 0x100)
+            continue;
+        int32x2_t pos       = vmul_s32(vld1_s32(&vert->x), projection);
+        float64x2_t divided = vdivq_f64(vcvtq_f64_s64(vmovl_s32(pos)), vdupq_n_f64(vert->z));
+        int32x2_t quotient  = vmovn_s64(vcvtq_s64_f64(divided));
+        screenX[i]          = SCREEN_CENTERX + vget_lane_s32(quotient, 0);
+        screenY[i]          = SCREEN_CENTERY - vget_lane_s32(quotient, 1);
+    }
+#else
+    ProjectVertexListScalar(verts, count, screenX, screenY);
+#endif
+}
+
+// Projects every transformed vert in front of the camera onto the screen once, instead of once for every face that uses it
+void ProjectVertexBuffer() { ProjectVertexList(vertexBufferT, vertexCount, vertexScreenX, vertexScreenY); }
+
+// The same tests DrawFace & DrawTexturedFace use to skip a quad that wouldn't draw anything
+static bool FaceOnScreen(int *x, int *y)
+{
+    if (x[0] < 0 && x[1] < 0 && x[2] < 0 && x[3] < 0)
+        return false;
+    if (x[0] > SCREEN_XSIZE && x[1] > SCREEN_XSIZE && x[2] > SCREEN_XSIZE && x[3] > SCREEN_XSIZE)
+        return false;
+    if (y[0] < 0 && y[1] < 0 && y[2] < 0 && y[3] < 0)
+        return false;
+    if (y[0] > SCREEN_YSIZE && y[1] > SCREEN_YSIZE && y[2] > SCREEN_YSIZE && y[3] > SCREEN_YSIZE)
+        return false;
+    if (x[0] == x[1] && x[1] == x[2] && x[2] == x[3])
+        return false;
+    if (y[0] == y[1] && y[1] == y[2] && y[2] == y[3])
+        return false;
+    return true;
+}
 
+// Fills drawList3D with just the faces that will draw something, so sorting & drawing skip the rest
+// Faces only get dropped for reasons Draw3DScene or the face drawing would've skipped them anyway, so the frame comes out the same,
+// besides 3D faces whose corners go anticlockwise on screen when Engine.cullBackFaces is on
+void Cull3DDrawList()
+{
+    ProjectVertexBuffer();
+
+    drawList3DCount = 0;
+#if !RETRO_USE_3D_FACE_CULL
+    for (int i = 0; i < faceCount; ++i) drawList3D[drawList3DCount++].faceID = i;
+    return;
+#endif
     for (int i = 0; i < faceCount; ++i) {
-        for (int j = faceCount - 1; j > i; --j) {
-            if (drawList3D[j].depth > drawList3D[j - 1].depth) {
-                int faceID               = drawList3D[j].faceID;
-                int depth                = drawList3D[j].depth;
-                drawList3D[j].faceID     = drawList3D[j - 1].faceID;
-                drawList3D[j].depth      = drawList3D[j - 1].depth;
-                drawList3D[j - 1].faceID = faceID;
-                drawList3D[j - 1].depth  = depth;
-            }
+        Face *face  = &faceBuffer[i];
+        bool face3D = face->flags == FACE_FLAG_TEXTURED_3D || face->flags == FACE_FLAG_COLOURED_3D;
+        int x[4];
+        int y[4];
+        switch (face->flags) {
+            default: continue;
+            case FACE_FLAG_TEXTURED_3D:
+            case FACE_FLAG_COLOURED_3D:
+                if (vertexBufferT[face->a].z <= 0x100 || vertexBufferT[face->b].z <= 0x100 || vertexBufferT[face->c].z <= 0x100
+                    || vertexBufferT[face->d].z <= 0x100)
+                    continue;
+                x[0] = vertexScreenX[face->a];
+                y[0] = vertexScreenY[face->a];
+                x[1] = vertexScreenX[face->b];
+                y[1] = vertexScreenY[face->b];
+                x[2] = vertexScreenX[face->c];
+                y[2] = vertexScreenY[face->c];
+                x[3] = vertexScreenX[face->d];
+                y[3] = vertexScreenY[face->d];
+                break;
+            case FACE_FLAG_TEXTURED_2D:
+            case FACE_FLAG_COLOURED_2D:
+                x[0] = vertexBuffer[face->a].x;
+                y[0] = vertexBuffer[face->a].y;
+                x[1] = vertexBuffer[face->b].x;
+                y[1] = vertexBuffer[face->b].y;
+                x[2] = vertexBuffer[face->c].x;
+                y[2] = vertexBuffer[face->c].y;
+                x[3] = vertexBuffer[face->d].x;
+                y[3] = vertexBuffer[face->d].y;
+                break;
+        }
+
+        if ((face->flags == FACE_FLAG_COLOURED_3D || face->flags == FACE_FLAG_COLOURED_2D) && ((face->colour & 0x7F000000) >> 23) < 1)
+            continue; // fully transparent
+        if (!FaceOnScreen(x, y))
+            continue;
+        if (face3D && Engine.cullBackFaces) {
+            // twice the quad's signed area, positive when it goes clockwise on screen (y points down)
+            long long area = 0;
+            for (int c = 0; c < 4; ++c) area += (long long)x[c] * y[(c + 1) & 3] - (long long)x[(c + 1) & 3] * y[c];
+            if (area < 0)
+                continue;
         }
+        drawList3D[drawList3DCount++].faceID = i;
     }
+
+#if RETRO_USE_SCRIPT_PROFILER
+    scriptProfileFacesDrawn += drawList3DCount;
+    scriptProfileFacesCulled += faceCount - drawList3DCount;
+#endif
+}
+
+void Sort3DDrawList()
+{
+    Cull3DDrawList();
+    for (int i = 0; i < drawList3DCount; ++i) {
+        Face *face          = &faceBuffer[drawList3D[i].faceID];
+        drawList3D[i].depth = (vertexBufferT[face->d].z + vertexBufferT[face->c].z + vertexBufferT[face->b].z + vertexBufferT[face->a].z) >> 2;
+    }
+
+    RadixSort3DDrawList(drawList3D, drawList3DBuffer, drawList3DCount);
 }
-void draw3DScene(int spriteSheetID)
+
+// Stable radix sort a byte at a time, furthest first with ties kept in list order (same as the bubble sort Sort3DDrawList used to do)
+// Flipping every bit but the sign one makes the unsigned order of the keys the descending order of the depths. buffer is scratch space
+void RadixSort3DDrawList(DrawListEntry3D *list, DrawListEntry3D *buffer, int count)
+{
+    if (count <= 0)
+        return;
+
+    DrawListEntry3D *src = list;
+    DrawListEntry3D *dst = buffer;
+    for (int shift = 0; shift < 32; shift += 8) {
+        int offsets[0x100];
+        memset(offsets, 0, sizeof(offsets));
+        for (int i = 0; i < count; ++i) ++offsets[((uint)src[i].depth ^ 0x7FFFFFFF) >> shift & 0xFF];
+        if (offsets[((uint)src[0].depth ^ 0x7FFFFFFF) >> shift & 0xFF] == count)
+            continue; // every face has the same byte here, usually the top ones
+
+        int pos = 0;
+        for (int b = 0; b < 0x100; ++b) {
+            int size   = offsets[b];
+            offsets[b] = pos;
+            pos += size;
+        }
+        for (int i = 0; i < count; ++i) dst[offsets[((uint)src[i].depth ^ 0x7FFFFFFF) >> shift & 0xFF]++] = src[i];
+
+        DrawListEntry3D *temp = src;
+        src                   = dst;
+        dst                   = temp;
+    }
+    if (src != list)
+        memcpy(list, src, count * sizeof(DrawListEntry3D));
+}
+// Draws the faces the last Sort3DDrawList call kept, using the screen positions it projected
+// Only Draw3DScene calls this, straight after transforming & sorting, so the list & positions are always for the current faces,
+// but a list left over from before faceCount shrank still never reaches past the faces that exist
+void Draw3DScene(int spriteSheetID)
 {
     Vertex quad[4];
-    for (int i = 0; i < faceCount; ++i) {
+    int count = drawList3DCount < faceCount ? drawList3DCount : faceCount;
+    for (int i = 0; i < count; ++i) {
+        if (drawList3D[i].faceID >= faceCount)
+            continue;
         Face *face = &faceBuffer[drawList3D[i].faceID];
         memset(quad, 0, 4 * sizeof(Vertex));
         switch (face->flags) {
@@ -274,14 +485,14 @@ void draw3DScene(int spriteSheetID)
             case FACE_FLAG_TEXTURED_3D:
                 if (vertexBufferT[face->a].z > 0x100 && vertexBufferT[face->b].z > 0x100 && vertexBufferT[face->c].z > 0x100
                     && vertexBufferT[face->d].z > 0x100) {
-                    quad[0].x = SCREEN_CENTERX + projectionX * vertexBufferT[face->a].x / vertexBufferT[face->a].z;
-                    quad[0].y = SCREEN_CENTERY - projectionY * vertexBufferT[face->a].y / vertexBufferT[face->a].z;
-                    quad[1].x = SCREEN_CENTERX + projectionX * vertexBufferT[face->b].x / vertexBufferT[face->b].z;
-                    quad[1].y = SCREEN_CENTERY - projectionY * vertexBufferT[face->b].y / vertexBufferT[face->b].z;
-                    quad[2].x = SCREEN_CENTERX + projectionX * vertexBufferT[face->c].x / vertexBufferT[face->c].z;
-                    quad[2].y = SCREEN_CENTERY - projectionY * vertexBufferT[face->c].y / vertexBufferT[face->c].z;
-                    quad[3].x = SCREEN_CENTERX + projectionX * vertexBufferT[face->d].x / vertexBufferT[face->d].z;
-                    quad[3].y = SCREEN_CENTERY - projectionY * vertexBufferT[face->d].y / vertexBufferT[face->d].z;
+                    quad[0].x = vertexScreenX[face->a];
+                    quad[0].y = vertexScreenY[face->a];
+                    quad[1].x = vertexScreenX[face->b];
+                    quad[1].y = vertexScreenY[face->b];
+                    quad[2].x = vertexScreenX[face->c];
+                    quad[2].y = vertexScreenY[face->c];
+                    quad[3].x = vertexScreenX[face->d];
+                    quad[3].y = vertexScreenY[face->d];
                     quad[0].u = vertexBuffer[face->a].u;
                     quad[0].v = vertexBuffer[face->a].v;
                     quad[1].u = vertexBuffer[face->b].u;
@@ -315,14 +526,14 @@ void draw3DScene(int spriteSheetID)
             case FACE_FLAG_COLOURED_3D:
                 if (vertexBufferT[face->a].z > 0x100 && vertexBufferT[face->b].z > 0x100 && vertexBufferT[face->c].z > 0x100
                     && vertexBufferT[face->d].z > 0x100) {
-                    quad[0].x = SCREEN_CENTERX + projectionX * vertexBufferT[face->a].x / vertexBufferT[face->a].z;
-                    quad[0].y = SCREEN_CENTERY - projectionY * vertexBufferT[face->a].y / vertexBufferT[face->a].z;
-                    quad[1].x = SCREEN_CENTERX + projectionX * vertexBufferT[face->b].x / vertexBufferT[face->b].z;
-                    quad[1].y = SCREEN_CENTERY - projectionY * vertexBufferT[face->b].y / vertexBufferT[face->b].z;
-                    quad[2].x = SCREEN_CENTERX + projectionX * vertexBufferT[face->c].x / vertexBufferT[face->c].z;
-                    quad[2].y = SCREEN_CENTERY - projectionY * vertexBufferT[face->c].y / vertexBufferT[face->c].z;
-                    quad[3].x = SCREEN_CENTERX + projectionX * vertexBufferT[face->d].x / vertexBufferT[face->d].z;
-                    quad[3].y = SCREEN_CENTERY - projectionY * vertexBufferT[face->d].y / vertexBufferT[face->d].z;
+                    quad[0].x = vertexScreenX[face->a];
+                    quad[0].y = vertexScreenY[face->a];
+                    quad[1].x = vertexScreenX[face->b];
+                    quad[1].y = vertexScreenY[face->b];
+                    quad[2].x = vertexScreenX[face->c];
+                    quad[2].y = vertexScreenY[face->c];
+                    quad[3].x = vertexScreenX[face->d];
+                    quad[3].y = vertexScreenY[face->d];
                     DrawFace(quad, face->colour);
                 }
                 break;
@@ -341,7 +552,7 @@ void draw3DScene(int spriteSheetID)
     }
 }
 
-void processScanEdge(Vertex *vertA, Vertex *vertB)
+void ProcessScanEdge(Vertex *vertA, Vertex *vertB)
 {
     int bottom, top;
     int fullX, fullY;
@@ -377,7 +588,7 @@ void processScanEdge(Vertex *vertA, Vertex *vertB)
         fullX += fullY;
     }
 }
-void processScanEdgeUV(Vertex *vertA, Vertex *vertB)
+void ProcessScanEdgeUV(Vertex *vertA, Vertex *vertB)
 {
     int bottom, top;
     int fullX, fullU, fullV;
@@ -436,3 +647,181 @@ void processScanEdgeUV(Vertex *vertA, Vertex *vertB)
         fullV += trueV;
     }
 }
+
+#if !RETRO_USE_ORIGINAL_CODE
+// Self checks (see RunSelfCheck)
+#define SORTCHECK_COUNT (0x400)
+#define SORTBENCH_RUNS  (0x40)
+
+DrawListEntry3D sortCheckLists[3][FACEBUFFER_SIZE];
+
+// The bubble sort Sort3DDrawList used before the radix sort, as the reference order
+static void BubbleSort3DDrawList(DrawListEntry3D *list, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        for (int j = count - 1; j > i; --j) {
+            if (list[j].depth > list[j - 1].depth) {
+                DrawListEntry3D entry = list[j];
+                list[j]               = list[j - 1];
+                list[j - 1]           = entry;
+            }
+        }
+    }
+}
+
+// count random depths into both of the first two lists: a few repeated ones, stage-like 16 bit ones, or anything an int holds
+static void SetupSortCheck(int count)
+{
+    int range = SelfCheckRandom() % 3;
+    for (int i = 0; i < count; ++i) {
+        int depth = SelfCheckRandom();
+        if (range == 0)
+            depth &= 0xF;
+        else if (range == 1)
+            depth = (depth & 0xFFFF) - 0x100;
+        sortCheckLists[0][i].faceID = i;
+        sortCheckLists[0][i].depth  = depth;
+        sortCheckLists[1][i]        = sortCheckLists[0][i];
+    }
+}
+
+int Check3DDrawListSort()
+{
+    int failures = 0;
+    for (int c = 0; c < SORTCHECK_COUNT; ++c) {
+        int count = SelfCheckRandom() % (FACEBUFFER_SIZE + 1);
+        SetupSortCheck(count);
+        RadixSort3DDrawList(sortCheckLists[0], sortCheckLists[2], count);
+        BubbleSort3DDrawList(sortCheckLists[1], count);
+        if (memcmp(sortCheckLists[0], sortCheckLists[1], count * sizeof(DrawListEntry3D)))
+            ++failures;
+    }
+    ReportSelfCheck("3D draw list radix sort", failures, SORTCHECK_COUNT);
+    return failures;
+}
+
+#define TRANSFORMCHECK_COUNT (0x400)
+#define TRANSFORMCHECK_SIZE  (0x100)
+
+Vertex transformCheckVerts[3][TRANSFORMCHECK_SIZE];
+int transformCheckScreen[4][TRANSFORMCHECK_SIZE];
+
+// small values like a model's verts or a rotation, stage-sized ones whose products can overflow, or any int at all
+static int GetTransformCheckValue(int range)
+{
+    int value = SelfCheckRandom();
+    if (range == 0)
+        return (value & 0x3FF) - 0x200;
+    else if (range == 1)
+        return (value & 0xFFFFF) - 0x80000;
+    return value;
+}
+
+static bool CompareVerts(Vertex *a, Vertex *b) { return !memcmp(a, b, TRANSFORMCHECK_SIZE * sizeof(Vertex)); }
+
+// TransformVertexList against TransformVertexListScalar on random matrices, into another list (like TransformVertexBuffer) & in place
+// (like TransformVerticies). u & v are random too, both have to leave them alone
+int Check3DTransform()
+{
+    int failures = 0;
+    for (int c = 0; c < TRANSFORMCHECK_COUNT; ++c) {
+        Matrix matrix;
+        int matrixRange = SelfCheckRandom() % 3;
+        int vertRange   = SelfCheckRandom() % 3;
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) matrix.values[y][x] = GetTransformCheckValue(matrixRange);
+        }
+        int count = SelfCheckRandom() % (TRANSFORMCHECK_SIZE + 1);
+
+        for (int i = 0; i < TRANSFORMCHECK_SIZE; ++i) {
+            Vertex *vert = &transformCheckVerts[0][i];
+            vert->x      = GetTransformCheckValue(vertRange);
+            vert->y      = GetTransformCheckValue(vertRange);
+            vert->z      = GetTransformCheckValue(vertRange);
+            vert->u      = SelfCheckRandom();
+            vert->v      = SelfCheckRandom();
+            // what's in dst already, only u & v of it should be left
+            transformCheckVerts[1][i] = transformCheckVerts[0][(i + 1) % TRANSFORMCHECK_SIZE];
+            transformCheckVerts[2][i] = transformCheckVerts[1][i];
+        }
+        TransformVertexList(&matrix, transformCheckVerts[0], transformCheckVerts[1], count);
+        TransformVertexListScalar(&matrix, transformCheckVerts[0], transformCheckVerts[2], count);
+        bool matched = CompareVerts(transformCheckVerts[1], transformCheckVerts[2]);
+
+        memcpy(transformCheckVerts[1], transformCheckVerts[0], sizeof(transformCheckVerts[0]));
+        memcpy(transformCheckVerts[2], transformCheckVerts[0], sizeof(transformCheckVerts[0]));
+        TransformVertexList(&matrix, transformCheckVerts[1], transformCheckVerts[1], count);
+        TransformVertexListScalar(&matrix, transformCheckVerts[2], transformCheckVerts[2], count);
+        if (!matched || !CompareVerts(transformCheckVerts[1], transformCheckVerts[2]))
+            ++failures;
+    }
+    ReportSelfCheck("3D vertex transform", failures, TRANSFORMCHECK_COUNT);
+    return failures;
+}
+
+// ProjectVertexList's double divides against ProjectVertexListScalar's int divides. The projection values get the same ranges as
+// the verts, so x * projectionX wraps in a good share of the cases, and some verts are behind z 0x100 so must be left alone
+int Check3DProjection()
+{
+    int storeProjectionX = projectionX;
+    int storeProjectionY = projectionY;
+    int failures         = 0;
+    for (int c = 0; c < TRANSFORMCHECK_COUNT; ++c) {
+        int range   = SelfCheckRandom() % 3;
+        projectionX = GetTransformCheckValue(range);
+        projectionY = GetTransformCheckValue(range);
+        int count   = SelfCheckRandom() % (TRANSFORMCHECK_SIZE + 1);
+
+        for (int i = 0; i < TRANSFORMCHECK_SIZE; ++i) {
+            Vertex *vert = &transformCheckVerts[0][i];
+            vert->x      = GetTransformCheckValue(range);
+            vert->y      = GetTransformCheckValue(range);
+            if (!(SelfCheckRandom() & 7))
+                vert->z = (int)(SelfCheckRandom() & 0x1FF) - 0xFF;
+            else
+                vert->z = 0x101 + (int)(SelfCheckRandom() % (uint)(range == 2 ? 0x7FFFFEFF : 0xFFFFF));
+            transformCheckScreen[0][i] = SelfCheckRandom();
+            transformCheckScreen[1][i] = SelfCheckRandom();
+            transformCheckScreen[2][i] = transformCheckScreen[0][i];
+            transformCheckScreen[3][i] = transformCheckScreen[1][i];
+        }
+        ProjectVertexList(transformCheckVerts[0], count, transformCheckScreen[0], transformCheckScreen[1]);
+        ProjectVertexListScalar(transformCheckVerts[0], count, transformCheckScreen[2], transformCheckScreen[3]);
+        if (memcmp(transformCheckScreen[0], transformCheckScreen[2], 2 * sizeof(transformCheckScreen[0])))
+            ++failures;
+    }
+    projectionX = storeProjectionX;
+    projectionY = storeProjectionY;
+    ReportSelfCheck("3D vertex projection", failures, TRANSFORMCHECK_COUNT);
+    return failures;
+}
+
+// Times both sorts on stage-like depths, best of SORTBENCH_RUNS
+void Benchmark3DDrawListSort()
+{
+    int faceCounts[] = { 64, 256, FACEBUFFER_SIZE };
+    for (int f = 0; f < 3; ++f) {
+        long long best[2] = { 0, 0 };
+        for (int r = 0; r < SORTBENCH_RUNS; ++r) {
+            for (int i = 0; i < faceCounts[f]; ++i) {
+                sortCheckLists[0][i].faceID = i;
+                sortCheckLists[0][i].depth  = SelfCheckRandom() & 0xFFFF;
+                sortCheckLists[1][i]        = sortCheckLists[0][i];
+            }
+
+            long long start = GetBenchmarkTime();
+            RadixSort3DDrawList(sortCheckLists[0], sortCheckLists[2], faceCounts[f]);
+            long long time = GetBenchmarkTime() - start;
+            if (!r || time < best[0])
+                best[0] = time;
+
+            start = GetBenchmarkTime();
+            BubbleSort3DDrawList(sortCheckLists[1], faceCounts[f]);
+            time = GetBenchmarkTime() - start;
+            if (!r || time < best[1])
+                best[1] = time;
+        }
+        printf("3D draw list sort, %d faces: radix %.1f us, bubble %.1f us\n", faceCounts[f], best[0] / 1000.0, best[1] / 1000.0);
+    }
+}
+#endif
@@ -56,10 +56,15 @@ extern Vertex vertexBuffer[VERTEXBUFFER_SIZE];
 extern Vertex vertexBufferT[VERTEXBUFFER_SIZE];
 
 extern DrawListEntry3D drawList3D[FACEBUFFER_SIZE];
+extern int drawList3DCount; // faces in drawList3D, the ones Cull3DDrawList didn't drop (reset with faceCount on stage load)
 
 extern int projectionX;
 extern int projectionY;
 
+// screen positions of vertexBufferT's verts, from ProjectVertexBuffer (which Cull3DDrawList runs)
+extern int vertexScreenX[VERTEXBUFFER_SIZE];
+extern int vertexScreenY[VERTEXBUFFER_SIZE];
+
 extern int faceLineStart[SCREEN_YSIZE];
 extern int faceLineEnd[SCREEN_YSIZE];
 extern int faceLineStartU[SCREEN_YSIZE];
@@ -67,20 +72,30 @@ extern int faceLineEndU[SCREEN_YSIZE];
 extern int faceLineStartV[SCREEN_YSIZE];
 extern int faceLineEndV[SCREEN_YSIZE];
 
-void setIdentityMatrix(Matrix *matrix);
-void matrixMultiply(Matrix *matrixA, Matrix *matrixB);
-void matrixTranslateXYZ(Matrix *Matrix, int XPos, int YPos, int ZPos);
-void matrixScaleXYZ(Matrix *matrix, int scaleX, int scaleY, int scaleZ);
-void matrixRotateX(Matrix *matrix, int rotationX);
-void matrixRotateY(Matrix *matrix, int rotationY);
-void matrixRotateZ(Matrix *matrix, int rotationZ);
-void matrixRotateXYZ(Matrix *matrix, int rotationX, int rotationY, int rotationZ);
-void transformVertexBuffer();
-void transformVerticies(Matrix *matrix, int startIndex, int endIndex);
-void sort3DDrawList();
-void draw3DScene(int spriteSheetID);
-
-void processScanEdge(Vertex *vertA, Vertex *vertB);
-void processScanEdgeUV(Vertex *vertA, Vertex *vertB);
+void SetIdentityMatrix(Matrix *matrix);
+void MatrixMultiply(Matrix *matrixA, Matrix *matrixB);
+void MatrixTranslateXYZ(Matrix *Matrix, int XPos, int YPos, int ZPos);
+void MatrixScaleXYZ(Matrix *matrix, int scaleX, int scaleY, int scaleZ);
+void MatrixRotateX(Matrix *matrix, int rotationX);
+void MatrixRotateY(Matrix *matrix, int rotationY);
+void MatrixRotateZ(Matrix *matrix, int rotationZ);
+void MatrixRotateXYZ(Matrix *matrix, int rotationX, int rotationY, int rotationZ);
+void TransformVertexBuffer();
+void TransformVerticies(Matrix *matrix, int startIndex, int endIndex);
+void ProjectVertexBuffer();
+void Cull3DDrawList();
+void Sort3DDrawList();
+void RadixSort3DDrawList(DrawListEntry3D *list, DrawListEntry3D *buffer, int count);
+void Draw3DScene(int spriteSheetID);
+
+void ProcessScanEdge(Vertex *vertA, Vertex *vertB);
+void ProcessScanEdgeUV(Vertex *vertA, Vertex *vertB);
+
+#if !RETRO_USE_ORIGINAL_CODE
+int Check3DDrawListSort();
+int Check3DTransform();
+int Check3DProjection();
+void Benchmark3DDrawListSort();
+#endif
 
 #endif // !DRAWING3D_H
@@ -1,5 +1,8 @@
 #include "RetroEngine.hpp"
 #include <cmath>
+#if RETRO_USE_SCRIPT_PROFILER
+#include <chrono>
+#endif
 
 ObjectScript objectScriptList[OBJECT_COUNT];
 
@@ -864,6 +867,37 @@ enum ScrFunction {
     FUNC_MAX_CNT
 };
 
+// Where a variable operand's array index comes from, resolved once from the VARARR_* encoding
+enum ScriptOperandArrayTypes {
+    OPERANDARR_INVALID,
+    OPERANDARR_OBJECTLOOP,
+    OPERANDARR_CONST,
+    OPERANDARR_ARRAYPOS,
+    OPERANDARR_ENTNOPLUSCONST,
+    OPERANDARR_ENTNOPLUSARRAYPOS,
+    OPERANDARR_ENTNOMINUSCONST,
+    OPERANDARR_ENTNOMINUSARRAYPOS,
+};
+
+// Pre-decoded scriptCode, indexed by the same code position so jump table offsets & function pointers work unchanged
+// The slot of an opcode holds the instruction header, the slots right after it hold its operands
+struct ScriptOperand {
+    int value;       // header: code pos of the next opcode. operand: int constant, array index/arrayPos ID or string pool offset
+    ushort variable; // header: opcode. operand: VAR_* ID
+    byte type;       // header: operand count. operand: SCRIPTVAR_* type
+    byte arrayType;  // operand: OPERANDARR_* type, or nonzero if a string didn't fit in the pool
+};
+
+#define SCRIPTSTRING_COUNT (0x4000)
+// an instruction header & the most operands any opcode has (scriptEng.operands)
+#define SCRIPTINSTRUCTION_SIZE (1 + 10)
+
+// covers scriptCode up to scriptCodeDecodedSize (the code loaded when DecodeScriptCode last ran), anything past it gets decoded as it runs
+ScriptOperand *scriptCodeDecoded = NULL;
+int scriptCodeDecodedSize        = 0;
+char scriptStrings[SCRIPTSTRING_COUNT];
+int scriptStringPos = 0;
+
 #if RETRO_USE_COMPILER
 void CheckAliasText(char *text)
 {
@@ -1914,6 +1948,13 @@ void LoadBytecode(int stageListID, int scriptID)
         FileRead(&fileBuffer, 1);
         scriptCodeSize |= fileBuffer << 24;
 
+        // the last slot is kept for the FUNC_END that unset subs point at (see ClearScriptData)
+        if (scriptCodePos + scriptCodeSize > SCRIPTDATA_COUNT - 1) {
+            PrintLog("ERROR: %s needs %d script code slots, only %d are free", scriptPath, scriptCodeSize, SCRIPTDATA_COUNT - 1 - scriptCodePos);
+            CloseFile();
+            return;
+        }
+
         while (scriptCodeSize > 0) {
             FileRead(&fileBuffer, 1);
             int blockSize = fileBuffer & 0x7F;
@@ -2113,10 +2154,222 @@ void LoadBytecode(int stageListID, int scriptID)
     }
 }
 
+// Unpacks a SCRIPTVAR_STRCONST operand (starting at its length) into dest, returns the code pos after it
+int UnpackScriptString(int scriptCodePtr, char *dest)
+{
+    int strLen   = scriptCode[scriptCodePtr++];
+    dest[strLen] = 0;
+    for (int c = 0; c < strLen; ++c) {
+        switch (c % 4) {
+            case 0: dest[c] = scriptCode[scriptCodePtr] >> 24; break;
+
+            case 1: dest[c] = (0xFFFFFF & scriptCode[scriptCodePtr]) >> 16; break;
+
+            case 2: dest[c] = (0xFFFF & scriptCode[scriptCodePtr]) >> 8; break;
+
+            case 3: dest[c] = scriptCode[scriptCodePtr++]; break;
+
+            default: break;
+        }
+    }
+    return scriptCodePtr + 1;
+}
+
+// Decodes the instruction at scriptCodePtr into instruction, strings only go in the pool when it's scriptCodeDecoded's copy
+void DecodeScriptOpcode(int scriptCodePtr, ScriptOperand *instruction)
+{
+    bool poolStrings = scriptCodePtr < scriptCodeDecodedSize;
+    int opcode       = scriptCode[scriptCodePtr++];
+    if (opcode < 0 || opcode >= FUNC_MAX_CNT)
+        opcode = FUNC_MAX_CNT; // falls through to the default case, same as the raw interpreter did
+    int opcodeSize = opcode < FUNC_MAX_CNT ? functions[opcode].opcodeSize : 0;
+
+    for (int i = 0; i < opcodeSize; ++i) {
+        ScriptOperand *operand = &instruction[i + 1];
+        operand->type          = scriptCode[scriptCodePtr++];
+        operand->variable      = 0;
+        operand->value         = 0;
+        operand->arrayType     = OPERANDARR_INVALID;
+
+        if (operand->type == SCRIPTVAR_VAR) {
+            int arrType = scriptCode[scriptCodePtr++];
+            switch (arrType) {
+                case VARARR_NONE: operand->arrayType = OPERANDARR_OBJECTLOOP; break;
+                case VARARR_ARRAY:
+                case VARARR_ENTNOPLUS1:
+                case VARARR_ENTNOMINUS1: {
+                    bool fromArrayPos = scriptCode[scriptCodePtr++] == 1;
+                    operand->value    = scriptCode[scriptCodePtr++];
+                    if (arrType == VARARR_ARRAY)
+                        operand->arrayType = fromArrayPos ? OPERANDARR_ARRAYPOS : OPERANDARR_CONST;
+                    else if (arrType == VARARR_ENTNOPLUS1)
+                        operand->arrayType = fromArrayPos ? OPERANDARR_ENTNOPLUSARRAYPOS : OPERANDARR_ENTNOPLUSCONST;
+                    else
+                        operand->arrayType = fromArrayPos ? OPERANDARR_ENTNOMINUSARRAYPOS : OPERANDARR_ENTNOMINUSCONST;
+                    break;
+                }
+                default: break;
+            }
+            operand->variable = scriptCode[scriptCodePtr++];
+        }
+        else if (operand->type == SCRIPTVAR_INTCONST) {
+            operand->value = scriptCode[scriptCodePtr++];
+        }
+        else if (operand->type == SCRIPTVAR_STRCONST) {
+            int strLen = scriptCode[scriptCodePtr];
+            if (poolStrings && strLen >= 0 && scriptStringPos + strLen + 1 <= SCRIPTSTRING_COUNT) {
+                operand->value = scriptStringPos;
+                scriptCodePtr  = UnpackScriptString(scriptCodePtr, &scriptStrings[scriptStringPos]);
+                scriptStringPos += strLen + 1;
+            }
+            else {
+                // pool is full (or this is a one off decode), leave it to be unpacked from scriptCode when it runs
+                operand->value     = scriptCodePtr;
+                operand->arrayType = 1;
+                scriptCodePtr      = UnpackScriptString(scriptCodePtr, scriptText);
+            }
+        }
+    }
+
+    instruction->value    = scriptCodePtr;
+    instruction->variable = opcode;
+    instruction->type     = opcodeSize;
+}
+
+// Returns the decoded instruction at scriptCodePtr, from scriptCodeDecoded if it covers it or decoded into buffer if not
+inline ScriptOperand *GetScriptInstruction(int scriptCodePtr, ScriptOperand *buffer)
+{
+    if (scriptCodePtr >= 0 && scriptCodePtr < scriptCodeDecodedSize) {
+        ScriptOperand *instruction = &scriptCodeDecoded[scriptCodePtr];
+        if (!instruction->value)
+            DecodeScriptOpcode(scriptCodePtr, instruction);
+        return instruction;
+    }
+    DecodeScriptOpcode(scriptCodePtr, buffer);
+    return buffer;
+}
+
+// Decodes the instructions from codePtr until the end of its sub/function
+void DecodeScriptSub(int scriptCodePtr)
+{
+    while (scriptCodePtr >= 0 && scriptCodePtr < scriptCodeDecodedSize && !scriptCodeDecoded[scriptCodePtr].value) {
+        ScriptOperand *instruction = &scriptCodeDecoded[scriptCodePtr];
+        DecodeScriptOpcode(scriptCodePtr, instruction);
+        if (instruction->variable == FUNC_END || instruction->variable == FUNC_ENDFUNCTION || instruction->variable == FUNC_MAX_CNT)
+            break;
+        scriptCodePtr = instruction->value;
+    }
+}
+
+void DecodeScriptCode()
+{
+    if (scriptCodePos > SCRIPTDATA_COUNT - 1 || scriptCode[SCRIPTDATA_COUNT - 1] != FUNC_END) {
+        PrintLog("ERROR: script code ran into the reserved FUNC_END slot at the end of scriptCode");
+        scriptCode[SCRIPTDATA_COUNT - 1] = FUNC_END;
+    }
+
+#if RETRO_USE_DECODED_SCRIPTS
+    if (scriptCodePos > scriptCodeDecodedSize) {
+        // the last instruction's operands can run a little past the code if it was cut short
+        ScriptOperand *decoded = (ScriptOperand *)realloc(scriptCodeDecoded, (scriptCodePos + SCRIPTINSTRUCTION_SIZE) * sizeof(ScriptOperand));
+        if (!decoded) {
+            PrintLog("WARNING: Couldn't allocate decoded script code, decoding as it runs");
+            return;
+        }
+        int oldEnd = scriptCodeDecodedSize ? scriptCodeDecodedSize + SCRIPTINSTRUCTION_SIZE : 0;
+        memset(&decoded[oldEnd], 0, (scriptCodePos + SCRIPTINSTRUCTION_SIZE - oldEnd) * sizeof(ScriptOperand));
+        scriptCodeDecoded     = decoded;
+        scriptCodeDecodedSize = scriptCodePos;
+    }
+#endif
+
+    for (int o = 0; o < OBJECT_COUNT; ++o) {
+        ObjectScript *scriptInfo = &objectScriptList[o];
+        DecodeScriptSub(scriptInfo->subMain.scriptCodePtr);
+        DecodeScriptSub(scriptInfo->subPlayerInteraction.scriptCodePtr);
+        DecodeScriptSub(scriptInfo->subDraw.scriptCodePtr);
+        DecodeScriptSub(scriptInfo->subStartup.scriptCodePtr);
+    }
+
+    for (int f = 0; f < FUNCTION_COUNT; ++f) DecodeScriptSub(scriptFunctionList[f].ptr.scriptCodePtr);
+}
+
+#if RETRO_USE_PALETTE_FADE
+bool paletteFadeFunctionScanned[FUNCTION_COUNT];
+
+// Returns if the code from scriptCodePtr to the end of its sub/function can draw something that blends with the pixels under it, or
+// change the screen fade, entity types or draw lists part way through the draw lists. Called functions are followed, anything that
+// can't be told from constant operands counts
+static bool ScriptCodeBlocksPaletteFade(int scriptCodePtr)
+{
+    ScriptOperand buffer[SCRIPTINSTRUCTION_SIZE];
+    while (true) {
+        ScriptOperand *instruction = GetScriptInstruction(scriptCodePtr, buffer);
+        ScriptOperand *operands    = &instruction[1];
+        for (int i = 0; i < instruction->type; ++i) {
+            if (operands[i].type == SCRIPTVAR_VAR && (operands[i].variable == VAR_OBJECTTYPE || operands[i].variable == VAR_SCREENDRAWLISTSIZE))
+                return true;
+        }
+
+        switch (instruction->variable) {
+            default: break;
+            case FUNC_END:
+            case FUNC_ENDFUNCTION: return false;
+            case FUNC_DRAWTINTRECT:
+            case FUNC_DRAW3DSCENE: // faces can be alpha blended
+            case FUNC_SETSCREENFADE:
+            case FUNC_RESETOBJECTENTITY:
+            case FUNC_CREATETEMPOBJECT:
+            case FUNC_CLEARDRAWLIST:
+            case FUNC_ADDDRAWLISTENTITYREF:
+            case FUNC_SETDRAWLISTENTITYREF: return true;
+            case FUNC_DRAWSPRITEFX:
+            case FUNC_DRAWSPRITESCREENFX:
+                // FX_INK & FX_TINT draw with the entity's ink effect
+                if (operands[1].type != SCRIPTVAR_INTCONST || operands[1].value == FX_INK || operands[1].value == FX_TINT)
+                    return true;
+                break;
+            case FUNC_DRAWRECT:
+                if (operands[7].type != SCRIPTVAR_INTCONST || (operands[7].value > 0 && operands[7].value < 0xFF))
+                    return true;
+                break;
+            case FUNC_CALLFUNCTION: {
+                if (operands[0].type != SCRIPTVAR_INTCONST || operands[0].value < 0 || operands[0].value >= FUNCTION_COUNT)
+                    return true;
+                int functionID = operands[0].value;
+                if (!paletteFadeFunctionScanned[functionID]) {
+                    paletteFadeFunctionScanned[functionID] = true;
+                    if (ScriptCodeBlocksPaletteFade(scriptFunctionList[functionID].ptr.scriptCodePtr))
+                        return true;
+                }
+                break;
+            }
+        }
+        scriptCodePtr = instruction->value;
+    }
+}
+
+// DrawStageGFX only applies a fade to the palettes when none of the entities in the draw lists have a draw sub that blocks it, so
+// whether a frame gets the palette fade or the per pixel one is known before anything's drawn
+void ScanPaletteFadeScripts()
+{
+    for (int o = 0; o < OBJECT_COUNT; ++o) {
+        memset(paletteFadeFunctionScanned, 0, sizeof(paletteFadeFunctionScanned));
+        objectScriptList[o].blocksPaletteFade = ScriptCodeBlocksPaletteFade(objectScriptList[o].subDraw.scriptCodePtr);
+    }
+}
+#endif
+
 void ClearScriptData()
 {
     memset(scriptCode, 0, SCRIPTDATA_COUNT * sizeof(int));
+    // reserved: the subs & functions below point here until scripts set them, and CallNativeScriptFunction returns here
+    scriptCode[SCRIPTDATA_COUNT - 1] = FUNC_END;
     memset(jumpTable, 0, JUMPTABLE_COUNT * sizeof(int));
+    free(scriptCodeDecoded);
+    scriptCodeDecoded     = NULL;
+    scriptCodeDecodedSize = 0;
+    scriptStringPos = 0;
 
     scriptFrameCount = 0;
 
@@ -2156,6 +2409,9 @@ void ClearScriptData()
         scriptInfo->subStartup.scriptCodePtr           = SCRIPTDATA_COUNT - 1;
         scriptInfo->subStartup.jumpTablePtr            = JUMPTABLE_COUNT - 1;
         scriptInfo->frameListOffset                    = 0;
+#if RETRO_USE_PALETTE_FADE
+        scriptInfo->blocksPaletteFade = false;
+#endif
         scriptInfo->spriteSheetID                      = 0;
         scriptInfo->animFile                           = GetDefaultAnimationRef();
         scriptInfo->mobile                             = true;
@@ -2180,2510 +2436,3293 @@ void ClearScriptData()
 
 }
 
-void ProcessScript(int scriptCodeStart, int jumpTableStart, byte scriptSub)
+inline int GetOperandArrayValue(ScriptOperand *operand)
 {
-    bool running      = true;
-    int scriptCodePtr = scriptCodeStart;
+    switch (operand->arrayType) {
+        default: return 0;
+        case OPERANDARR_OBJECTLOOP: return objectLoop;
+        case OPERANDARR_CONST: return operand->value;
+        case OPERANDARR_ARRAYPOS: return scriptEng.arrayPosition[operand->value];
+        case OPERANDARR_ENTNOPLUSCONST: return operand->value + objectLoop;
+        case OPERANDARR_ENTNOPLUSARRAYPOS: return scriptEng.arrayPosition[operand->value] + objectLoop;
+        case OPERANDARR_ENTNOMINUSCONST: return objectLoop - operand->value;
+        case OPERANDARR_ENTNOMINUSARRAYPOS: return objectLoop - scriptEng.arrayPosition[operand->value];
+    }
+}
 
-    jumpTableStackPos = 0;
-    functionStackPos  = 0;
-    while (running) {
-        int opcode           = scriptCode[scriptCodePtr++];
-        int opcodeSize       = functions[opcode].opcodeSize;
-        int scriptCodeOffset = scriptCodePtr;
+// Reads the values of an instruction's operands into scriptEng.operands (string constants go into scriptText)
+inline void GetScriptOperands(ScriptOperand *operands, int opcodeSize)
+{
+    for (int i = 0; i < opcodeSize; ++i) {
+        ScriptOperand *operand = &operands[i];
 
-        // Get Values
-        for (int i = 0; i < opcodeSize; ++i) {
-            int opcodeType = scriptCode[scriptCodePtr++];
-
-            if (opcodeType == SCRIPTVAR_VAR) {
-                int arrayVal = 0;
-                switch (scriptCode[scriptCodePtr++]) {
-                    case VARARR_NONE: arrayVal = objectLoop; break;
-                    case VARARR_ARRAY:
-                        if (scriptCode[scriptCodePtr++] == 1)
-                            arrayVal = scriptEng.arrayPosition[scriptCode[scriptCodePtr++]];
-                        else
-                            arrayVal = scriptCode[scriptCodePtr++];
-                        break;
-                    case VARARR_ENTNOPLUS1:
-                        if (scriptCode[scriptCodePtr++] == 1)
-                            arrayVal = scriptEng.arrayPosition[scriptCode[scriptCodePtr++]] + objectLoop;
-                        else
-                            arrayVal = scriptCode[scriptCodePtr++] + objectLoop;
-                        break;
-                    case VARARR_ENTNOMINUS1:
-                        if (scriptCode[scriptCodePtr++] == 1)
-                            arrayVal = objectLoop - scriptEng.arrayPosition[scriptCode[scriptCodePtr++]];
-                        else
-                            arrayVal = objectLoop - scriptCode[scriptCodePtr++];
-                        break;
-                    default: break;
-                }
+        if (operand->type == SCRIPTVAR_VAR) {
+            int arrayVal = GetOperandArrayValue(operand);
 
-                // Variables
-                switch (scriptCode[scriptCodePtr++]) {
-                    default: break;
-                    case VAR_TEMPVALUE0: scriptEng.operands[i] = scriptEng.tempValue[0]; break;
-                    case VAR_TEMPVALUE1: scriptEng.operands[i] = scriptEng.tempValue[1]; break;
-                    case VAR_TEMPVALUE2: scriptEng.operands[i] = scriptEng.tempValue[2]; break;
-                    case VAR_TEMPVALUE3: scriptEng.operands[i] = scriptEng.tempValue[3]; break;
-                    case VAR_TEMPVALUE4: scriptEng.operands[i] = scriptEng.tempValue[4]; break;
-                    case VAR_TEMPVALUE5: scriptEng.operands[i] = scriptEng.tempValue[5]; break;
-                    case VAR_TEMPVALUE6: scriptEng.operands[i] = scriptEng.tempValue[6]; break;
-                    case VAR_TEMPVALUE7: scriptEng.operands[i] = scriptEng.tempValue[7]; break;
-                    case VAR_CHECKRESULT: scriptEng.operands[i] = scriptEng.checkResult; break;
-                    case VAR_ARRAYPOS0: scriptEng.operands[i] = scriptEng.arrayPosition[0]; break;
-                    case VAR_ARRAYPOS1: scriptEng.operands[i] = scriptEng.arrayPosition[1]; break;
-                    case VAR_GLOBAL: scriptEng.operands[i] = globalVariables[arrayVal]; break;
-                    case VAR_OBJECTENTITYNO: scriptEng.operands[i] = arrayVal; break;
-                    case VAR_OBJECTTYPE: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].type;
-                        break;
-                    }
-                    case VAR_OBJECTPROPERTYVALUE: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].propertyValue;
-                        break;
+            // Variables
+            switch (operand->variable) {
+                default: break;
+                case VAR_TEMPVALUE0: scriptEng.operands[i] = scriptEng.tempValue[0]; break;
+                case VAR_TEMPVALUE1: scriptEng.operands[i] = scriptEng.tempValue[1]; break;
+                case VAR_TEMPVALUE2: scriptEng.operands[i] = scriptEng.tempValue[2]; break;
+                case VAR_TEMPVALUE3: scriptEng.operands[i] = scriptEng.tempValue[3]; break;
+                case VAR_TEMPVALUE4: scriptEng.operands[i] = scriptEng.tempValue[4]; break;
+                case VAR_TEMPVALUE5: scriptEng.operands[i] = scriptEng.tempValue[5]; break;
+                case VAR_TEMPVALUE6: scriptEng.operands[i] = scriptEng.tempValue[6]; break;
+                case VAR_TEMPVALUE7: scriptEng.operands[i] = scriptEng.tempValue[7]; break;
+                case VAR_CHECKRESULT: scriptEng.operands[i] = scriptEng.checkResult; break;
+                case VAR_ARRAYPOS0: scriptEng.operands[i] = scriptEng.arrayPosition[0]; break;
+                case VAR_ARRAYPOS1: scriptEng.operands[i] = scriptEng.arrayPosition[1]; break;
+                case VAR_GLOBAL: scriptEng.operands[i] = globalVariables[arrayVal]; break;
+                case VAR_OBJECTENTITYNO: scriptEng.operands[i] = arrayVal; break;
+                case VAR_OBJECTTYPE: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].type;
+                    break;
+                }
+                case VAR_OBJECTPROPERTYVALUE: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].propertyValue;
+                    break;
+                }
+                case VAR_OBJECTXPOS: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].XPos;
+                    break;
+                }
+                case VAR_OBJECTYPOS: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].YPos;
+                    break;
+                }
+                case VAR_OBJECTIXPOS: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].XPos >> 16;
+                    break;
+                }
+                case VAR_OBJECTIYPOS: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].YPos >> 16;
+                    break;
+                }
+                case VAR_OBJECTSTATE: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].state;
+                    break;
+                }
+                case VAR_OBJECTROTATION: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].rotation;
+                    break;
+                }
+                case VAR_OBJECTSCALE: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].scale;
+                    break;
+                }
+                case VAR_OBJECTPRIORITY: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].priority;
+                    break;
+                }
+                case VAR_OBJECTDRAWORDER: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].drawOrder;
+                    break;
+                }
+                case VAR_OBJECTDIRECTION: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].direction;
+                    break;
+                }
+                case VAR_OBJECTINKEFFECT: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].inkEffect;
+                    break;
+                }
+                case VAR_OBJECTALPHA: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].alpha;
+                    break;
+                }
+                case VAR_OBJECTFRAME: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].frame;
+                    break;
+                }
+                case VAR_OBJECTANIMATION: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].animation;
+                    break;
+                }
+                case VAR_OBJECTPREVANIMATION: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].prevAnimation;
+                    break;
+                }
+                case VAR_OBJECTANIMATIONSPEED: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].animationSpeed;
+                    break;
+                }
+                case VAR_OBJECTANIMATIONTIMER: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].animationTimer;
+                    break;
+                }
+                case VAR_OBJECTVALUE0: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].values[0];
+                    break;
+                }
+                case VAR_OBJECTVALUE1: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].values[1];
+                    break;
+                }
+                case VAR_OBJECTVALUE2: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].values[2];
+                    break;
+                }
+                case VAR_OBJECTVALUE3: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].values[3];
+                    break;
+                }
+                case VAR_OBJECTVALUE4: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].values[4];
+                    break;
+                }
+                case VAR_OBJECTVALUE5: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].values[5];
+                    break;
+                }
+                case VAR_OBJECTVALUE6: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].values[6];
+                    break;
+                }
+                case VAR_OBJECTVALUE7: {
+                    scriptEng.operands[i] = objectEntityList[arrayVal].values[7];
+                    break;
+                }
+                case VAR_OBJECTOUTOFBOUNDS: {
+                    int pos = objectEntityList[arrayVal].XPos >> 16;
+                    if (pos <= xScrollOffset - OBJECT_BORDER_X1 || pos >= OBJECT_BORDER_X2 + xScrollOffset) {
+                        scriptEng.operands[i] = 1;
                     }
-                    case VAR_OBJECTXPOS: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].XPos;
-                        break;
+                    else {
+                        int pos               = objectEntityList[arrayVal].YPos >> 16;
+                        scriptEng.operands[i] = pos <= yScrollOffset - OBJECT_BORDER_Y1 || pos >= yScrollOffset + OBJECT_BORDER_Y2;
                     }
-                    case VAR_OBJECTYPOS: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].YPos;
-                        break;
+                    break;
+                }
+                case VAR_PLAYERSTATE: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->state;
+                    break;
+                }
+                case VAR_PLAYERCONTROLMODE: {
+                    scriptEng.operands[i] = playerList[activePlayer].controlMode;
+                    break;
+                }
+                case VAR_PLAYERCONTROLLOCK: {
+                    scriptEng.operands[i] = playerList[activePlayer].controlLock;
+                    break;
+                }
+                case VAR_PLAYERCOLLISIONMODE: {
+                    scriptEng.operands[i] = playerList[activePlayer].collisionMode;
+                    break;
+                }
+                case VAR_PLAYERCOLLISIONPLANE: {
+                    scriptEng.operands[i] = playerList[activePlayer].collisionPlane;
+                    break;
+                }
+                case VAR_PLAYERXPOS: {
+                    scriptEng.operands[i] = playerList[activePlayer].XPos;
+                    break;
+                }
+                case VAR_PLAYERYPOS: {
+                    scriptEng.operands[i] = playerList[activePlayer].YPos;
+                    break;
+                }
+                case VAR_PLAYERIXPOS: {
+                    scriptEng.operands[i] = playerList[activePlayer].XPos >> 16;
+                    break;
+                }
+                case VAR_PLAYERIYPOS: {
+                    scriptEng.operands[i] = playerList[activePlayer].YPos >> 16;
+                    break;
+                }
+                case VAR_PLAYERSCREENXPOS: {
+                    scriptEng.operands[i] = playerList[activePlayer].screenXPos;
+                    break;
+                }
+                case VAR_PLAYERSCREENYPOS: {
+                    scriptEng.operands[i] = playerList[activePlayer].screenYPos;
+                    break;
+                }
+                case VAR_PLAYERSPEED: {
+                    scriptEng.operands[i] = playerList[activePlayer].speed;
+                    break;
+                }
+                case VAR_PLAYERXVELOCITY: {
+                    scriptEng.operands[i] = playerList[activePlayer].XVelocity;
+                    break;
+                }
+                case VAR_PLAYERYVELOCITY: {
+                    scriptEng.operands[i] = playerList[activePlayer].YVelocity;
+                    break;
+                }
+                case VAR_PLAYERGRAVITY: {
+                    scriptEng.operands[i] = playerList[activePlayer].gravity;
+                    break;
+                }
+                case VAR_PLAYERANGLE: {
+                    scriptEng.operands[i] = playerList[activePlayer].angle;
+                    break;
+                }
+                case VAR_PLAYERSKIDDING: {
+                    scriptEng.operands[i] = playerList[activePlayer].skidding;
+                    break;
+                }
+                case VAR_PLAYERPUSHING: {
+                    scriptEng.operands[i] = playerList[activePlayer].pushing;
+                    break;
+                }
+                case VAR_PLAYERTRACKSCROLL: {
+                    scriptEng.operands[i] = playerList[activePlayer].trackScroll;
+                    break;
+                }
+                case VAR_PLAYERUP: {
+                    scriptEng.operands[i] = playerList[activePlayer].up;
+                    break;
+                }
+                case VAR_PLAYERDOWN: {
+                    scriptEng.operands[i] = playerList[activePlayer].down;
+                    break;
+                }
+                case VAR_PLAYERLEFT: {
+                    scriptEng.operands[i] = playerList[activePlayer].left;
+                    break;
+                }
+                case VAR_PLAYERRIGHT: {
+                    scriptEng.operands[i] = playerList[activePlayer].right;
+                    break;
+                }
+                case VAR_PLAYERJUMPPRESS: {
+                    scriptEng.operands[i] = playerList[activePlayer].jumpPress;
+                    break;
+                }
+                case VAR_PLAYERJUMPHOLD: {
+                    scriptEng.operands[i] = playerList[activePlayer].jumpHold;
+                    break;
+                }
+                case VAR_PLAYERFOLLOWPLAYER1: {
+                    scriptEng.operands[i] = playerList[activePlayer].followPlayer1;
+                    break;
+                }
+                case VAR_PLAYERLOOKPOS: {
+                    scriptEng.operands[i] = playerList[activePlayer].lookPos;
+                    break;
+                }
+                case VAR_PLAYERWATER: {
+                    scriptEng.operands[i] = playerList[activePlayer].water;
+                    break;
+                }
+                case VAR_PLAYERTOPSPEED: {
+                    scriptEng.operands[i] = playerList[activePlayer].topSpeed;
+                    break;
+                }
+                case VAR_PLAYERACCELERATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].acceleration;
+                    break;
+                }
+                case VAR_PLAYERDECELERATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].deceleration;
+                    break;
+                }
+                case VAR_PLAYERAIRACCELERATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].airAcceleration;
+                    break;
+                }
+                case VAR_PLAYERAIRDECELERATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].airDeceleration;
+                    break;
+                }
+                case VAR_PLAYERGRAVITYSTRENGTH: {
+                    scriptEng.operands[i] = playerList[activePlayer].gravityStrength;
+                    break;
+                }
+                case VAR_PLAYERJUMPSTRENGTH: {
+                    scriptEng.operands[i] = playerList[activePlayer].jumpStrength;
+                    break;
+                }
+                case VAR_PLAYERJUMPCAP: {
+                    scriptEng.operands[i] = playerList[activePlayer].jumpCap;
+                    break;
+                }
+                case VAR_PLAYERROLLINGACCELERATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].rollingAcceleration;
+                    break;
+                }
+                case VAR_PLAYERROLLINGDECELERATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].rollingDeceleration;
+                    break;
+                }
+                case VAR_PLAYERENTITYNO: {
+                    scriptEng.operands[i] = playerList[activePlayer].entityNo;
+                    break;
+                }
+                case VAR_PLAYERCOLLISIONLEFT: {
+                    AnimationFile *animFile = playerList[activePlayer].animationFile;
+                    Player *plr             = &playerList[activePlayer];
+                    if (animFile) {
+                        int h = animFrames[animationList[animFile->aniListOffset + plr->boundEntity->animation].frameListOffset
+                                           + plr->boundEntity->frame]
+                                    .hitboxID;
+
+                        scriptEng.operands[i] = hitboxList[animFile->hitboxListOffset + h].left[0];
                     }
-                    case VAR_OBJECTIXPOS: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].XPos >> 16;
-                        break;
+                    else {
+                        scriptEng.operands[i] = 0;
                     }
-                    case VAR_OBJECTIYPOS: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].YPos >> 16;
-                        break;
+                    break;
+                }
+                case VAR_PLAYERCOLLISIONTOP: {
+                    AnimationFile *animFile = playerList[activePlayer].animationFile;
+                    Player *plr             = &playerList[activePlayer];
+                    if (animFile) {
+                        int h = animFrames[animationList[animFile->aniListOffset + plr->boundEntity->animation].frameListOffset
+                                           + plr->boundEntity->frame]
+                                    .hitboxID;
+
+                        scriptEng.operands[i] = hitboxList[animFile->hitboxListOffset + h].top[0];
                     }
-                    case VAR_OBJECTSTATE: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].state;
-                        break;
+                    else {
+                        scriptEng.operands[i] = 0;
                     }
-                    case VAR_OBJECTROTATION: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].rotation;
-                        break;
+                    break;
+                }
+                case VAR_PLAYERCOLLISIONRIGHT: {
+                    AnimationFile *animFile = playerList[activePlayer].animationFile;
+                    Player *plr             = &playerList[activePlayer];
+                    if (animFile) {
+                        int h = animFrames[animationList[animFile->aniListOffset + plr->boundEntity->animation].frameListOffset
+                                           + plr->boundEntity->frame]
+                                    .hitboxID;
+
+                        scriptEng.operands[i] = hitboxList[animFile->hitboxListOffset + h].right[0];
                     }
-                    case VAR_OBJECTSCALE: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].scale;
-                        break;
+                    else {
+                        scriptEng.operands[i] = 0;
                     }
-                    case VAR_OBJECTPRIORITY: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].priority;
-                        break;
-                    }
-                    case VAR_OBJECTDRAWORDER: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].drawOrder;
-                        break;
-                    }
-                    case VAR_OBJECTDIRECTION: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].direction;
-                        break;
-                    }
-                    case VAR_OBJECTINKEFFECT: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].inkEffect;
-                        break;
-                    }
-                    case VAR_OBJECTALPHA: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].alpha;
-                        break;
-                    }
-                    case VAR_OBJECTFRAME: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].frame;
-                        break;
-                    }
-                    case VAR_OBJECTANIMATION: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].animation;
-                        break;
-                    }
-                    case VAR_OBJECTPREVANIMATION: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].prevAnimation;
-                        break;
-                    }
-                    case VAR_OBJECTANIMATIONSPEED: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].animationSpeed;
-                        break;
-                    }
-                    case VAR_OBJECTANIMATIONTIMER: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].animationTimer;
-                        break;
-                    }
-                    case VAR_OBJECTVALUE0: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].values[0];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE1: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].values[1];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE2: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].values[2];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE3: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].values[3];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE4: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].values[4];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE5: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].values[5];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE6: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].values[6];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE7: {
-                        scriptEng.operands[i] = objectEntityList[arrayVal].values[7];
-                        break;
-                    }
-                    case VAR_OBJECTOUTOFBOUNDS: {
-                        int pos = objectEntityList[arrayVal].XPos >> 16;
-                        if (pos <= xScrollOffset - OBJECT_BORDER_X1 || pos >= OBJECT_BORDER_X2 + xScrollOffset) {
-                            scriptEng.operands[i] = 1;
-                        }
-                        else {
-                            int pos               = objectEntityList[arrayVal].YPos >> 16;
-                            scriptEng.operands[i] = pos <= yScrollOffset - OBJECT_BORDER_Y1 || pos >= yScrollOffset + OBJECT_BORDER_Y2;
-                        }
-                        break;
-                    }
-                    case VAR_PLAYERSTATE: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->state;
-                        break;
-                    }
-                    case VAR_PLAYERCONTROLMODE: {
-                        scriptEng.operands[i] = playerList[activePlayer].controlMode;
-                        break;
-                    }
-                    case VAR_PLAYERCONTROLLOCK: {
-                        scriptEng.operands[i] = playerList[activePlayer].controlLock;
-                        break;
-                    }
-                    case VAR_PLAYERCOLLISIONMODE: {
-                        scriptEng.operands[i] = playerList[activePlayer].collisionMode;
-                        break;
-                    }
-                    case VAR_PLAYERCOLLISIONPLANE: {
-                        scriptEng.operands[i] = playerList[activePlayer].collisionPlane;
-                        break;
-                    }
-                    case VAR_PLAYERXPOS: {
-                        scriptEng.operands[i] = playerList[activePlayer].XPos;
-                        break;
-                    }
-                    case VAR_PLAYERYPOS: {
-                        scriptEng.operands[i] = playerList[activePlayer].YPos;
-                        break;
-                    }
-                    case VAR_PLAYERIXPOS: {
-                        scriptEng.operands[i] = playerList[activePlayer].XPos >> 16;
-                        break;
-                    }
-                    case VAR_PLAYERIYPOS: {
-                        scriptEng.operands[i] = playerList[activePlayer].YPos >> 16;
-                        break;
-                    }
-                    case VAR_PLAYERSCREENXPOS: {
-                        scriptEng.operands[i] = playerList[activePlayer].screenXPos;
-                        break;
-                    }
-                    case VAR_PLAYERSCREENYPOS: {
-                        scriptEng.operands[i] = playerList[activePlayer].screenYPos;
-                        break;
-                    }
-                    case VAR_PLAYERSPEED: {
-                        scriptEng.operands[i] = playerList[activePlayer].speed;
-                        break;
-                    }
-                    case VAR_PLAYERXVELOCITY: {
-                        scriptEng.operands[i] = playerList[activePlayer].XVelocity;
-                        break;
-                    }
-                    case VAR_PLAYERYVELOCITY: {
-                        scriptEng.operands[i] = playerList[activePlayer].YVelocity;
-                        break;
-                    }
-                    case VAR_PLAYERGRAVITY: {
-                        scriptEng.operands[i] = playerList[activePlayer].gravity;
-                        break;
-                    }
-                    case VAR_PLAYERANGLE: {
-                        scriptEng.operands[i] = playerList[activePlayer].angle;
-                        break;
-                    }
-                    case VAR_PLAYERSKIDDING: {
-                        scriptEng.operands[i] = playerList[activePlayer].skidding;
-                        break;
-                    }
-                    case VAR_PLAYERPUSHING: {
-                        scriptEng.operands[i] = playerList[activePlayer].pushing;
-                        break;
-                    }
-                    case VAR_PLAYERTRACKSCROLL: {
-                        scriptEng.operands[i] = playerList[activePlayer].trackScroll;
-                        break;
-                    }
-                    case VAR_PLAYERUP: {
-                        scriptEng.operands[i] = playerList[activePlayer].up;
-                        break;
-                    }
-                    case VAR_PLAYERDOWN: {
-                        scriptEng.operands[i] = playerList[activePlayer].down;
-                        break;
-                    }
-                    case VAR_PLAYERLEFT: {
-                        scriptEng.operands[i] = playerList[activePlayer].left;
-                        break;
-                    }
-                    case VAR_PLAYERRIGHT: {
-                        scriptEng.operands[i] = playerList[activePlayer].right;
-                        break;
-                    }
-                    case VAR_PLAYERJUMPPRESS: {
-                        scriptEng.operands[i] = playerList[activePlayer].jumpPress;
-                        break;
-                    }
-                    case VAR_PLAYERJUMPHOLD: {
-                        scriptEng.operands[i] = playerList[activePlayer].jumpHold;
-                        break;
-                    }
-                    case VAR_PLAYERFOLLOWPLAYER1: {
-                        scriptEng.operands[i] = playerList[activePlayer].followPlayer1;
-                        break;
-                    }
-                    case VAR_PLAYERLOOKPOS: {
-                        scriptEng.operands[i] = playerList[activePlayer].lookPos;
-                        break;
-                    }
-                    case VAR_PLAYERWATER: {
-                        scriptEng.operands[i] = playerList[activePlayer].water;
-                        break;
-                    }
-                    case VAR_PLAYERTOPSPEED: {
-                        scriptEng.operands[i] = playerList[activePlayer].topSpeed;
-                        break;
-                    }
-                    case VAR_PLAYERACCELERATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].acceleration;
-                        break;
-                    }
-                    case VAR_PLAYERDECELERATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].deceleration;
-                        break;
-                    }
-                    case VAR_PLAYERAIRACCELERATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].airAcceleration;
-                        break;
-                    }
-                    case VAR_PLAYERAIRDECELERATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].airDeceleration;
-                        break;
-                    }
-                    case VAR_PLAYERGRAVITYSTRENGTH: {
-                        scriptEng.operands[i] = playerList[activePlayer].gravityStrength;
-                        break;
-                    }
-                    case VAR_PLAYERJUMPSTRENGTH: {
-                        scriptEng.operands[i] = playerList[activePlayer].jumpStrength;
-                        break;
-                    }
-                    case VAR_PLAYERJUMPCAP: {
-                        scriptEng.operands[i] = playerList[activePlayer].jumpCap;
-                        break;
-                    }
-                    case VAR_PLAYERROLLINGACCELERATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].rollingAcceleration;
-                        break;
-                    }
-                    case VAR_PLAYERROLLINGDECELERATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].rollingDeceleration;
-                        break;
-                    }
-                    case VAR_PLAYERENTITYNO: {
-                        scriptEng.operands[i] = playerList[activePlayer].entityNo;
-                        break;
-                    }
-                    case VAR_PLAYERCOLLISIONLEFT: {
-                        AnimationFile *animFile = playerList[activePlayer].animationFile;
-                        Player *plr             = &playerList[activePlayer];
-                        if (animFile) {
-                            int h = animFrames[animationList[animFile->aniListOffset + plr->boundEntity->animation].frameListOffset
-                                               + plr->boundEntity->frame]
-                                        .hitboxID;
-
-                            scriptEng.operands[i] = hitboxList[animFile->hitboxListOffset + h].left[0];
-                        }
-                        else {
-                            scriptEng.operands[i] = 0;
-                        }
-                        break;
-                    }
-                    case VAR_PLAYERCOLLISIONTOP: {
-                        AnimationFile *animFile = playerList[activePlayer].animationFile;
-                        Player *plr             = &playerList[activePlayer];
-                        if (animFile) {
-                            int h = animFrames[animationList[animFile->aniListOffset + plr->boundEntity->animation].frameListOffset
-                                               + plr->boundEntity->frame]
-                                        .hitboxID;
-
-                            scriptEng.operands[i] = hitboxList[animFile->hitboxListOffset + h].top[0];
-                        }
-                        else {
-                            scriptEng.operands[i] = 0;
-                        }
-                        break;
-                    }
-                    case VAR_PLAYERCOLLISIONRIGHT: {
-                        AnimationFile *animFile = playerList[activePlayer].animationFile;
-                        Player *plr             = &playerList[activePlayer];
-                        if (animFile) {
-                            int h = animFrames[animationList[animFile->aniListOffset + plr->boundEntity->animation].frameListOffset
-                                               + plr->boundEntity->frame]
-                                        .hitboxID;
-
-                            scriptEng.operands[i] = hitboxList[animFile->hitboxListOffset + h].right[0];
-                        }
-                        else {
-                            scriptEng.operands[i] = 0;
-                        }
-                        break;
-                    }
-                    case VAR_PLAYERCOLLISIONBOTTOM: {
-                        AnimationFile *animFile = playerList[activePlayer].animationFile;
-                        Player *plr             = &playerList[activePlayer];
-                        if (animFile) {
-                            int h = animFrames[animationList[animFile->aniListOffset + plr->boundEntity->animation].frameListOffset
-                                               + plr->boundEntity->frame]
-                                        .hitboxID;
-
-                            scriptEng.operands[i] = hitboxList[animFile->hitboxListOffset + h].bottom[0];
-                        }
-                        else {
-                            scriptEng.operands[i] = 0;
-                        }
-                        break;
-                    }
-                    case VAR_PLAYERFLAILING: {
-                        scriptEng.operands[i] = playerList[activePlayer].flailing[arrayVal];
-                        break;
-                    }
-                    case VAR_PLAYERTIMER: {
-                        scriptEng.operands[i] = playerList[activePlayer].timer;
-                        break;
-                    }
-                    case VAR_PLAYERTILECOLLISIONS: {
-                        scriptEng.operands[i] = playerList[activePlayer].tileCollisions;
-                        break;
-                    }
-                    case VAR_PLAYEROBJECTINTERACTION: {
-                        scriptEng.operands[i] = playerList[activePlayer].objectInteractions;
-                        break;
-                    }
-                    case VAR_PLAYERVISIBLE: {
-                        scriptEng.operands[i] = playerList[activePlayer].visible;
-                        break;
-                    }
-                    case VAR_PLAYERROTATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->rotation;
-                        break;
-                    }
-                    case VAR_PLAYERSCALE: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->scale;
-                        break;
-                    }
-                    case VAR_PLAYERPRIORITY: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->priority;
-                        break;
-                    }
-                    case VAR_PLAYERDRAWORDER: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->drawOrder;
-                        break;
-                    }
-                    case VAR_PLAYERDIRECTION: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->direction;
-                        break;
-                    }
-                    case VAR_PLAYERINKEFFECT: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->inkEffect;
-                        break;
-                    }
-                    case VAR_PLAYERALPHA: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->alpha;
-                        break;
-                    }
-                    case VAR_PLAYERFRAME: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->frame;
-                        break;
-                    }
-                    case VAR_PLAYERANIMATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->animation;
-                        break;
-                    }
-                    case VAR_PLAYERPREVANIMATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->prevAnimation;
-                        break;
-                    }
-                    case VAR_PLAYERANIMATIONSPEED: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->animationSpeed;
-                        break;
-                    }
-                    case VAR_PLAYERANIMATIONTIMER: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->animationTimer;
-                        break;
-                    }
-                    case VAR_PLAYERVALUE0: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[0];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE1: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[1];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE2: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[2];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE3: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[3];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE4: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[4];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE5: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[5];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE6: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[6];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE7: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[7];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE8: {
-                        scriptEng.operands[i] = playerList[activePlayer].values[0];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE9: {
-                        scriptEng.operands[i] = playerList[activePlayer].values[1];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE10: {
-                        scriptEng.operands[i] = playerList[activePlayer].values[2];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE11: {
-                        scriptEng.operands[i] = playerList[activePlayer].values[3];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE12: {
-                        scriptEng.operands[i] = playerList[activePlayer].values[4];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE13: {
-                        scriptEng.operands[i] = playerList[activePlayer].values[5];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE14: {
-                        scriptEng.operands[i] = playerList[activePlayer].values[6];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE15: {
-                        scriptEng.operands[i] = playerList[activePlayer].values[7];
-                        break;
-                    }
-                    case VAR_PLAYEROUTOFBOUNDS: {
-                        int pos = playerList[activePlayer].XPos >> 16;
-                        if (pos <= xScrollOffset - OBJECT_BORDER_X1 || pos >= OBJECT_BORDER_X2 + xScrollOffset) {
-                            scriptEng.operands[i] = 1;
-                        }
-                        else {
-                            int pos               = playerList[activePlayer].YPos >> 16;
-                            scriptEng.operands[i] = pos <= yScrollOffset - OBJECT_BORDER_Y1 || pos >= yScrollOffset + OBJECT_BORDER_Y2;
-                        }
-                        break;
-                    }
-                    case VAR_STAGESTATE: scriptEng.operands[i] = stageMode; break;
-                    case VAR_STAGEACTIVELIST: scriptEng.operands[i] = activeStageList; break;
-                    case VAR_STAGELISTPOS: scriptEng.operands[i] = stageListPosition; break;
-                    case VAR_STAGETIMEENABLED: scriptEng.operands[i] = timeEnabled; break;
-                    case VAR_STAGEMILLISECONDS: scriptEng.operands[i] = stageMilliseconds; break;
-                    case VAR_STAGESECONDS: scriptEng.operands[i] = stageSeconds; break;
-                    case VAR_STAGEMINUTES: scriptEng.operands[i] = stageMinutes; break;
-                    case VAR_STAGEACTNO: scriptEng.operands[i] = actID; break;
-                    case VAR_STAGEPAUSEENABLED: scriptEng.operands[i] = pauseEnabled; break;
-                    case VAR_STAGELISTSIZE: scriptEng.operands[i] = stageListCount[activeStageList]; break;
-                    case VAR_STAGENEWXBOUNDARY1: scriptEng.operands[i] = newXBoundary1; break;
-                    case VAR_STAGENEWXBOUNDARY2: scriptEng.operands[i] = newXBoundary2; break;
-                    case VAR_STAGENEWYBOUNDARY1: scriptEng.operands[i] = newYBoundary1; break;
-                    case VAR_STAGENEWYBOUNDARY2: scriptEng.operands[i] = newYBoundary2; break;
-                    case VAR_STAGEXBOUNDARY1: scriptEng.operands[i] = xBoundary1; break;
-                    case VAR_STAGEXBOUNDARY2: scriptEng.operands[i] = xBoundary2; break;
-                    case VAR_STAGEYBOUNDARY1: scriptEng.operands[i] = yBoundary1; break;
-                    case VAR_STAGEYBOUNDARY2: scriptEng.operands[i] = yBoundary2; break;
-                    case VAR_STAGEDEFORMATIONDATA0: scriptEng.operands[i] = bgDeformationData0[arrayVal]; break;
-                    case VAR_STAGEDEFORMATIONDATA1: scriptEng.operands[i] = bgDeformationData1[arrayVal]; break;
-                    case VAR_STAGEDEFORMATIONDATA2: scriptEng.operands[i] = bgDeformationData2[arrayVal]; break;
-                    case VAR_STAGEDEFORMATIONDATA3: scriptEng.operands[i] = bgDeformationData3[arrayVal]; break;
-                    case VAR_STAGEWATERLEVEL: scriptEng.operands[i] = waterLevel; break;
-                    case VAR_STAGEACTIVELAYER: scriptEng.operands[i] = activeTileLayers[arrayVal]; break;
-                    case VAR_STAGEMIDPOINT: scriptEng.operands[i] = tLayerMidPoint; break;
-                    case VAR_STAGEPLAYERLISTPOS: scriptEng.operands[i] = playerListPos; break;
-                    case VAR_STAGEACTIVEPLAYER: scriptEng.operands[i] = activePlayer; break;
-                    case VAR_SCREENCAMERAENABLED: scriptEng.operands[i] = cameraEnabled; break;
-                    case VAR_SCREENCAMERATARGET: scriptEng.operands[i] = cameraTarget; break;
-                    case VAR_SCREENCAMERASTYLE: scriptEng.operands[i] = cameraStyle; break;
-                    case VAR_SCREENDRAWLISTSIZE: scriptEng.operands[i] = drawListEntries[arrayVal].listSize; break;
-                    case VAR_SCREENCENTERX: scriptEng.operands[i] = SCREEN_CENTERX; break;
-                    case VAR_SCREENCENTERY: scriptEng.operands[i] = SCREEN_CENTERY; break;
-                    case VAR_SCREENXSIZE: scriptEng.operands[i] = SCREEN_XSIZE; break;
-                    case VAR_SCREENYSIZE: scriptEng.operands[i] = SCREEN_YSIZE; break;
-                    case VAR_SCREENXOFFSET: scriptEng.operands[i] = xScrollOffset; break;
-                    case VAR_SCREENYOFFSET: scriptEng.operands[i] = yScrollOffset; break;
-                    case VAR_SCREENSHAKEX: scriptEng.operands[i] = cameraShakeX; break;
-                    case VAR_SCREENSHAKEY: scriptEng.operands[i] = cameraShakeY; break;
-                    case VAR_SCREENADJUSTCAMERAY: scriptEng.operands[i] = cameraAdjustY; break;
-                    case VAR_TOUCHSCREENDOWN: scriptEng.operands[i] = touchDown[arrayVal]; break;
-                    case VAR_TOUCHSCREENXPOS: scriptEng.operands[i] = touchX[arrayVal]; break;
-                    case VAR_TOUCHSCREENYPOS: scriptEng.operands[i] = touchY[arrayVal]; break;
-                    case VAR_MUSICVOLUME: scriptEng.operands[i] = masterVolume; break;
-                    case VAR_MUSICCURRENTTRACK: scriptEng.operands[i] = trackID; break;
-                    case VAR_KEYDOWNUP: scriptEng.operands[i] = keyDown.up; break;
-                    case VAR_KEYDOWNDOWN: scriptEng.operands[i] = keyDown.down; break;
-                    case VAR_KEYDOWNLEFT: scriptEng.operands[i] = keyDown.left; break;
-                    case VAR_KEYDOWNRIGHT: scriptEng.operands[i] = keyDown.right; break;
-                    case VAR_KEYDOWNBUTTONA: scriptEng.operands[i] = keyDown.A; break;
-                    case VAR_KEYDOWNBUTTONB: scriptEng.operands[i] = keyDown.B; break;
-                    case VAR_KEYDOWNBUTTONC: scriptEng.operands[i] = keyDown.C; break;
-                    case VAR_KEYDOWNSTART: scriptEng.operands[i] = keyDown.start; break;
-                    case VAR_KEYPRESSUP: scriptEng.operands[i] = keyPress.up; break;
-                    case VAR_KEYPRESSDOWN: scriptEng.operands[i] = keyPress.down; break;
-                    case VAR_KEYPRESSLEFT: scriptEng.operands[i] = keyPress.left; break;
-                    case VAR_KEYPRESSRIGHT: scriptEng.operands[i] = keyPress.right; break;
-                    case VAR_KEYPRESSBUTTONA: scriptEng.operands[i] = keyPress.A; break;
-                    case VAR_KEYPRESSBUTTONB: scriptEng.operands[i] = keyPress.B; break;
-                    case VAR_KEYPRESSBUTTONC: scriptEng.operands[i] = keyPress.C; break;
-                    case VAR_KEYPRESSSTART: scriptEng.operands[i] = keyPress.start; break;
-                    case VAR_MENU1SELECTION: scriptEng.operands[i] = gameMenu[0].selection1; break;
-                    case VAR_MENU2SELECTION: scriptEng.operands[i] = gameMenu[1].selection1; break;
-                    case VAR_TILELAYERXSIZE: scriptEng.operands[i] = stageLayouts[arrayVal].xsize; break;
-                    case VAR_TILELAYERYSIZE: scriptEng.operands[i] = stageLayouts[arrayVal].ysize; break;
-                    case VAR_TILELAYERTYPE: scriptEng.operands[i] = stageLayouts[arrayVal].type; break;
-                    case VAR_TILELAYERANGLE: scriptEng.operands[i] = stageLayouts[arrayVal].angle; break;
-                    case VAR_TILELAYERXPOS: scriptEng.operands[i] = stageLayouts[arrayVal].XPos; break;
-                    case VAR_TILELAYERYPOS: scriptEng.operands[i] = stageLayouts[arrayVal].YPos; break;
-                    case VAR_TILELAYERZPOS: scriptEng.operands[i] = stageLayouts[arrayVal].ZPos; break;
-                    case VAR_TILELAYERPARALLAXFACTOR: scriptEng.operands[i] = stageLayouts[arrayVal].parallaxFactor; break;
-                    case VAR_TILELAYERSCROLLSPEED: scriptEng.operands[i] = stageLayouts[arrayVal].scrollSpeed; break;
-                    case VAR_TILELAYERSCROLLPOS: scriptEng.operands[i] = stageLayouts[arrayVal].scrollPos; break;
-                    case VAR_TILELAYERDEFORMATIONOFFSET: scriptEng.operands[i] = stageLayouts[arrayVal].deformationOffset; break;
-                    case VAR_TILELAYERDEFORMATIONOFFSETW: scriptEng.operands[i] = stageLayouts[arrayVal].deformationOffsetW; break;
-                    case VAR_HPARALLAXPARALLAXFACTOR: scriptEng.operands[i] = hParallax.parallaxFactor[arrayVal]; break;
-                    case VAR_HPARALLAXSCROLLSPEED: scriptEng.operands[i] = hParallax.scrollSpeed[arrayVal]; break;
-                    case VAR_HPARALLAXSCROLLPOS: scriptEng.operands[i] = hParallax.scrollPos[arrayVal]; break;
-                    case VAR_VPARALLAXPARALLAXFACTOR: scriptEng.operands[i] = vParallax.parallaxFactor[arrayVal]; break;
-                    case VAR_VPARALLAXSCROLLSPEED: scriptEng.operands[i] = vParallax.scrollSpeed[arrayVal]; break;
-                    case VAR_VPARALLAXSCROLLPOS: scriptEng.operands[i] = vParallax.scrollPos[arrayVal]; break;
-                    case VAR_3DSCENENOVERTICES: scriptEng.operands[i] = vertexCount; break;
-                    case VAR_3DSCENENOFACES: scriptEng.operands[i] = faceCount; break;
-                    case VAR_VERTEXBUFFERX: scriptEng.operands[i] = vertexBuffer[arrayVal].x; break;
-                    case VAR_VERTEXBUFFERY: scriptEng.operands[i] = vertexBuffer[arrayVal].y; break;
-                    case VAR_VERTEXBUFFERZ: scriptEng.operands[i] = vertexBuffer[arrayVal].z; break;
-                    case VAR_VERTEXBUFFERU: scriptEng.operands[i] = vertexBuffer[arrayVal].u; break;
-                    case VAR_VERTEXBUFFERV: scriptEng.operands[i] = vertexBuffer[arrayVal].v; break;
-                    case VAR_FACEBUFFERA: scriptEng.operands[i] = faceBuffer[arrayVal].a; break;
-                    case VAR_FACEBUFFERB: scriptEng.operands[i] = faceBuffer[arrayVal].b; break;
-                    case VAR_FACEBUFFERC: scriptEng.operands[i] = faceBuffer[arrayVal].c; break;
-                    case VAR_FACEBUFFERD: scriptEng.operands[i] = faceBuffer[arrayVal].d; break;
-                    case VAR_FACEBUFFERFLAG: scriptEng.operands[i] = faceBuffer[arrayVal].flags; break;
-                    case VAR_FACEBUFFERCOLOR: scriptEng.operands[i] = faceBuffer[arrayVal].colour; break;
-                    case VAR_3DSCENEPROJECTIONX: scriptEng.operands[i] = projectionX; break;
-                    case VAR_3DSCENEPROJECTIONY: scriptEng.operands[i] = projectionY; break;
-                    case VAR_ENGINESTATE: scriptEng.operands[i] = Engine.gameMode; break;
-                    case VAR_STAGEDEBUGMODE: scriptEng.operands[i] = debugMode; break;
-                    case VAR_ENGINEMESSAGE: scriptEng.operands[i] = Engine.message; break;
-                    case VAR_SAVERAM: scriptEng.operands[i] = saveRAM[arrayVal]; break;
-                    case VAR_ENGINELANGUAGE: scriptEng.operands[i] = Engine.language; break;
-                    case VAR_OBJECTSPRITESHEET: {
-                        scriptEng.operands[i] = objectScriptList[objectEntityList[arrayVal].type].spriteSheetID;
-                        break;
-                    }
-                    case VAR_ENGINEONLINEACTIVE: scriptEng.operands[i] = Engine.onlineActive; break;
-                    case VAR_ENGINEFRAMESKIPTIMER: scriptEng.operands[i] = Engine.frameSkipTimer; break;
-                    case VAR_ENGINEFRAMESKIPSETTING: scriptEng.operands[i] = Engine.frameSkipSetting; break;
-                    case VAR_ENGINESFXVOLUME: scriptEng.operands[i] = sfxVolume; break;
-                    case VAR_ENGINEBGMVOLUME: scriptEng.operands[i] = bgmVolume; break;
-                    case VAR_ENGINEPLATFORMID: scriptEng.operands[i] = RETRO_GAMEPLATFORMID; break;
-                    case VAR_ENGINETRIALMODE: scriptEng.operands[i] = Engine.trialMode; break;
-                    case VAR_KEYPRESSANYSTART: scriptEng.operands[i] = anyPress; break;
-#if RETRO_USE_HAPTICS
-                    case VAR_ENGINEHAPTICSENABLED: scriptEng.operands[i] = Engine.hapticsEnabled; break;
-#endif
+                    break;
                 }
-            }
-            else if (opcodeType == SCRIPTVAR_INTCONST) { // int constant
-                scriptEng.operands[i] = scriptCode[scriptCodePtr++];
-            }
-            else if (opcodeType == SCRIPTVAR_STRCONST) { // string constant
-                int strLen         = scriptCode[scriptCodePtr++];
-                scriptText[strLen] = 0;
-                for (int c = 0; c < strLen; ++c) {
-                    switch (c % 4) {
-                        case 0: scriptText[c] = scriptCode[scriptCodePtr] >> 24; break;
+                case VAR_PLAYERCOLLISIONBOTTOM: {
+                    AnimationFile *animFile = playerList[activePlayer].animationFile;
+                    Player *plr             = &playerList[activePlayer];
+                    if (animFile) {
+                        int h = animFrames[animationList[animFile->aniListOffset + plr->boundEntity->animation].frameListOffset
+                                           + plr->boundEntity->frame]
+                                    .hitboxID;
 
-                        case 1: scriptText[c] = (0xFFFFFF & scriptCode[scriptCodePtr]) >> 16; break;
-
-                        case 2: scriptText[c] = (0xFFFF & scriptCode[scriptCodePtr]) >> 8; break;
-
-                        case 3: scriptText[c] = scriptCode[scriptCodePtr++]; break;
-
-                        default: break;
+                        scriptEng.operands[i] = hitboxList[animFile->hitboxListOffset + h].bottom[0];
                     }
+                    else {
+                        scriptEng.operands[i] = 0;
+                    }
+                    break;
                 }
-                scriptCodePtr++;
-            }
-        }
-
-        ObjectScript *scriptInfo = &objectScriptList[objectEntityList[objectLoop].type];
-        Entity *entity           = &objectEntityList[objectLoop];
-        Player *player           = &playerList[activePlayer];
-        SpriteFrame *spriteFrame = nullptr;
-
-        // Functions
-        switch (opcode) {
-            default: break;
-            case FUNC_END: running = false; break;
-            case FUNC_EQUAL: scriptEng.operands[0] = scriptEng.operands[1]; break;
-            case FUNC_ADD: scriptEng.operands[0] += scriptEng.operands[1]; break;
-            case FUNC_SUB: scriptEng.operands[0] -= scriptEng.operands[1]; break;
-            case FUNC_INC: ++scriptEng.operands[0]; break;
-            case FUNC_DEC: --scriptEng.operands[0]; break;
-            case FUNC_MUL: scriptEng.operands[0] *= scriptEng.operands[1]; break;
-            case FUNC_DIV: scriptEng.operands[0] /= scriptEng.operands[1]; break;
-            case FUNC_SHR: scriptEng.operands[0] >>= scriptEng.operands[1]; break;
-            case FUNC_SHL: scriptEng.operands[0] <<= scriptEng.operands[1]; break;
-            case FUNC_AND: scriptEng.operands[0] &= scriptEng.operands[1]; break;
-            case FUNC_OR: scriptEng.operands[0] |= scriptEng.operands[1]; break;
-            case FUNC_XOR: scriptEng.operands[0] ^= scriptEng.operands[1]; break;
-            case FUNC_MOD: scriptEng.operands[0] %= scriptEng.operands[1]; break;
-            case FUNC_FLIPSIGN: scriptEng.operands[0] = -scriptEng.operands[0]; break;
-            case FUNC_CHECKEQUAL:
-                scriptEng.checkResult = scriptEng.operands[0] == scriptEng.operands[1];
-                opcodeSize            = 0;
-                break;
-            case FUNC_CHECKGREATER:
-                scriptEng.checkResult = scriptEng.operands[0] > scriptEng.operands[1];
-                opcodeSize            = 0;
-                break;
-            case FUNC_CHECKLOWER:
-                scriptEng.checkResult = scriptEng.operands[0] < scriptEng.operands[1];
-                opcodeSize            = 0;
-                break;
-            case FUNC_CHECKNOTEQUAL:
-                scriptEng.checkResult = scriptEng.operands[0] != scriptEng.operands[1];
-                opcodeSize            = 0;
-                break;
-            case FUNC_IFEQUAL:
-                if (scriptEng.operands[1] != scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
-                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize                          = 0;
-                break;
-            case FUNC_IFGREATER:
-                if (scriptEng.operands[1] <= scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
-                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize                          = 0;
-                break;
-            case FUNC_IFGREATEROREQUAL:
-                if (scriptEng.operands[1] < scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
-                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize                          = 0;
-                break;
-            case FUNC_IFLOWER:
-                if (scriptEng.operands[1] >= scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
-                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize                          = 0;
-                break;
-            case FUNC_IFLOWEROREQUAL:
-                if (scriptEng.operands[1] > scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
-                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize                          = 0;
-                break;
-            case FUNC_IFNOTEQUAL:
-                if (scriptEng.operands[1] == scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
-                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize                          = 0;
-                break;
-            case FUNC_ELSE:
-                opcodeSize    = 0;
-                scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + jumpTableStack[jumpTableStackPos--] + 1];
-                break;
-            case FUNC_ENDIF:
-                opcodeSize = 0;
-                --jumpTableStackPos;
-                break;
-            case FUNC_WEQUAL:
-                if (scriptEng.operands[1] != scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
-                else
-                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize = 0;
-                break;
-            case FUNC_WGREATER:
-                if (scriptEng.operands[1] <= scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
-                else
-                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize = 0;
-                break;
-            case FUNC_WGREATEROREQUAL:
-                if (scriptEng.operands[1] < scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
-                else
-                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize = 0;
-                break;
-            case FUNC_WLOWER:
-                if (scriptEng.operands[1] >= scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
-                else
-                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize = 0;
-                break;
-            case FUNC_WLOWEROREQUAL:
-                if (scriptEng.operands[1] > scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
-                else
-                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize = 0;
-                break;
-            case FUNC_WNOTEQUAL:
-                if (scriptEng.operands[1] == scriptEng.operands[2])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
-                else
-                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                opcodeSize = 0;
-                break;
-            case FUNC_LOOP:
-                opcodeSize    = 0;
-                scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + jumpTableStack[jumpTableStackPos--]];
-                break;
-            case FUNC_SWITCH:
-                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
-                if (scriptEng.operands[1] < jumpTable[jumpTableStart + scriptEng.operands[0]]
-                    || scriptEng.operands[1] > jumpTable[jumpTableStart + scriptEng.operands[0] + 1])
-                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 2];
-                else
-                    scriptCodePtr = scriptCodeStart
-                                    + jumpTable[jumpTableStart + scriptEng.operands[0] + 4
-                                                    + (scriptEng.operands[1] - jumpTable[jumpTableStart + scriptEng.operands[0]])];
-                opcodeSize = 0;
-                break;
-            case FUNC_BREAK:
-                opcodeSize    = 0;
-                scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + jumpTableStack[jumpTableStackPos--] + 3];
-                break;
-            case FUNC_ENDSWITCH:
-                opcodeSize = 0;
-                --jumpTableStackPos;
-                break;
-            case FUNC_RAND: scriptEng.operands[0] = rand() % scriptEng.operands[1]; break;
-            case FUNC_SIN: {
-                scriptEng.operands[0] = Sin512(scriptEng.operands[1]);
-                break;
-            }
-            case FUNC_COS: {
-                scriptEng.operands[0] = Cos512(scriptEng.operands[1]);
-                break;
-            }
-            case FUNC_SIN256: {
-                scriptEng.operands[0] = Sin256(scriptEng.operands[1]);
-                break;
-            }
-            case FUNC_COS256: {
-                scriptEng.operands[0] = Cos256(scriptEng.operands[1]);
-                break;
-            }
-            case FUNC_SINCHANGE: {
-                scriptEng.operands[0] = scriptEng.operands[3] + (Sin512(scriptEng.operands[1]) >> scriptEng.operands[2]) - scriptEng.operands[4];
-                break;
-            }
-            case FUNC_COSCHANGE: {
-                scriptEng.operands[0] = scriptEng.operands[3] + (Cos512(scriptEng.operands[1]) >> scriptEng.operands[2]) - scriptEng.operands[4];
-                break;
-            }
-            case FUNC_ATAN2: {
-                scriptEng.operands[0] = ArcTanLookup(scriptEng.operands[1], scriptEng.operands[2]);
-                break;
-            }
-            case FUNC_INTERPOLATE:
-                scriptEng.operands[0] =
-                    (scriptEng.operands[2] * (0x100 - scriptEng.operands[3]) + scriptEng.operands[3] * scriptEng.operands[1]) >> 8;
-                break;
-            case FUNC_INTERPOLATEXY:
-                scriptEng.operands[0] =
-                    (scriptEng.operands[3] * (0x100 - scriptEng.operands[6]) >> 8) + ((scriptEng.operands[6] * scriptEng.operands[2]) >> 8);
-                scriptEng.operands[1] =
-                    (scriptEng.operands[5] * (0x100 - scriptEng.operands[6]) >> 8) + (scriptEng.operands[6] * scriptEng.operands[4] >> 8);
-                break;
-            case FUNC_LOADSPRITESHEET:
-                opcodeSize                = 0;
-                scriptInfo->spriteSheetID = AddGraphicsFile(scriptText);
-                break;
-            case FUNC_REMOVESPRITESHEET:
-                opcodeSize = 0;
-                RemoveGraphicsFile(scriptText, -1);
-                break;
-            case FUNC_DRAWSPRITE:
-                opcodeSize  = 0;
-                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
-                DrawSprite((entity->XPos >> 16) - xScrollOffset + spriteFrame->pivotX, (entity->YPos >> 16) - yScrollOffset + spriteFrame->pivotY,
-                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                break;
-            case FUNC_DRAWSPRITEXY:
-                opcodeSize  = 0;
-                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
-                DrawSprite((scriptEng.operands[1] >> 16) - xScrollOffset + spriteFrame->pivotX,
-                           (scriptEng.operands[2] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width, spriteFrame->height,
-                           spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                break;
-            case FUNC_DRAWSPRITESCREENXY:
-                opcodeSize  = 0;
-                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
-                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY, spriteFrame->width,
-                           spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                break;
-            case FUNC_DRAWTINTRECT:
-                opcodeSize = 0;
-                DrawTintRectangle(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]);
-                break;
-            case FUNC_DRAWNUMBERS: {
-                opcodeSize = 0;
-                int i      = 10;
-                if (scriptEng.operands[6]) {
-                    while (scriptEng.operands[4] > 0) {
-                        int frameID = scriptEng.operands[3] % i / (i / 10) + scriptEng.operands[0];
-                        spriteFrame = &scriptFrames[scriptInfo->frameListOffset + frameID];
-                        DrawSprite(spriteFrame->pivotX + scriptEng.operands[1], spriteFrame->pivotY + scriptEng.operands[2], spriteFrame->width,
-                                   spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                        scriptEng.operands[1] -= scriptEng.operands[5];
-                        i *= 10;
-                        --scriptEng.operands[4];
-                    }
+                case VAR_PLAYERFLAILING: {
+                    scriptEng.operands[i] = playerList[activePlayer].flailing[arrayVal];
+                    break;
                 }
-                else {
-                    int extra = 10;
-                    if (scriptEng.operands[3])
-                        extra = 10 * scriptEng.operands[3];
-                    while (scriptEng.operands[4] > 0) {
-                        if (extra >= i) {
-                            int frameID = scriptEng.operands[3] % i / (i / 10) + scriptEng.operands[0];
-                            spriteFrame = &scriptFrames[scriptInfo->frameListOffset + frameID];
-                            DrawSprite(spriteFrame->pivotX + scriptEng.operands[1], spriteFrame->pivotY + scriptEng.operands[2], spriteFrame->width,
-                                       spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                        }
-                        scriptEng.operands[1] -= scriptEng.operands[5];
-                        i *= 10;
-                        --scriptEng.operands[4];
+                case VAR_PLAYERTIMER: {
+                    scriptEng.operands[i] = playerList[activePlayer].timer;
+                    break;
+                }
+                case VAR_PLAYERTILECOLLISIONS: {
+                    scriptEng.operands[i] = playerList[activePlayer].tileCollisions;
+                    break;
+                }
+                case VAR_PLAYEROBJECTINTERACTION: {
+                    scriptEng.operands[i] = playerList[activePlayer].objectInteractions;
+                    break;
+                }
+                case VAR_PLAYERVISIBLE: {
+                    scriptEng.operands[i] = playerList[activePlayer].visible;
+                    break;
+                }
+                case VAR_PLAYERROTATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->rotation;
+                    break;
+                }
+                case VAR_PLAYERSCALE: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->scale;
+                    break;
+                }
+                case VAR_PLAYERPRIORITY: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->priority;
+                    break;
+                }
+                case VAR_PLAYERDRAWORDER: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->drawOrder;
+                    break;
+                }
+                case VAR_PLAYERDIRECTION: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->direction;
+                    break;
+                }
+                case VAR_PLAYERINKEFFECT: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->inkEffect;
+                    break;
+                }
+                case VAR_PLAYERALPHA: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->alpha;
+                    break;
+                }
+                case VAR_PLAYERFRAME: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->frame;
+                    break;
+                }
+                case VAR_PLAYERANIMATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->animation;
+                    break;
+                }
+                case VAR_PLAYERPREVANIMATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->prevAnimation;
+                    break;
+                }
+                case VAR_PLAYERANIMATIONSPEED: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->animationSpeed;
+                    break;
+                }
+                case VAR_PLAYERANIMATIONTIMER: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->animationTimer;
+                    break;
+                }
+                case VAR_PLAYERVALUE0: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[0];
+                    break;
+                }
+                case VAR_PLAYERVALUE1: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[1];
+                    break;
+                }
+                case VAR_PLAYERVALUE2: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[2];
+                    break;
+                }
+                case VAR_PLAYERVALUE3: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[3];
+                    break;
+                }
+                case VAR_PLAYERVALUE4: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[4];
+                    break;
+                }
+                case VAR_PLAYERVALUE5: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[5];
+                    break;
+                }
+                case VAR_PLAYERVALUE6: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[6];
+                    break;
+                }
+                case VAR_PLAYERVALUE7: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[7];
+                    break;
+                }
+                case VAR_PLAYERVALUE8: {
+                    scriptEng.operands[i] = playerList[activePlayer].values[0];
+                    break;
+                }
+                case VAR_PLAYERVALUE9: {
+                    scriptEng.operands[i] = playerList[activePlayer].values[1];
+                    break;
+                }
+                case VAR_PLAYERVALUE10: {
+                    scriptEng.operands[i] = playerList[activePlayer].values[2];
+                    break;
+                }
+                case VAR_PLAYERVALUE11: {
+                    scriptEng.operands[i] = playerList[activePlayer].values[3];
+                    break;
+                }
+                case VAR_PLAYERVALUE12: {
+                    scriptEng.operands[i] = playerList[activePlayer].values[4];
+                    break;
+                }
+                case VAR_PLAYERVALUE13: {
+                    scriptEng.operands[i] = playerList[activePlayer].values[5];
+                    break;
+                }
+                case VAR_PLAYERVALUE14: {
+                    scriptEng.operands[i] = playerList[activePlayer].values[6];
+                    break;
+                }
+                case VAR_PLAYERVALUE15: {
+                    scriptEng.operands[i] = playerList[activePlayer].values[7];
+                    break;
+                }
+                case VAR_PLAYEROUTOFBOUNDS: {
+                    int pos = playerList[activePlayer].XPos >> 16;
+                    if (pos <= xScrollOffset - OBJECT_BORDER_X1 || pos >= OBJECT_BORDER_X2 + xScrollOffset) {
+                        scriptEng.operands[i] = 1;
                     }
+                    else {
+                        int pos               = playerList[activePlayer].YPos >> 16;
+                        scriptEng.operands[i] = pos <= yScrollOffset - OBJECT_BORDER_Y1 || pos >= yScrollOffset + OBJECT_BORDER_Y2;
+                    }
+                    break;
                 }
-                break;
+                case VAR_STAGESTATE: scriptEng.operands[i] = stageMode; break;
+                case VAR_STAGEACTIVELIST: scriptEng.operands[i] = activeStageList; break;
+                case VAR_STAGELISTPOS: scriptEng.operands[i] = stageListPosition; break;
+                case VAR_STAGETIMEENABLED: scriptEng.operands[i] = timeEnabled; break;
+                case VAR_STAGEMILLISECONDS: scriptEng.operands[i] = stageMilliseconds; break;
+                case VAR_STAGESECONDS: scriptEng.operands[i] = stageSeconds; break;
+                case VAR_STAGEMINUTES: scriptEng.operands[i] = stageMinutes; break;
+                case VAR_STAGEACTNO: scriptEng.operands[i] = actID; break;
+                case VAR_STAGEPAUSEENABLED: scriptEng.operands[i] = pauseEnabled; break;
+                case VAR_STAGELISTSIZE: scriptEng.operands[i] = stageListCount[activeStageList]; break;
+                case VAR_STAGENEWXBOUNDARY1: scriptEng.operands[i] = newXBoundary1; break;
+                case VAR_STAGENEWXBOUNDARY2: scriptEng.operands[i] = newXBoundary2; break;
+                case VAR_STAGENEWYBOUNDARY1: scriptEng.operands[i] = newYBoundary1; break;
+                case VAR_STAGENEWYBOUNDARY2: scriptEng.operands[i] = newYBoundary2; break;
+                case VAR_STAGEXBOUNDARY1: scriptEng.operands[i] = xBoundary1; break;
+                case VAR_STAGEXBOUNDARY2: scriptEng.operands[i] = xBoundary2; break;
+                case VAR_STAGEYBOUNDARY1: scriptEng.operands[i] = yBoundary1; break;
+                case VAR_STAGEYBOUNDARY2: scriptEng.operands[i] = yBoundary2; break;
+                case VAR_STAGEDEFORMATIONDATA0: scriptEng.operands[i] = bgDeformationData0[arrayVal]; break;
+                case VAR_STAGEDEFORMATIONDATA1: scriptEng.operands[i] = bgDeformationData1[arrayVal]; break;
+                case VAR_STAGEDEFORMATIONDATA2: scriptEng.operands[i] = bgDeformationData2[arrayVal]; break;
+                case VAR_STAGEDEFORMATIONDATA3: scriptEng.operands[i] = bgDeformationData3[arrayVal]; break;
+                case VAR_STAGEWATERLEVEL: scriptEng.operands[i] = waterLevel; break;
+                case VAR_STAGEACTIVELAYER: scriptEng.operands[i] = activeTileLayers[arrayVal]; break;
+                case VAR_STAGEMIDPOINT: scriptEng.operands[i] = tLayerMidPoint; break;
+                case VAR_STAGEPLAYERLISTPOS: scriptEng.operands[i] = playerListPos; break;
+                case VAR_STAGEACTIVEPLAYER: scriptEng.operands[i] = activePlayer; break;
+                case VAR_SCREENCAMERAENABLED: scriptEng.operands[i] = cameraEnabled; break;
+                case VAR_SCREENCAMERATARGET: scriptEng.operands[i] = cameraTarget; break;
+                case VAR_SCREENCAMERASTYLE: scriptEng.operands[i] = cameraStyle; break;
+                case VAR_SCREENDRAWLISTSIZE:
+                    SyncDrawLists(false);
+                    scriptEng.operands[i] = drawListEntries[arrayVal].listSize;
+                    break;
+                case VAR_SCREENCENTERX: scriptEng.operands[i] = SCREEN_CENTERX; break;
+                case VAR_SCREENCENTERY: scriptEng.operands[i] = SCREEN_CENTERY; break;
+                case VAR_SCREENXSIZE: scriptEng.operands[i] = SCREEN_XSIZE; break;
+                case VAR_SCREENYSIZE: scriptEng.operands[i] = SCREEN_YSIZE; break;
+                case VAR_SCREENXOFFSET: scriptEng.operands[i] = xScrollOffset; break;
+                case VAR_SCREENYOFFSET: scriptEng.operands[i] = yScrollOffset; break;
+                case VAR_SCREENSHAKEX: scriptEng.operands[i] = cameraShakeX; break;
+                case VAR_SCREENSHAKEY: scriptEng.operands[i] = cameraShakeY; break;
+                case VAR_SCREENADJUSTCAMERAY: scriptEng.operands[i] = cameraAdjustY; break;
+                case VAR_TOUCHSCREENDOWN: scriptEng.operands[i] = touchDown[arrayVal]; break;
+                case VAR_TOUCHSCREENXPOS: scriptEng.operands[i] = touchX[arrayVal]; break;
+                case VAR_TOUCHSCREENYPOS: scriptEng.operands[i] = touchY[arrayVal]; break;
+                case VAR_MUSICVOLUME: scriptEng.operands[i] = masterVolume; break;
+                case VAR_MUSICCURRENTTRACK: scriptEng.operands[i] = trackID; break;
+                case VAR_KEYDOWNUP: scriptEng.operands[i] = keyDown.up; break;
+                case VAR_KEYDOWNDOWN: scriptEng.operands[i] = keyDown.down; break;
+                case VAR_KEYDOWNLEFT: scriptEng.operands[i] = keyDown.left; break;
+                case VAR_KEYDOWNRIGHT: scriptEng.operands[i] = keyDown.right; break;
+                case VAR_KEYDOWNBUTTONA: scriptEng.operands[i] = keyDown.A; break;
+                case VAR_KEYDOWNBUTTONB: scriptEng.operands[i] = keyDown.B; break;
+                case VAR_KEYDOWNBUTTONC: scriptEng.operands[i] = keyDown.C; break;
+                case VAR_KEYDOWNSTART: scriptEng.operands[i] = keyDown.start; break;
+                case VAR_KEYPRESSUP: scriptEng.operands[i] = keyPress.up; break;
+                case VAR_KEYPRESSDOWN: scriptEng.operands[i] = keyPress.down; break;
+                case VAR_KEYPRESSLEFT: scriptEng.operands[i] = keyPress.left; break;
+                case VAR_KEYPRESSRIGHT: scriptEng.operands[i] = keyPress.right; break;
+                case VAR_KEYPRESSBUTTONA: scriptEng.operands[i] = keyPress.A; break;
+                case VAR_KEYPRESSBUTTONB: scriptEng.operands[i] = keyPress.B; break;
+                case VAR_KEYPRESSBUTTONC: scriptEng.operands[i] = keyPress.C; break;
+                case VAR_KEYPRESSSTART: scriptEng.operands[i] = keyPress.start; break;
+                case VAR_MENU1SELECTION: scriptEng.operands[i] = gameMenu[0].selection1; break;
+                case VAR_MENU2SELECTION: scriptEng.operands[i] = gameMenu[1].selection1; break;
+                case VAR_TILELAYERXSIZE: scriptEng.operands[i] = stageLayouts[arrayVal].xsize; break;
+                case VAR_TILELAYERYSIZE: scriptEng.operands[i] = stageLayouts[arrayVal].ysize; break;
+                case VAR_TILELAYERTYPE: scriptEng.operands[i] = stageLayouts[arrayVal].type; break;
+                case VAR_TILELAYERANGLE: scriptEng.operands[i] = stageLayouts[arrayVal].angle; break;
+                case VAR_TILELAYERXPOS: scriptEng.operands[i] = stageLayouts[arrayVal].XPos; break;
+                case VAR_TILELAYERYPOS: scriptEng.operands[i] = stageLayouts[arrayVal].YPos; break;
+                case VAR_TILELAYERZPOS: scriptEng.operands[i] = stageLayouts[arrayVal].ZPos; break;
+                case VAR_TILELAYERPARALLAXFACTOR: scriptEng.operands[i] = stageLayouts[arrayVal].parallaxFactor; break;
+                case VAR_TILELAYERSCROLLSPEED: scriptEng.operands[i] = stageLayouts[arrayVal].scrollSpeed; break;
+                case VAR_TILELAYERSCROLLPOS: scriptEng.operands[i] = stageLayouts[arrayVal].scrollPos; break;
+                case VAR_TILELAYERDEFORMATIONOFFSET: scriptEng.operands[i] = stageLayouts[arrayVal].deformationOffset; break;
+                case VAR_TILELAYERDEFORMATIONOFFSETW: scriptEng.operands[i] = stageLayouts[arrayVal].deformationOffsetW; break;
+                case VAR_HPARALLAXPARALLAXFACTOR: scriptEng.operands[i] = hParallax.parallaxFactor[arrayVal]; break;
+                case VAR_HPARALLAXSCROLLSPEED: scriptEng.operands[i] = hParallax.scrollSpeed[arrayVal]; break;
+                case VAR_HPARALLAXSCROLLPOS: scriptEng.operands[i] = hParallax.scrollPos[arrayVal]; break;
+                case VAR_VPARALLAXPARALLAXFACTOR: scriptEng.operands[i] = vParallax.parallaxFactor[arrayVal]; break;
+                case VAR_VPARALLAXSCROLLSPEED: scriptEng.operands[i] = vParallax.scrollSpeed[arrayVal]; break;
+                case VAR_VPARALLAXSCROLLPOS: scriptEng.operands[i] = vParallax.scrollPos[arrayVal]; break;
+                case VAR_3DSCENENOVERTICES: scriptEng.operands[i] = vertexCount; break;
+                case VAR_3DSCENENOFACES: scriptEng.operands[i] = faceCount; break;
+                case VAR_VERTEXBUFFERX: scriptEng.operands[i] = vertexBuffer[arrayVal].x; break;
+                case VAR_VERTEXBUFFERY: scriptEng.operands[i] = vertexBuffer[arrayVal].y; break;
+                case VAR_VERTEXBUFFERZ: scriptEng.operands[i] = vertexBuffer[arrayVal].z; break;
+                case VAR_VERTEXBUFFERU: scriptEng.operands[i] = vertexBuffer[arrayVal].u; break;
+                case VAR_VERTEXBUFFERV: scriptEng.operands[i] = vertexBuffer[arrayVal].v; break;
+                case VAR_FACEBUFFERA: scriptEng.operands[i] = faceBuffer[arrayVal].a; break;
+                case VAR_FACEBUFFERB: scriptEng.operands[i] = faceBuffer[arrayVal].b; break;
+                case VAR_FACEBUFFERC: scriptEng.operands[i] = faceBuffer[arrayVal].c; break;
+                case VAR_FACEBUFFERD: scriptEng.operands[i] = faceBuffer[arrayVal].d; break;
+                case VAR_FACEBUFFERFLAG: scriptEng.operands[i] = faceBuffer[arrayVal].flags; break;
+                case VAR_FACEBUFFERCOLOR: scriptEng.operands[i] = faceBuffer[arrayVal].colour; break;
+                case VAR_3DSCENEPROJECTIONX: scriptEng.operands[i] = projectionX; break;
+                case VAR_3DSCENEPROJECTIONY: scriptEng.operands[i] = projectionY; break;
+                case VAR_ENGINESTATE: scriptEng.operands[i] = Engine.gameMode; break;
+                case VAR_STAGEDEBUGMODE: scriptEng.operands[i] = debugMode; break;
+                case VAR_ENGINEMESSAGE: scriptEng.operands[i] = Engine.message; break;
+                case VAR_SAVERAM: scriptEng.operands[i] = saveRAM[arrayVal]; break;
+                case VAR_ENGINELANGUAGE: scriptEng.operands[i] = Engine.language; break;
+                case VAR_OBJECTSPRITESHEET: {
+                    scriptEng.operands[i] = objectScriptList[objectEntityList[arrayVal].type].spriteSheetID;
+                    break;
+                }
+                case VAR_ENGINEONLINEACTIVE: scriptEng.operands[i] = Engine.onlineActive; break;
+                case VAR_ENGINEFRAMESKIPTIMER: scriptEng.operands[i] = Engine.frameSkipTimer; break;
+                case VAR_ENGINEFRAMESKIPSETTING: scriptEng.operands[i] = Engine.frameSkipSetting; break;
+                case VAR_ENGINESFXVOLUME: scriptEng.operands[i] = sfxVolume; break;
+                case VAR_ENGINEBGMVOLUME: scriptEng.operands[i] = bgmVolume; break;
+                case VAR_ENGINEPLATFORMID: scriptEng.operands[i] = RETRO_GAMEPLATFORMID; break;
+                case VAR_ENGINETRIALMODE: scriptEng.operands[i] = Engine.trialMode; break;
+                case VAR_KEYPRESSANYSTART: scriptEng.operands[i] = anyPress; break;
+#if RETRO_USE_HAPTICS
+                case VAR_ENGINEHAPTICSENABLED: scriptEng.operands[i] = Engine.hapticsEnabled; break;
+#endif
             }
-            case FUNC_DRAWACTNAME: {
-                opcodeSize = 0;
-                int charID = 0;
+        }
+        else if (operand->type == SCRIPTVAR_INTCONST) { // int constant
+            scriptEng.operands[i] = operand->value;
+        }
+        else if (operand->type == SCRIPTVAR_STRCONST) { // string constant
+            if (operand->arrayType)
+                UnpackScriptString(operand->value, scriptText);
+            else
+                StrCopy(scriptText, &scriptStrings[operand->value]);
+        }
+    }
+}
 
-                switch (scriptEng.operands[3]) {
-                    default: break;
-                    case 0:                      // Draw Word 1 (but aligned from the right instead of left)
-                        charID = 0;
-                        for (charID = 0;; ++charID) {
-                            int nextChar = titleCardText[charID + 1];
-                            if (nextChar == '-' || !nextChar)
-                                break;
-                        }
-
-                        while (charID >= 0) {
-                            int character = titleCardText[charID];
-                            if (character == ' ')
-                                character = -1; // special space char
-                            if (character == '-')
-                                character = 0;
-                            if (character >= '0' && character <= '9')
-                                character -= 22;
-                            if (character > '9' && character < 'f')
-                                character -= 'A';
-
-                            if (character <= -1) {
-                                scriptEng.operands[1] -= scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
-                            }
-                            else {
-                                character += scriptEng.operands[0];
-                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
-
-                                scriptEng.operands[1] -= spriteFrame->width + scriptEng.operands[6];
-
-                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
-                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                            }
-                            charID--;
-                        }
-                        break;
-
-                    case 1: // Draw Word 1
-                        charID = 0;
-
-                        // Draw the first letter as a capital letter, the rest are lowercase (if scriptEng.operands[4] is true, otherwise they're all
-                        // uppercase)
-                        if (scriptEng.operands[4] == 1 && titleCardText[charID] != 0) {
-                            int character = titleCardText[charID];
-                            if (character == ' ')
-                                character = -1;
-                            if (character == '-')
-                                character = 0;
-                            if (character >= '0' && character <= '9')
-                                character -= 22;
-                            if (character > '9' && character < 'f')
-                                character -= 'A';
-
-                            if (character <= -1) {
-                                scriptEng.operands[1] += scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
-                            }
-                            else {
-                                character += scriptEng.operands[0];
-                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
-                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
-                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                                scriptEng.operands[1] += spriteFrame->width + scriptEng.operands[6];
-                            }
-
-                            scriptEng.operands[0] += 26;
-                            charID++;
-                        }
-
-                        while (titleCardText[charID] != 0 && titleCardText[charID] != '-') {
-                            int character = titleCardText[charID];
-                            if (character == ' ')
-                                character = -1;
-                            if (character == '-')
-                                character = 0;
-                            if (character > '/' && character < ':')
-                                character -= 22;
-                            if (character > '9' && character < 'f')
-                                character -= 'A';
-
-                            if (character <= -1) {
-                                scriptEng.operands[1] += scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
-                            }
-                            else {
-                                character += scriptEng.operands[0];
-                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
-                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
-                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                                scriptEng.operands[1] += spriteFrame->width + scriptEng.operands[6];
-                            }
-                            charID++;
-                        }
-                        break;
-
-                    case 2: // Draw Word 2
-                        charID = titleCardWord2;
-
-                        // Draw the first letter as a capital letter, the rest are lowercase (if scriptEng.operands[4] is true, otherwise they're all
-                        // uppercase)
-                        if (scriptEng.operands[4] == 1 && titleCardText[charID] != 0) {
-                            int character = titleCardText[charID];
-                            if (character == ' ')
-                                character = 0;
-                            if (character == '-')
-                                character = 0;
-                            if (character >= '0' && character <= '9')
-                                character -= 22;
-                            if (character > '9' && character < 'f')
-                                character -= 'A';
-
-                            if (character <= -1) {
-                                scriptEng.operands[1] += scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
-                            }
-                            else {
-                                character += scriptEng.operands[0];
-                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
-                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
-                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                                scriptEng.operands[1] += spriteFrame->width + scriptEng.operands[6];
-                            }
-                            scriptEng.operands[0] += 26;
-                            charID++;
-                        }
-
-                        while (titleCardText[charID] != 0) {
-                            int character = titleCardText[charID];
-                            if (character == ' ')
-                                character = -1;
-                            if (character == '-')
-                                character = 0;
-                            if (character >= '0' && character <= '9')
-                                character -= 22;
-                            if (character > '9' && character < 'f')
-                                character -= 'A';
+// Writes scriptEng.operands back to whatever variables the instruction's operands name
+inline void SetScriptOperands(ScriptOperand *operands, int opcodeSize)
+{
+    for (int i = 0; i < opcodeSize; ++i) {
+        ScriptOperand *operand = &operands[i];
+        if (operand->type == SCRIPTVAR_VAR) {
+            int arrayVal = GetOperandArrayValue(operand);
 
-                            if (character <= -1) {
-                                scriptEng.operands[1] += scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
-                            }
-                            else {
-                                character += scriptEng.operands[0];
-                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
-                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
-                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                                scriptEng.operands[1] += spriteFrame->width + scriptEng.operands[6];
-                            }
-                            charID++;
-                        }
-                        break;
+            // Variables
+            switch (operand->variable) {
+                default: break;
+                case VAR_TEMPVALUE0: scriptEng.tempValue[0] = scriptEng.operands[i]; break;
+                case VAR_TEMPVALUE1: scriptEng.tempValue[1] = scriptEng.operands[i]; break;
+                case VAR_TEMPVALUE2: scriptEng.tempValue[2] = scriptEng.operands[i]; break;
+                case VAR_TEMPVALUE3: scriptEng.tempValue[3] = scriptEng.operands[i]; break;
+                case VAR_TEMPVALUE4: scriptEng.tempValue[4] = scriptEng.operands[i]; break;
+                case VAR_TEMPVALUE5: scriptEng.tempValue[5] = scriptEng.operands[i]; break;
+                case VAR_TEMPVALUE6: scriptEng.tempValue[6] = scriptEng.operands[i]; break;
+                case VAR_TEMPVALUE7: scriptEng.tempValue[7] = scriptEng.operands[i]; break;
+                case VAR_CHECKRESULT: scriptEng.checkResult = scriptEng.operands[i]; break;
+                case VAR_ARRAYPOS0: scriptEng.arrayPosition[0] = scriptEng.operands[i]; break;
+                case VAR_ARRAYPOS1: scriptEng.arrayPosition[1] = scriptEng.operands[i]; break;
+                case VAR_GLOBAL: globalVariables[arrayVal] = scriptEng.operands[i]; break;
+                case VAR_OBJECTENTITYNO: break;
+                case VAR_OBJECTTYPE: {
+                    SetObjectEntityType(arrayVal, scriptEng.operands[i]);
+                    break;
+                }
+                case VAR_OBJECTPROPERTYVALUE: {
+                    objectEntityList[arrayVal].propertyValue = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTXPOS: {
+                    objectEntityList[arrayVal].XPos = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTYPOS: {
+                    objectEntityList[arrayVal].YPos = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTIXPOS: {
+                    objectEntityList[arrayVal].XPos = scriptEng.operands[i] << 16;
+                    break;
+                }
+                case VAR_OBJECTIYPOS: {
+                    objectEntityList[arrayVal].YPos = scriptEng.operands[i] << 16;
+                    break;
+                }
+                case VAR_OBJECTSTATE: {
+                    objectEntityList[arrayVal].state = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTROTATION: {
+                    objectEntityList[arrayVal].rotation = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTSCALE: {
+                    objectEntityList[arrayVal].scale = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTPRIORITY: {
+                    SetObjectEntityPriority(arrayVal, scriptEng.operands[i]);
+                    break;
+                }
+                case VAR_OBJECTDRAWORDER: {
+                    objectEntityList[arrayVal].drawOrder = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTDIRECTION: {
+                    objectEntityList[arrayVal].direction = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTINKEFFECT: {
+                    objectEntityList[arrayVal].inkEffect = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTALPHA: {
+                    objectEntityList[arrayVal].alpha = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTFRAME: {
+                    objectEntityList[arrayVal].frame = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTANIMATION: {
+                    objectEntityList[arrayVal].animation = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTPREVANIMATION: {
+                    objectEntityList[arrayVal].prevAnimation = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTANIMATIONSPEED: {
+                    objectEntityList[arrayVal].animationSpeed = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTANIMATIONTIMER: {
+                    objectEntityList[arrayVal].animationTimer = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTVALUE0: {
+                    objectEntityList[arrayVal].values[0] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTVALUE1: {
+                    objectEntityList[arrayVal].values[1] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTVALUE2: {
+                    objectEntityList[arrayVal].values[2] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTVALUE3: {
+                    objectEntityList[arrayVal].values[3] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTVALUE4: {
+                    objectEntityList[arrayVal].values[4] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTVALUE5: {
+                    objectEntityList[arrayVal].values[5] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTVALUE6: {
+                    objectEntityList[arrayVal].values[6] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTVALUE7: {
+                    objectEntityList[arrayVal].values[7] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_OBJECTOUTOFBOUNDS: break;
+                case VAR_PLAYERSTATE: {
+                    playerList[activePlayer].boundEntity->state = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERCONTROLMODE: {
+                    playerList[activePlayer].controlMode = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERCONTROLLOCK: {
+                    playerList[activePlayer].controlLock = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERCOLLISIONMODE: {
+                    playerList[activePlayer].collisionMode = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERCOLLISIONPLANE: {
+                    playerList[activePlayer].collisionPlane = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERXPOS: {
+                    playerList[activePlayer].XPos = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERYPOS: {
+                    playerList[activePlayer].YPos = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERIXPOS: {
+                    playerList[activePlayer].XPos = scriptEng.operands[i] << 16;
+                    break;
+                }
+                case VAR_PLAYERIYPOS: {
+                    playerList[activePlayer].YPos = scriptEng.operands[i] << 16;
+                    break;
+                }
+                case VAR_PLAYERSCREENXPOS: {
+                    playerList[activePlayer].screenXPos = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERSCREENYPOS: {
+                    playerList[activePlayer].screenYPos = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERSPEED: {
+                    playerList[activePlayer].speed = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERXVELOCITY: {
+                    playerList[activePlayer].XVelocity = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERYVELOCITY: {
+                    playerList[activePlayer].YVelocity = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERGRAVITY: {
+                    playerList[activePlayer].gravity = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERANGLE: {
+                    playerList[activePlayer].angle = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERSKIDDING: {
+                    playerList[activePlayer].skidding = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERPUSHING: {
+                    playerList[activePlayer].pushing = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERTRACKSCROLL: {
+                    playerList[activePlayer].trackScroll = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERUP: {
+                    playerList[activePlayer].up = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERDOWN: {
+                    playerList[activePlayer].down = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERLEFT: {
+                    playerList[activePlayer].left = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERRIGHT: {
+                    playerList[activePlayer].right = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERJUMPPRESS: {
+                    playerList[activePlayer].jumpPress = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERJUMPHOLD: {
+                    playerList[activePlayer].jumpHold = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERFOLLOWPLAYER1: {
+                    playerList[activePlayer].followPlayer1 = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERLOOKPOS: {
+                    playerList[activePlayer].lookPos = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERWATER: {
+                    playerList[activePlayer].water = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERTOPSPEED: {
+                    playerList[activePlayer].topSpeed = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERACCELERATION: {
+                    playerList[activePlayer].acceleration = scriptEng.operands[i];
+                    break;
                 }
-                break;
-            }
-            case FUNC_DRAWMENU:
-                opcodeSize        = 0;
-                textMenuSurfaceNo = scriptInfo->spriteSheetID;
-                DrawTextMenu(&gameMenu[scriptEng.operands[0]], scriptEng.operands[1], scriptEng.operands[2]);
-                break;
-            case FUNC_SPRITEFRAME:
-                opcodeSize = 0;
-                if (scriptSub == SUB_SETUP && scriptFrameCount < SPRITEFRAME_COUNT) {
-                    scriptFrames[scriptFrameCount].pivotX = scriptEng.operands[0];
-                    scriptFrames[scriptFrameCount].pivotY = scriptEng.operands[1];
-                    scriptFrames[scriptFrameCount].width  = scriptEng.operands[2];
-                    scriptFrames[scriptFrameCount].height = scriptEng.operands[3];
-                    scriptFrames[scriptFrameCount].sprX   = scriptEng.operands[4];
-                    scriptFrames[scriptFrameCount].sprY   = scriptEng.operands[5];
-                    ++scriptFrameCount;
+                case VAR_PLAYERDECELERATION: {
+                    playerList[activePlayer].deceleration = scriptEng.operands[i];
+                    break;
                 }
-                break;
-            case FUNC_EDITFRAME: {
-                if (scriptInfo->mobile) {
-                    opcodeSize  = 0;
-                    spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
-
-                    spriteFrame->pivotX = scriptEng.operands[1];
-                    spriteFrame->pivotY = scriptEng.operands[2];
-                    spriteFrame->width  = scriptEng.operands[3];
-                    spriteFrame->height = scriptEng.operands[4];
-                    spriteFrame->sprX   = scriptEng.operands[5];
-                    spriteFrame->sprY   = scriptEng.operands[6];
+                case VAR_PLAYERAIRACCELERATION: {
+                    playerList[activePlayer].airAcceleration = scriptEng.operands[i];
+                    break;
                 }
-                else {
-                    //"SetEditorIcon"
+                case VAR_PLAYERAIRDECELERATION: {
+                    playerList[activePlayer].airDeceleration = scriptEng.operands[i];
+                    break;
                 }
-            } break;
-            case FUNC_LOADPALETTE:
-                opcodeSize = 0;
-                LoadPalette(scriptText, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4]);
-                break;
-            case FUNC_ROTATEPALETTE:
-                opcodeSize = 0;
-                RotatePalette(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2]);
-                break;
-            case FUNC_SETSCREENFADE:
-                opcodeSize = 0;
-                SetFade(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]);
-                break;
-            case FUNC_SETACTIVEPALETTE:
-                opcodeSize = 0;
-                SetActivePalette(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2]);
-                break;
-            case FUNC_SETPALETTEFADE:
-                opcodeSize = 0;
-                SetLimitedFade(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4],
-                               scriptEng.operands[5], scriptEng.operands[6]);
-                break;
-            case FUNC_COPYPALETTE:
-                opcodeSize = 0;
-                CopyPalette(scriptEng.operands[0], scriptEng.operands[1]);
-                break;
-            case FUNC_CLEARSCREEN:
-                opcodeSize = 0;
-                ClearScreen(scriptEng.operands[0]);
-                break;
-            case FUNC_DRAWSPRITEFX:
-                opcodeSize  = 0;
-                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
-                switch (scriptEng.operands[1]) {
-                    default: break;
-                    case FX_SCALE:
-                        DrawSpriteScaled(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
-                                         (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY, entity->scale,
-                                         entity->scale, spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
-                                         scriptInfo->spriteSheetID);
-                        break;
-                    case FX_ROTATE:
-                        DrawSpriteRotated(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
-                                          (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY,
-                                          spriteFrame->sprX, spriteFrame->sprY, spriteFrame->width, spriteFrame->height, entity->rotation,
-                                          scriptInfo->spriteSheetID);
-                        break;
-                    case FX_ROTOZOOM:
-                        DrawSpriteRotozoom(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
-                                           (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY,
-                                           spriteFrame->sprX, spriteFrame->sprY, spriteFrame->width, spriteFrame->height, entity->rotation,
-                                           entity->scale, scriptInfo->spriteSheetID);
-                        break;
-                    case FX_INK:
-                        switch (entity->inkEffect) {
-                            case INK_NONE:
-                                DrawSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
-                                           (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
-                                           spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                                break;
-                            case INK_BLEND:
-                                DrawBlendedSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
-                                                  (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
-                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                                break;
-                            case INK_ALPHA:
-                                DrawAlphaBlendedSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
-                                                       (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
-                                                       spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, entity->alpha,
-                                                       scriptInfo->spriteSheetID);
-                                break;
-                            case INK_ADD:
-                                DrawAdditiveBlendedSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
-                                                          (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
-                                                          spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, entity->alpha,
-                                                          scriptInfo->spriteSheetID);
-                                break;
-                            case INK_SUB:
-                                DrawSubtractiveBlendedSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
-                                                             (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
-                                                             spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, entity->alpha,
-                                                             scriptInfo->spriteSheetID);
-                                break;
-                        }
-                        break;
-                    case FX_TINT:
-                        if (entity->inkEffect == INK_ALPHA) {
-                            DrawScaledTintMask(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
-                                               (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY,
-                                               entity->scale, entity->scale, spriteFrame->width, spriteFrame->height, spriteFrame->sprX,
-                                               spriteFrame->sprY, scriptInfo->spriteSheetID);
-                        }
-                        else {
-                            DrawSpriteScaled(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
-                                             (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY, entity->scale,
-                                             entity->scale, spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
-                                             scriptInfo->spriteSheetID);
-                        }
-                        break;
-                    case FX_FLIP:
-                        switch (entity->direction) {
-                            default:
-                            case FLIP_NONE:
-                                DrawSpriteFlipped((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
-                                                  (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
-                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_NONE, scriptInfo->spriteSheetID);
-                                break;
-                            case FLIP_X:
-                                DrawSpriteFlipped((scriptEng.operands[2] >> 16) - xScrollOffset - spriteFrame->width - spriteFrame->pivotX,
-                                                  (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
-                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_X, scriptInfo->spriteSheetID);
-                                break;
-                            case FLIP_Y:
-                                DrawSpriteFlipped((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
-                                                  (scriptEng.operands[3] >> 16) - yScrollOffset - spriteFrame->height - spriteFrame->pivotY,
-                                                  spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_Y,
-                                                  scriptInfo->spriteSheetID);
-                                break;
-                            case FLIP_XY:
-                                DrawSpriteFlipped((scriptEng.operands[2] >> 16) - xScrollOffset - spriteFrame->width - spriteFrame->pivotX,
-                                                  (scriptEng.operands[3] >> 16) - yScrollOffset - spriteFrame->height - spriteFrame->pivotY,
-                                                  spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_XY,
-                                                  scriptInfo->spriteSheetID);
-                                break;
-                        }
-                        break;
+                case VAR_PLAYERGRAVITYSTRENGTH: {
+                    playerList[activePlayer].gravityStrength = scriptEng.operands[i];
+                    break;
                 }
-                break;
-            case FUNC_DRAWSPRITESCREENFX:
-                opcodeSize  = 0;
-                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
-                switch (scriptEng.operands[1]) {
-                    default: break;
-                    case FX_SCALE:
-                        DrawSpriteScaled(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX, -spriteFrame->pivotY,
-                                         entity->scale, entity->scale, spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
-                                         scriptInfo->spriteSheetID);
-                        break;
-                    case FX_ROTATE:
-                        DrawSpriteRotated(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX, -spriteFrame->pivotY,
-                                          spriteFrame->sprX, spriteFrame->sprY, spriteFrame->width, spriteFrame->height, entity->rotation,
-                                          scriptInfo->spriteSheetID);
-                        break;
-                    case FX_ROTOZOOM:
-                        DrawSpriteRotozoom(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX,
-                                           -spriteFrame->pivotY, spriteFrame->sprX, spriteFrame->sprY, spriteFrame->width, spriteFrame->height,
-                                           entity->rotation, entity->scale, scriptInfo->spriteSheetID);
-                        break;
-                    case FX_INK:
-                        switch (entity->inkEffect) {
-                            case INK_NONE:
-                                DrawSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
-                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                                break;
-                            case INK_BLEND:
-                                DrawBlendedSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
-                                                  spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
-                                                  scriptInfo->spriteSheetID);
-                                break;
-                            case INK_ALPHA:
-                                DrawAlphaBlendedSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
-                                                       spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, entity->alpha,
-                                                       scriptInfo->spriteSheetID);
-                                break;
-                            case INK_ADD:
-                                DrawAdditiveBlendedSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
-                                                          spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
-                                                          entity->alpha, scriptInfo->spriteSheetID);
-                                break;
-                            case INK_SUB:
-                                DrawSubtractiveBlendedSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
-                                                             spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
-                                                             entity->alpha, scriptInfo->spriteSheetID);
-                                break;
-                        }
-                        break;
-                    case FX_TINT:
-                        if (entity->inkEffect == INK_ALPHA) {
-                            DrawScaledTintMask(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX,
-                                               -spriteFrame->pivotY, entity->scale, entity->scale, spriteFrame->width, spriteFrame->height,
-                                               spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                        }
-                        else {
-                            DrawSpriteScaled(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX,
-                                             -spriteFrame->pivotY, entity->scale, entity->scale, spriteFrame->width, spriteFrame->height,
-                                             spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
-                        }
-                        break;
-                    case FX_FLIP:
-                        switch (entity->direction) {
-                            default:
-                            case FLIP_NONE:
-                                DrawSpriteFlipped(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
-                                                  spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_NONE,
-                                                  scriptInfo->spriteSheetID);
-                                break;
-                            case FLIP_X:
-                                DrawSpriteFlipped(scriptEng.operands[2] - spriteFrame->width - spriteFrame->pivotX,
-                                                  scriptEng.operands[3] + spriteFrame->pivotY, spriteFrame->width, spriteFrame->height,
-                                                  spriteFrame->sprX, spriteFrame->sprY, FLIP_X, scriptInfo->spriteSheetID);
-                                break;
-                            case FLIP_Y:
-                                DrawSpriteFlipped(scriptEng.operands[2] + spriteFrame->pivotX,
-                                                  scriptEng.operands[3] - spriteFrame->height - spriteFrame->pivotY, spriteFrame->width,
-                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_Y, scriptInfo->spriteSheetID);
-                                break;
-                            case FLIP_XY:
-                                DrawSpriteFlipped(scriptEng.operands[2] - spriteFrame->width - spriteFrame->pivotX,
-                                                  scriptEng.operands[3] - spriteFrame->height - spriteFrame->pivotY, spriteFrame->width,
-                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_XY, scriptInfo->spriteSheetID);
-                                break;
-                        }
-                        break;
+                case VAR_PLAYERJUMPSTRENGTH: {
+                    playerList[activePlayer].jumpStrength = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERJUMPCAP: {
+                    playerList[activePlayer].jumpCap = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERROLLINGACCELERATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].rollingAcceleration = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERROLLINGDECELERATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].rollingDeceleration = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERENTITYNO: break;
+                case VAR_PLAYERCOLLISIONLEFT: break;
+                case VAR_PLAYERCOLLISIONTOP: break;
+                case VAR_PLAYERCOLLISIONRIGHT: break;
+                case VAR_PLAYERCOLLISIONBOTTOM: break;
+                case VAR_PLAYERFLAILING: {
+                    scriptEng.operands[i] = playerList[activePlayer].flailing[arrayVal] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERTIMER: {
+                    playerList[activePlayer].timer = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERTILECOLLISIONS: {
+                    playerList[activePlayer].tileCollisions = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYEROBJECTINTERACTION: {
+                    scriptEng.operands[i] = playerList[activePlayer].objectInteractions = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVISIBLE: {
+                    playerList[activePlayer].visible = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERROTATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->rotation = scriptEng.operands[i];
+                    break;
                 }
-                break;
-            case FUNC_LOADANIMATION:
-                opcodeSize           = 0;
-                scriptInfo->animFile = AddAnimationFile(scriptText);
-                break;
-            case FUNC_SETUPMENU: {
-                opcodeSize     = 0;
-                TextMenu *menu = &gameMenu[scriptEng.operands[0]];
-                SetupTextMenu(menu, scriptEng.operands[1]);
-                menu->selectionCount = scriptEng.operands[2];
-                menu->alignment      = scriptEng.operands[3];
-                break;
-            }
-            case FUNC_ADDMENUENTRY: {
-                opcodeSize                           = 0;
-                TextMenu *menu                       = &gameMenu[scriptEng.operands[0]];
-                menu->entryHighlight[menu->rowCount] = scriptEng.operands[2];
-                AddTextMenuEntry(menu, scriptText);
-                break;
-            }
-            case FUNC_EDITMENUENTRY: {
-                opcodeSize     = 0;
-                TextMenu *menu = &gameMenu[scriptEng.operands[0]];
-                EditTextMenuEntry(menu, scriptText, scriptEng.operands[2]);
-                menu->entryHighlight[scriptEng.operands[2]] = scriptEng.operands[3];
-                break;
-            }
-            case FUNC_LOADSTAGE:
-                opcodeSize = 0;
-                stageMode  = STAGEMODE_LOAD;
-                break;
-            case FUNC_DRAWRECT:
-                opcodeSize = 0;
-                DrawRectangle(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4],
-                              scriptEng.operands[5], scriptEng.operands[6], scriptEng.operands[7]);
-                break;
-            case FUNC_RESETOBJECTENTITY: {
-                opcodeSize            = 0;
-                Entity *newEnt        = &objectEntityList[scriptEng.operands[0]];
-                newEnt->type          = scriptEng.operands[1];
-                newEnt->propertyValue = scriptEng.operands[2];
-                newEnt->XPos          = scriptEng.operands[3];
-                newEnt->YPos          = scriptEng.operands[4];
-                newEnt->direction     = FLIP_NONE;
-                newEnt->frame         = 0;
-                newEnt->priority      = PRIORITY_BOUNDS;
-                newEnt->rotation      = 0;
-                newEnt->state         = 0;
-                newEnt->drawOrder     = 3;
-                newEnt->scale         = 0x200;
-                newEnt->inkEffect     = INK_NONE;
-                newEnt->values[0]     = 0;
-                newEnt->values[1]     = 0;
-                newEnt->values[2]     = 0;
-                newEnt->values[3]     = 0;
-                newEnt->values[4]     = 0;
-                newEnt->values[5]     = 0;
-                newEnt->values[6]     = 0;
-                newEnt->values[7]     = 0;
-                break;
-            }
-            case FUNC_PLAYEROBJECTCOLLISION:
-                opcodeSize              = 0;
-                switch (scriptEng.operands[0]) {
-                    default: break;
-                    case C_TOUCH:
-                        scriptEng.operands[5] = entity->XPos >> 16;
-                        scriptEng.operands[6] = entity->YPos >> 16;
-                        TouchCollision(scriptEng.operands[5] + scriptEng.operands[1], scriptEng.operands[6] + scriptEng.operands[2],
-                                       scriptEng.operands[5] + scriptEng.operands[3], scriptEng.operands[6] + scriptEng.operands[4]);
-                        break;
-                    case C_BOX:
-                        BoxCollision(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
-                                     entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
-                        break;
-                    case C_BOX2:
-                        // C_PLATFORM if pc ver, as there's no box2 there
-                        if (!scriptInfo->mobile) {
-                            PlatformCollision(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
-                                              entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
-                        }
-                        else {
-                            BoxCollision2(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
-                                          entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
-                        }
-                        break;
-                    case C_PLATFORM:
-                        if (scriptInfo->mobile) {
-                            PlatformCollision(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
-                                              entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
-                        }
-                        break;
-                    case C_BOX3:
-                        BoxCollision3(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
-                                      entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
-                        break;
-                    case C_ENEMY:
-                        scriptEng.operands[5] = entity->XPos >> 16;
-                        scriptEng.operands[6] = entity->YPos >> 16;
-                        EnemyCollision(scriptEng.operands[5] + scriptEng.operands[1], scriptEng.operands[6] + scriptEng.operands[2],
-                                      scriptEng.operands[5] + scriptEng.operands[3], scriptEng.operands[6] + scriptEng.operands[4]);
-                        break;
+                case VAR_PLAYERSCALE: {
+                    playerList[activePlayer].boundEntity->scale = scriptEng.operands[i];
+                    break;
                 }
-                break;
-            case FUNC_CREATETEMPOBJECT: {
-                opcodeSize = 0;
-                if (objectEntityList[scriptEng.arrayPosition[2]].type > 0 && ++scriptEng.arrayPosition[2] == ENTITY_COUNT)
-                    scriptEng.arrayPosition[2] = TEMPENTITY_START;
-                Entity *temp         = &objectEntityList[scriptEng.arrayPosition[2]];
-                temp->type           = scriptEng.operands[0];
-                temp->propertyValue  = scriptEng.operands[1];
-                temp->XPos           = scriptEng.operands[2];
-                temp->YPos           = scriptEng.operands[3];
-                temp->direction      = FLIP_NONE;
-                temp->frame          = 0;
-                temp->priority       = PRIORITY_ACTIVE;
-                temp->rotation       = 0;
-                temp->state          = 0;
-                temp->drawOrder      = 3;
-                temp->scale          = 512;
-                temp->inkEffect      = INK_NONE;
-                temp->alpha          = 0;
-                temp->animation      = 0;
-                temp->prevAnimation  = 0;
-                temp->animationSpeed = 0;
-                temp->animationTimer = 0;
-                temp->values[0]      = 0;
-                temp->values[1]      = 0;
-                temp->values[2]      = 0;
-                temp->values[3]      = 0;
-                temp->values[4]      = 0;
-                temp->values[5]      = 0;
-                temp->values[6]      = 0;
-                temp->values[7]      = 0;
-                break;
-            }
-            case FUNC_BINDPLAYERTOOBJECT: {
-                opcodeSize   = 0;
-                Entity *pEnt = &objectEntityList[scriptEng.operands[1]];
-
-                playerList[scriptEng.operands[0]].animationFile = scriptInfo->animFile;
-                playerList[scriptEng.operands[0]].boundEntity   = pEnt;
-                playerList[scriptEng.operands[0]].entityNo      = scriptEng.operands[1];
-                break;
-            }
-            case FUNC_PLAYERTILECOLLISION:
-                opcodeSize = 0;
-                if (player->tileCollisions) {
-                    ProcessPlayerTileCollisions(player);
+                case VAR_PLAYERPRIORITY: {
+                    SetObjectEntityPriority((int)(playerList[activePlayer].boundEntity - objectEntityList), scriptEng.operands[i]);
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->priority;
+                    break;
                 }
-                else {
-                    player->XPos += player->XVelocity;
-                    player->YPos += player->YVelocity;
+                case VAR_PLAYERDRAWORDER: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->drawOrder = scriptEng.operands[i];
+                    break;
                 }
-                break;
-            case FUNC_PROCESSPLAYERCONTROL:
-                opcodeSize = 0;
-                ProcessPlayerControl(player);
-                break;
-            case FUNC_PROCESSANIMATION:
-                ProcessObjectAnimation(scriptInfo, entity);
-                opcodeSize = 0;
-                break;
-            case FUNC_DRAWOBJECTANIMATION:
-                opcodeSize = 0;
-                DrawObjectAnimation(scriptInfo, entity, (entity->XPos >> 16) - xScrollOffset, (entity->YPos >> 16) - yScrollOffset);
-                break;
-            case FUNC_DRAWPLAYERANIMATION:
-                opcodeSize = 0;
-                if (player->visible) {
-                    if (cameraTarget == activePlayer)
-                        DrawObjectAnimation(scriptInfo, entity, player->screenXPos, player->screenYPos);
-                    else
-                        DrawObjectAnimation(scriptInfo, entity, (player->XPos >> 16) - xScrollOffset, (player->YPos >> 16) - yScrollOffset);
+                case VAR_PLAYERDIRECTION: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->direction = scriptEng.operands[i];
+                    break;
                 }
-                break;
-            case FUNC_SETMUSICTRACK:
-                opcodeSize = 0;
-                if (scriptEng.operands[2] <= 1)
-                    SetMusicTrack(scriptText, scriptEng.operands[1], scriptEng.operands[2], 0);
-                else
-                    SetMusicTrack(scriptText, scriptEng.operands[1], true, scriptEng.operands[2]);
-                break;
-            case FUNC_PLAYMUSIC:
-                opcodeSize = 0;
-                PlayMusic(scriptEng.operands[0]);
-                break;
-            case FUNC_STOPMUSIC:
-                opcodeSize = 0;
-                StopMusic();
-                break;
-            case FUNC_PLAYSFX:
-                opcodeSize = 0;
-                PlaySfx(scriptEng.operands[0], scriptEng.operands[1]);
-                break;
-            case FUNC_STOPSFX:
-                opcodeSize = 0;
-                StopSfx(scriptEng.operands[0]);
-                break;
-            case FUNC_SETSFXATTRIBUTES:
-                opcodeSize = 0;
-                SetSfxAttributes(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2]);
-                break;
-            case FUNC_OBJECTTILECOLLISION:
-                opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    default: break;
-                    case CSIDE_FLOOR: ObjectFloorCollision(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case CSIDE_LWALL: ObjectLWallCollision(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case CSIDE_RWALL: ObjectRWallCollision(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case CSIDE_ROOF: ObjectRoofCollision(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                case VAR_PLAYERINKEFFECT: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->inkEffect = scriptEng.operands[i];
+                    break;
                 }
-                break;
-            case FUNC_OBJECTTILEGRIP:
-                opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    default: break;
-                    case CSIDE_FLOOR: ObjectFloorGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case CSIDE_LWALL: ObjectLWallGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case CSIDE_RWALL: ObjectRWallGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case CSIDE_ROOF: ObjectRoofGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case CSIDE_ENTITY: ObjectEntityGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                case VAR_PLAYERALPHA: {
+                    playerList[activePlayer].boundEntity->alpha = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERFRAME: {
+                    playerList[activePlayer].boundEntity->frame = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERANIMATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->animation = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERPREVANIMATION: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->prevAnimation = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERANIMATIONSPEED: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->animationSpeed = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERANIMATIONTIMER: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->animationTimer = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE0: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[0] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE1: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[1] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE2: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[2] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE3: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[3] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE4: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[4] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE5: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[5] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE6: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[6] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE7: {
+                    scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[7] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE8: {
+                    playerList[activePlayer].values[0] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE9: {
+                    playerList[activePlayer].values[1] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE10: {
+                    playerList[activePlayer].values[2] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE11: {
+                    playerList[activePlayer].values[3] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE12: {
+                    playerList[activePlayer].values[4] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE13: {
+                    playerList[activePlayer].values[5] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE14: {
+                    playerList[activePlayer].values[6] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYERVALUE15: {
+                    playerList[activePlayer].values[7] = scriptEng.operands[i];
+                    break;
+                }
+                case VAR_PLAYEROUTOFBOUNDS: break;
+                case VAR_STAGESTATE: stageMode = scriptEng.operands[i]; break;
+                case VAR_STAGEACTIVELIST: activeStageList = scriptEng.operands[i]; break;
+                case VAR_STAGELISTPOS: stageListPosition = scriptEng.operands[i]; break;
+                case VAR_STAGETIMEENABLED: timeEnabled = scriptEng.operands[i]; break;
+                case VAR_STAGEMILLISECONDS: stageMilliseconds = scriptEng.operands[i]; break;
+                case VAR_STAGESECONDS: stageSeconds = scriptEng.operands[i]; break;
+                case VAR_STAGEMINUTES: stageMinutes = scriptEng.operands[i]; break;
+                case VAR_STAGEACTNO: actID = scriptEng.operands[i]; break;
+                case VAR_STAGEPAUSEENABLED: pauseEnabled = scriptEng.operands[i]; break;
+                case VAR_STAGELISTSIZE: break;
+                case VAR_STAGENEWXBOUNDARY1: newXBoundary1 = scriptEng.operands[i]; break;
+                case VAR_STAGENEWXBOUNDARY2: newXBoundary2 = scriptEng.operands[i]; break;
+                case VAR_STAGENEWYBOUNDARY1: newYBoundary1 = scriptEng.operands[i]; break;
+                case VAR_STAGENEWYBOUNDARY2: newYBoundary2 = scriptEng.operands[i]; break;
+                case VAR_STAGEXBOUNDARY1:
+                    if (xBoundary1 != scriptEng.operands[i]) {
+                        xBoundary1    = scriptEng.operands[i];
+                        newXBoundary1 = scriptEng.operands[i];
+                    }
+                    break;
+                case VAR_STAGEXBOUNDARY2:
+                    if (xBoundary2 != scriptEng.operands[i]) {
+                        xBoundary2    = scriptEng.operands[i];
+                        newXBoundary2 = scriptEng.operands[i];
+                    }
+                    break;
+                case VAR_STAGEYBOUNDARY1:
+                    if (yBoundary1 != scriptEng.operands[i]) {
+                        yBoundary1    = scriptEng.operands[i];
+                        newYBoundary1 = scriptEng.operands[i];
+                    }
+                    break;
+                case VAR_STAGEYBOUNDARY2:
+                    if (yBoundary2 != scriptEng.operands[i]) {
+                        yBoundary2    = scriptEng.operands[i];
+                        newYBoundary2 = scriptEng.operands[i];
+                    }
+                    break;
+                case VAR_STAGEDEFORMATIONDATA0:
+                    FlushDrawCommands(); // queued layer draws may still be reading it
+                    bgDeformationData0[arrayVal] = scriptEng.operands[i];
+                    break;
+                case VAR_STAGEDEFORMATIONDATA1:
+                    FlushDrawCommands();
+                    bgDeformationData1[arrayVal] = scriptEng.operands[i];
+                    break;
+                case VAR_STAGEDEFORMATIONDATA2:
+                    FlushDrawCommands();
+                    bgDeformationData2[arrayVal] = scriptEng.operands[i];
+                    break;
+                case VAR_STAGEDEFORMATIONDATA3:
+                    FlushDrawCommands();
+                    bgDeformationData3[arrayVal] = scriptEng.operands[i];
+                    break;
+                case VAR_STAGEWATERLEVEL: waterLevel = scriptEng.operands[i]; break;
+                case VAR_STAGEACTIVELAYER: activeTileLayers[arrayVal] = scriptEng.operands[i]; break;
+                case VAR_STAGEMIDPOINT: tLayerMidPoint = scriptEng.operands[i]; break;
+                case VAR_STAGEPLAYERLISTPOS: playerListPos = scriptEng.operands[i]; break;
+                case VAR_STAGEACTIVEPLAYER:
+                    activePlayer = scriptEng.operands[i];
+                    if (activePlayer > activePlayerCount)
+                        activePlayer = 0;
+                    break;
+                case VAR_SCREENCAMERAENABLED: cameraEnabled = scriptEng.operands[i]; break;
+                case VAR_SCREENCAMERATARGET: cameraTarget = scriptEng.operands[i]; break;
+                case VAR_SCREENCAMERASTYLE: cameraStyle = scriptEng.operands[i]; break;
+                case VAR_SCREENDRAWLISTSIZE:
+                    SyncDrawLists(true);
+                    drawListEntries[arrayVal].listSize = scriptEng.operands[i];
+                    break;
+                case VAR_SCREENCENTERX: break;
+                case VAR_SCREENCENTERY: break;
+                case VAR_SCREENXSIZE: break;
+                case VAR_SCREENYSIZE: break;
+                case VAR_SCREENXOFFSET:
+                    xScrollOffset = scriptEng.operands[i];
+                    xScrollA      = xScrollOffset;
+                    xScrollB      = SCREEN_XSIZE + xScrollOffset;
+                    break;
+                case VAR_SCREENYOFFSET:
+                    yScrollOffset = scriptEng.operands[i];
+                    yScrollA      = yScrollOffset;
+                    yScrollB      = SCREEN_YSIZE + yScrollOffset;
+                    break;
+                case VAR_SCREENSHAKEX: cameraShakeX = scriptEng.operands[i]; break;
+                case VAR_SCREENSHAKEY: cameraShakeY = scriptEng.operands[i]; break;
+                case VAR_SCREENADJUSTCAMERAY: cameraAdjustY = scriptEng.operands[i]; break;
+                case VAR_TOUCHSCREENDOWN: break;
+                case VAR_TOUCHSCREENXPOS: break;
+                case VAR_TOUCHSCREENYPOS: break;
+                case VAR_MUSICVOLUME: SetMusicVolume(scriptEng.operands[i]); break;
+                case VAR_MUSICCURRENTTRACK: break;
+                case VAR_KEYDOWNUP: keyDown.up = scriptEng.operands[i]; break;
+                case VAR_KEYDOWNDOWN: keyDown.down = scriptEng.operands[i]; break;
+                case VAR_KEYDOWNLEFT: keyDown.left = scriptEng.operands[i]; break;
+                case VAR_KEYDOWNRIGHT: keyDown.right = scriptEng.operands[i]; break;
+                case VAR_KEYDOWNBUTTONA: keyDown.A = scriptEng.operands[i]; break;
+                case VAR_KEYDOWNBUTTONB: keyDown.B = scriptEng.operands[i]; break;
+                case VAR_KEYDOWNBUTTONC: keyDown.C = scriptEng.operands[i]; break;
+                case VAR_KEYDOWNSTART: keyDown.start = scriptEng.operands[i]; break;
+                case VAR_KEYPRESSUP: keyPress.up = scriptEng.operands[i]; break;
+                case VAR_KEYPRESSDOWN: keyPress.down = scriptEng.operands[i]; break;
+                case VAR_KEYPRESSLEFT: keyPress.left = scriptEng.operands[i]; break;
+                case VAR_KEYPRESSRIGHT: keyPress.right = scriptEng.operands[i]; break;
+                case VAR_KEYPRESSBUTTONA: keyPress.A = scriptEng.operands[i]; break;
+                case VAR_KEYPRESSBUTTONB: keyPress.B = scriptEng.operands[i]; break;
+                case VAR_KEYPRESSBUTTONC: keyPress.C = scriptEng.operands[i]; break;
+                case VAR_KEYPRESSSTART: keyPress.start = scriptEng.operands[i]; break;
+                case VAR_MENU1SELECTION: gameMenu[0].selection1 = scriptEng.operands[i]; break;
+                case VAR_MENU2SELECTION: gameMenu[1].selection1 = scriptEng.operands[i]; break;
+                case VAR_TILELAYERXSIZE: stageLayouts[arrayVal].xsize = scriptEng.operands[i]; break;
+                case VAR_TILELAYERYSIZE: stageLayouts[arrayVal].ysize = scriptEng.operands[i]; break;
+                case VAR_TILELAYERTYPE: stageLayouts[arrayVal].type = scriptEng.operands[i]; break;
+                case VAR_TILELAYERANGLE:
+                    stageLayouts[arrayVal].angle = scriptEng.operands[i];
+                    if (stageLayouts[arrayVal].angle < 0)
+                        stageLayouts[arrayVal].angle += 0x200;
+                    stageLayouts[arrayVal].angle &= 0x1FFu;
+                    break;
+                case VAR_TILELAYERXPOS: stageLayouts[arrayVal].XPos = scriptEng.operands[i]; break;
+                case VAR_TILELAYERYPOS: stageLayouts[arrayVal].YPos = scriptEng.operands[i]; break;
+                case VAR_TILELAYERZPOS: stageLayouts[arrayVal].ZPos = scriptEng.operands[i]; break;
+                case VAR_TILELAYERPARALLAXFACTOR: stageLayouts[arrayVal].parallaxFactor = scriptEng.operands[i]; break;
+                case VAR_TILELAYERSCROLLSPEED: stageLayouts[arrayVal].scrollSpeed = scriptEng.operands[i]; break;
+                case VAR_TILELAYERSCROLLPOS: stageLayouts[arrayVal].scrollPos = scriptEng.operands[i]; break;
+                case VAR_TILELAYERDEFORMATIONOFFSET:
+                    stageLayouts[arrayVal].deformationOffset = scriptEng.operands[i];
+                    stageLayouts[arrayVal].deformationOffset &= 0xFFu;
+                    break;
+                case VAR_TILELAYERDEFORMATIONOFFSETW:
+                    stageLayouts[arrayVal].deformationOffsetW = scriptEng.operands[i];
+                    stageLayouts[arrayVal].deformationOffsetW &= 0xFFu;
+                    break;
+                case VAR_HPARALLAXPARALLAXFACTOR: hParallax.parallaxFactor[arrayVal] = scriptEng.operands[i]; break;
+                case VAR_HPARALLAXSCROLLSPEED: hParallax.scrollSpeed[arrayVal] = scriptEng.operands[i]; break;
+                case VAR_HPARALLAXSCROLLPOS: hParallax.scrollPos[arrayVal] = scriptEng.operands[i]; break;
+                case VAR_VPARALLAXPARALLAXFACTOR: vParallax.parallaxFactor[arrayVal] = scriptEng.operands[i]; break;
+                case VAR_VPARALLAXSCROLLSPEED: vParallax.scrollSpeed[arrayVal] = scriptEng.operands[i]; break;
+                case VAR_VPARALLAXSCROLLPOS: vParallax.scrollPos[arrayVal] = scriptEng.operands[i]; break;
+                case VAR_3DSCENENOVERTICES: vertexCount = scriptEng.operands[i]; break;
+                case VAR_3DSCENENOFACES: faceCount = scriptEng.operands[i]; break;
+                case VAR_VERTEXBUFFERX: vertexBuffer[arrayVal].x = scriptEng.operands[i]; break;
+                case VAR_VERTEXBUFFERY: vertexBuffer[arrayVal].y = scriptEng.operands[i]; break;
+                case VAR_VERTEXBUFFERZ: vertexBuffer[arrayVal].z = scriptEng.operands[i]; break;
+                case VAR_VERTEXBUFFERU: vertexBuffer[arrayVal].u = scriptEng.operands[i]; break;
+                case VAR_VERTEXBUFFERV: vertexBuffer[arrayVal].v = scriptEng.operands[i]; break;
+                case VAR_FACEBUFFERA: faceBuffer[arrayVal].a = scriptEng.operands[i]; break;
+                case VAR_FACEBUFFERB: faceBuffer[arrayVal].b = scriptEng.operands[i]; break;
+                case VAR_FACEBUFFERC: faceBuffer[arrayVal].c = scriptEng.operands[i]; break;
+                case VAR_FACEBUFFERD: faceBuffer[arrayVal].d = scriptEng.operands[i]; break;
+                case VAR_FACEBUFFERFLAG: faceBuffer[arrayVal].flags = scriptEng.operands[i]; break;
+                case VAR_FACEBUFFERCOLOR: faceBuffer[arrayVal].colour = scriptEng.operands[i]; break;
+                case VAR_3DSCENEPROJECTIONX: projectionX = scriptEng.operands[i]; break;
+                case VAR_3DSCENEPROJECTIONY: projectionY = scriptEng.operands[i]; break;
+                case VAR_ENGINESTATE: Engine.gameMode = scriptEng.operands[i]; break;
+                case VAR_STAGEDEBUGMODE: debugMode = scriptEng.operands[i]; break;
+                case VAR_ENGINEMESSAGE: break;
+                case VAR_SAVERAM: saveRAM[arrayVal] = scriptEng.operands[i]; break;
+                case VAR_ENGINELANGUAGE: Engine.language = scriptEng.operands[i]; break;
+                case VAR_OBJECTSPRITESHEET: {
+                    objectScriptList[objectEntityList[arrayVal].type].spriteSheetID = scriptEng.operands[i];
+                    break;
                 }
-                break;
-            case FUNC_LOADVIDEO:
+                case VAR_ENGINEONLINEACTIVE: break;
+                case VAR_ENGINEFRAMESKIPTIMER: Engine.frameSkipTimer = scriptEng.operands[i]; break;
+                case VAR_ENGINEFRAMESKIPSETTING: Engine.frameSkipSetting = scriptEng.operands[i]; break;
+                case VAR_ENGINESFXVOLUME:
+                    sfxVolume = scriptEng.operands[i];
+                    if (sfxVolume < 0)
+                        sfxVolume = 0;
+                    if (sfxVolume > MAX_VOLUME)
+                        sfxVolume = MAX_VOLUME;
+                    break;
+                case VAR_ENGINEBGMVOLUME:
+                    bgmVolume = scriptEng.operands[i];
+                    if (bgmVolume < 0)
+                        bgmVolume = 0;
+                    if (bgmVolume > MAX_VOLUME)
+                        bgmVolume = MAX_VOLUME;
+                    break;
+                case VAR_ENGINEPLATFORMID: break;
+                case VAR_ENGINETRIALMODE: break;
+                case VAR_KEYPRESSANYSTART: break;
+#if RETRO_USE_HAPTICS
+                case VAR_ENGINEHAPTICSENABLED: Engine.hapticsEnabled = scriptEng.operands[i]; break;
+#endif
+            }
+        }
+    }
+}
+
+// Fetches the instruction at scriptCodePtr & reads its operands, leaving scriptCodePtr on the instruction after it
+inline ScriptOperand *FetchScriptInstruction(int *scriptCodePtr, ScriptOperand *buffer)
+{
+#if RETRO_USE_SCRIPT_PROFILER
+    ++scriptProfileOpcodes;
+#endif
+    ScriptOperand *instruction = GetScriptInstruction(*scriptCodePtr, buffer);
+    *scriptCodePtr             = instruction->value;
+    GetScriptOperands(&instruction[1], instruction->type);
+    return instruction;
+}
+
+// Fetches the next instruction into RunScriptCode's locals & points the handler locals at the current object & player
+#define FETCH_OPCODE()                                                                                                                       \
+    instruction = FetchScriptInstruction(&scriptCodePtr, decodeBuffer);                                                                      \
+    opcode      = instruction->variable;                                                                                                     \
+    opcodeSize  = instruction->type;                                                                                                         \
+    operands    = &instruction[1];                                                                                                           \
+    scriptInfo  = &objectScriptList[objectEntityList[objectLoop].type];                                                                      \
+    entity      = &objectEntityList[objectLoop];                                                                                             \
+    player      = &playerList[activePlayer];                                                                                                 \
+    spriteFrame = nullptr
+
+#if RETRO_USE_THREADED_SCRIPT
+// each opcode case gets a label too, so every handler can jump straight to the next one with a computed goto
+#define OPCODE(op)     case op: op##_HANDLER
+#define OPCODE_DEFAULT default: FUNC_DEFAULT_HANDLER
+// ends a handler: writes its results back, then fetches the next instruction & jumps to its handler, without going back through the switch
+#define NEXT_OPCODE()                                                                                                                        \
+    {                                                                                                                                        \
+        SetScriptOperands(operands, opcodeSize);                                                                                             \
+        if (!running)                                                                                                                        \
+            goto scriptEnd;                                                                                                                  \
+        FETCH_OPCODE();                                                                                                                      \
+        goto *opcodeHandlers[opcode];                                                                                                        \
+    }
+#else
+#define OPCODE(op)     case op
+#define OPCODE_DEFAULT default
+// ends a handler, the loop writes its results back & fetches the next instruction
+#define NEXT_OPCODE() break
+#endif
+
+// Runs script code from scriptCodePtr until it hits FUNC_END, or just the one instruction if singleStep is set
+// Returns the code pos it stopped at
+int RunScriptCode(int scriptCodePtr, int scriptCodeStart, int jumpTableStart, byte scriptSub, bool singleStep)
+{
+#if RETRO_USE_THREADED_SCRIPT
+    // Handler addresses in ScrFunction order, each one is a label inside the opcode switch below
+    static const void *const opcodeHandlers[FUNC_MAX_CNT + 1] = {
+        &&FUNC_END_HANDLER,
+        &&FUNC_EQUAL_HANDLER,
+        &&FUNC_ADD_HANDLER,
+        &&FUNC_SUB_HANDLER,
+        &&FUNC_INC_HANDLER,
+        &&FUNC_DEC_HANDLER,
+        &&FUNC_MUL_HANDLER,
+        &&FUNC_DIV_HANDLER,
+        &&FUNC_SHR_HANDLER,
+        &&FUNC_SHL_HANDLER,
+        &&FUNC_AND_HANDLER,
+        &&FUNC_OR_HANDLER,
+        &&FUNC_XOR_HANDLER,
+        &&FUNC_MOD_HANDLER,
+        &&FUNC_FLIPSIGN_HANDLER,
+        &&FUNC_CHECKEQUAL_HANDLER,
+        &&FUNC_CHECKGREATER_HANDLER,
+        &&FUNC_CHECKLOWER_HANDLER,
+        &&FUNC_CHECKNOTEQUAL_HANDLER,
+        &&FUNC_IFEQUAL_HANDLER,
+        &&FUNC_IFGREATER_HANDLER,
+        &&FUNC_IFGREATEROREQUAL_HANDLER,
+        &&FUNC_IFLOWER_HANDLER,
+        &&FUNC_IFLOWEROREQUAL_HANDLER,
+        &&FUNC_IFNOTEQUAL_HANDLER,
+        &&FUNC_ELSE_HANDLER,
+        &&FUNC_ENDIF_HANDLER,
+        &&FUNC_WEQUAL_HANDLER,
+        &&FUNC_WGREATER_HANDLER,
+        &&FUNC_WGREATEROREQUAL_HANDLER,
+        &&FUNC_WLOWER_HANDLER,
+        &&FUNC_WLOWEROREQUAL_HANDLER,
+        &&FUNC_WNOTEQUAL_HANDLER,
+        &&FUNC_LOOP_HANDLER,
+        &&FUNC_SWITCH_HANDLER,
+        &&FUNC_BREAK_HANDLER,
+        &&FUNC_ENDSWITCH_HANDLER,
+        &&FUNC_RAND_HANDLER,
+        &&FUNC_SIN_HANDLER,
+        &&FUNC_COS_HANDLER,
+        &&FUNC_SIN256_HANDLER,
+        &&FUNC_COS256_HANDLER,
+        &&FUNC_SINCHANGE_HANDLER,
+        &&FUNC_COSCHANGE_HANDLER,
+        &&FUNC_ATAN2_HANDLER,
+        &&FUNC_INTERPOLATE_HANDLER,
+        &&FUNC_INTERPOLATEXY_HANDLER,
+        &&FUNC_LOADSPRITESHEET_HANDLER,
+        &&FUNC_REMOVESPRITESHEET_HANDLER,
+        &&FUNC_DRAWSPRITE_HANDLER,
+        &&FUNC_DRAWSPRITEXY_HANDLER,
+        &&FUNC_DRAWSPRITESCREENXY_HANDLER,
+        &&FUNC_DRAWTINTRECT_HANDLER,
+        &&FUNC_DRAWNUMBERS_HANDLER,
+        &&FUNC_DRAWACTNAME_HANDLER,
+        &&FUNC_DRAWMENU_HANDLER,
+        &&FUNC_SPRITEFRAME_HANDLER,
+        &&FUNC_EDITFRAME_HANDLER,
+        &&FUNC_LOADPALETTE_HANDLER,
+        &&FUNC_ROTATEPALETTE_HANDLER,
+        &&FUNC_SETSCREENFADE_HANDLER,
+        &&FUNC_SETACTIVEPALETTE_HANDLER,
+        &&FUNC_SETPALETTEFADE_HANDLER,
+        &&FUNC_COPYPALETTE_HANDLER,
+        &&FUNC_CLEARSCREEN_HANDLER,
+        &&FUNC_DRAWSPRITEFX_HANDLER,
+        &&FUNC_DRAWSPRITESCREENFX_HANDLER,
+        &&FUNC_LOADANIMATION_HANDLER,
+        &&FUNC_SETUPMENU_HANDLER,
+        &&FUNC_ADDMENUENTRY_HANDLER,
+        &&FUNC_EDITMENUENTRY_HANDLER,
+        &&FUNC_LOADSTAGE_HANDLER,
+        &&FUNC_DRAWRECT_HANDLER,
+        &&FUNC_RESETOBJECTENTITY_HANDLER,
+        &&FUNC_PLAYEROBJECTCOLLISION_HANDLER,
+        &&FUNC_CREATETEMPOBJECT_HANDLER,
+        &&FUNC_BINDPLAYERTOOBJECT_HANDLER,
+        &&FUNC_PLAYERTILECOLLISION_HANDLER,
+        &&FUNC_PROCESSPLAYERCONTROL_HANDLER,
+        &&FUNC_PROCESSANIMATION_HANDLER,
+        &&FUNC_DRAWOBJECTANIMATION_HANDLER,
+        &&FUNC_DRAWPLAYERANIMATION_HANDLER,
+        &&FUNC_SETMUSICTRACK_HANDLER,
+        &&FUNC_PLAYMUSIC_HANDLER,
+        &&FUNC_STOPMUSIC_HANDLER,
+        &&FUNC_PLAYSFX_HANDLER,
+        &&FUNC_STOPSFX_HANDLER,
+        &&FUNC_SETSFXATTRIBUTES_HANDLER,
+        &&FUNC_OBJECTTILECOLLISION_HANDLER,
+        &&FUNC_OBJECTTILEGRIP_HANDLER,
+        &&FUNC_LOADVIDEO_HANDLER,
+        &&FUNC_NEXTVIDEOFRAME_HANDLER,
+        &&FUNC_PLAYSTAGESFX_HANDLER,
+        &&FUNC_STOPSTAGESFX_HANDLER,
+        &&FUNC_NOT_HANDLER,
+        &&FUNC_DRAW3DSCENE_HANDLER,
+        &&FUNC_SETIDENTITYMATRIX_HANDLER,
+        &&FUNC_MATRIXMULTIPLY_HANDLER,
+        &&FUNC_MATRIXTRANSLATEXYZ_HANDLER,
+        &&FUNC_MATRIXSCALEXYZ_HANDLER,
+        &&FUNC_MATRIXROTATEX_HANDLER,
+        &&FUNC_MATRIXROTATEY_HANDLER,
+        &&FUNC_MATRIXROTATEZ_HANDLER,
+        &&FUNC_MATRIXROTATEXYZ_HANDLER,
+        &&FUNC_TRANSFORMVERTICES_HANDLER,
+        &&FUNC_CALLFUNCTION_HANDLER,
+        &&FUNC_ENDFUNCTION_HANDLER,
+        &&FUNC_SETLAYERDEFORMATION_HANDLER,
+        &&FUNC_CHECKTOUCHRECT_HANDLER,
+        &&FUNC_GETTILELAYERENTRY_HANDLER,
+        &&FUNC_SETTILELAYERENTRY_HANDLER,
+        &&FUNC_GETBIT_HANDLER,
+        &&FUNC_SETBIT_HANDLER,
+        &&FUNC_PAUSEMUSIC_HANDLER,
+        &&FUNC_RESUMEMUSIC_HANDLER,
+        &&FUNC_CLEARDRAWLIST_HANDLER,
+        &&FUNC_ADDDRAWLISTENTITYREF_HANDLER,
+        &&FUNC_GETDRAWLISTENTITYREF_HANDLER,
+        &&FUNC_SETDRAWLISTENTITYREF_HANDLER,
+        &&FUNC_GET16X16TILEINFO_HANDLER,
+        &&FUNC_COPY16X16TILE_HANDLER,
+        &&FUNC_SET16X16TILEINFO_HANDLER,
+        &&FUNC_GETANIMATIONBYNAME_HANDLER,
+        &&FUNC_READSAVERAM_HANDLER,
+        &&FUNC_WRITESAVERAM_HANDLER,
+        &&FUNC_LOADTEXTFONT_HANDLER,
+        &&FUNC_LOADTEXTFILE_HANDLER,
+        &&FUNC_DRAWTEXT_HANDLER,
+        &&FUNC_GETTEXTINFO_HANDLER,
+        &&FUNC_GETVERSIONNUMBER_HANDLER,
+        &&FUNC_SETACHIEVEMENT_HANDLER,
+        &&FUNC_SETLEADERBOARD_HANDLER,
+        &&FUNC_LOADONLINEMENU_HANDLER,
+        &&FUNC_ENGINECALLBACK_HANDLER,
+#if RETRO_USE_HAPTICS
+        &&FUNC_HAPTICEFFECT_HANDLER,
+#endif
+        &&FUNC_DEFAULT_HANDLER, // FUNC_MAX_CNT, used for invalid opcodes
+    };
+#endif
+
+    ScriptOperand decodeBuffer[SCRIPTINSTRUCTION_SIZE];
+    ScriptOperand *instruction;
+    ScriptOperand *operands;
+    int opcode;
+    int opcodeSize;
+    ObjectScript *scriptInfo;
+    Entity *entity;
+    Player *player;
+    SpriteFrame *spriteFrame;
+
+    bool running = !singleStep;
+    do {
+        FETCH_OPCODE();
+
+        // Functions
+#if RETRO_USE_THREADED_SCRIPT
+        goto *opcodeHandlers[opcode];
+#endif
+        switch (opcode) {
+            OPCODE_DEFAULT: NEXT_OPCODE();
+            OPCODE(FUNC_END): running = false; NEXT_OPCODE();
+            OPCODE(FUNC_EQUAL): scriptEng.operands[0] = scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_ADD): scriptEng.operands[0] += scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_SUB): scriptEng.operands[0] -= scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_INC): ++scriptEng.operands[0]; NEXT_OPCODE();
+            OPCODE(FUNC_DEC): --scriptEng.operands[0]; NEXT_OPCODE();
+            OPCODE(FUNC_MUL): scriptEng.operands[0] *= scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_DIV): scriptEng.operands[0] /= scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_SHR): scriptEng.operands[0] >>= scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_SHL): scriptEng.operands[0] <<= scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_AND): scriptEng.operands[0] &= scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_OR): scriptEng.operands[0] |= scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_XOR): scriptEng.operands[0] ^= scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_MOD): scriptEng.operands[0] %= scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_FLIPSIGN): scriptEng.operands[0] = -scriptEng.operands[0]; NEXT_OPCODE();
+            OPCODE(FUNC_CHECKEQUAL):
+                scriptEng.checkResult = scriptEng.operands[0] == scriptEng.operands[1];
+                opcodeSize            = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_CHECKGREATER):
+                scriptEng.checkResult = scriptEng.operands[0] > scriptEng.operands[1];
+                opcodeSize            = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_CHECKLOWER):
+                scriptEng.checkResult = scriptEng.operands[0] < scriptEng.operands[1];
+                opcodeSize            = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_CHECKNOTEQUAL):
+                scriptEng.checkResult = scriptEng.operands[0] != scriptEng.operands[1];
+                opcodeSize            = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_IFEQUAL):
+                if (scriptEng.operands[1] != scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
+                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
+                opcodeSize                          = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_IFGREATER):
+                if (scriptEng.operands[1] <= scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
+                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
+                opcodeSize                          = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_IFGREATEROREQUAL):
+                if (scriptEng.operands[1] < scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
+                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
+                opcodeSize                          = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_IFLOWER):
+                if (scriptEng.operands[1] >= scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
+                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
+                opcodeSize                          = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_IFLOWEROREQUAL):
+                if (scriptEng.operands[1] > scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
+                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
+                opcodeSize                          = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_IFNOTEQUAL):
+                if (scriptEng.operands[1] == scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0]];
+                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
+                opcodeSize                          = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_ELSE):
+                opcodeSize    = 0;
+                scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + jumpTableStack[jumpTableStackPos--] + 1];
+                NEXT_OPCODE();
+            OPCODE(FUNC_ENDIF):
                 opcodeSize = 0;
-                PauseSound();
-                if (FindStringToken(scriptText, ".rsv", 1) <= -1)
-                    PlayVideoFile(scriptText); // not an rsv
+                --jumpTableStackPos;
+                NEXT_OPCODE();
+            OPCODE(FUNC_WEQUAL):
+                if (scriptEng.operands[1] != scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
                 else
-                    scriptInfo->spriteSheetID = AddGraphicsFile(scriptText);
-                ResumeSound();
-                break;
-            case FUNC_NEXTVIDEOFRAME:
-                opcodeSize = 0;
-                UpdateVideoFrame();
-                break;
-            case FUNC_PLAYSTAGESFX:
-                opcodeSize = 0;
-                PlaySfx(globalSFXCount + scriptEng.operands[0], scriptEng.operands[1]);
-                break;
-            case FUNC_STOPSTAGESFX:
-                opcodeSize = 0;
-                StopSfx(globalSFXCount + scriptEng.operands[0]);
-                break;
-            case FUNC_NOT: scriptEng.operands[0] = ~scriptEng.operands[0]; break;
-            case FUNC_DRAW3DSCENE:
-                opcodeSize = 0;
-                TransformVertexBuffer();
-                Sort3DDrawList();
-                Draw3DScene(scriptInfo->spriteSheetID);
-                break;
-            case FUNC_SETIDENTITYMATRIX:
-                opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    case MAT_WORLD: SetIdentityMatrix(&matWorld); break;
-                    case MAT_VIEW: SetIdentityMatrix(&matView); break;
-                    case MAT_TEMP: SetIdentityMatrix(&matTemp); break;
-                }
-                break;
-            case FUNC_MATRIXMULTIPLY:
+                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
                 opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    case MAT_WORLD:
-                        switch (scriptEng.operands[1]) {
-                            case MAT_WORLD: MatrixMultiply(&matWorld, &matWorld); break;
-                            case MAT_VIEW: MatrixMultiply(&matWorld, &matView); break;
-                            case MAT_TEMP: MatrixMultiply(&matWorld, &matTemp); break;
-                        }
-                        break;
-                    case MAT_VIEW:
-                        switch (scriptEng.operands[1]) {
-                            case MAT_WORLD: MatrixMultiply(&matView, &matWorld); break;
-                            case MAT_VIEW: MatrixMultiply(&matView, &matView); break;
-                            case MAT_TEMP: MatrixMultiply(&matView, &matTemp); break;
-                        }
-                        break;
-                    case MAT_TEMP:
-                        switch (scriptEng.operands[1]) {
-                            case MAT_WORLD: MatrixMultiply(&matTemp, &matWorld); break;
-                            case MAT_VIEW: MatrixMultiply(&matTemp, &matView); break;
-                            case MAT_TEMP: MatrixMultiply(&matTemp, &matTemp); break;
-                        }
-                        break;
-                }
-                break;
-            case FUNC_MATRIXTRANSLATEXYZ:
+                NEXT_OPCODE();
+            OPCODE(FUNC_WGREATER):
+                if (scriptEng.operands[1] <= scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
+                else
+                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
                 opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    case MAT_WORLD: MatrixTranslateXYZ(&matWorld, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case MAT_VIEW: MatrixTranslateXYZ(&matView, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case MAT_TEMP: MatrixTranslateXYZ(&matTemp, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                }
-                break;
-            case FUNC_MATRIXSCALEXYZ:
+                NEXT_OPCODE();
+            OPCODE(FUNC_WGREATEROREQUAL):
+                if (scriptEng.operands[1] < scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
+                else
+                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
                 opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    case MAT_WORLD: MatrixScaleXYZ(&matWorld, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case MAT_VIEW: MatrixScaleXYZ(&matView, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case MAT_TEMP: MatrixScaleXYZ(&matTemp, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                }
-                break;
-            case FUNC_MATRIXROTATEX:
+                NEXT_OPCODE();
+            OPCODE(FUNC_WLOWER):
+                if (scriptEng.operands[1] >= scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
+                else
+                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
                 opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    case MAT_WORLD: MatrixRotateX(&matWorld, scriptEng.operands[1]); break;
-                    case MAT_VIEW: MatrixRotateX(&matView, scriptEng.operands[1]); break;
-                    case MAT_TEMP: MatrixRotateX(&matTemp, scriptEng.operands[1]); break;
-                }
-                break;
-            case FUNC_MATRIXROTATEY:
+                NEXT_OPCODE();
+            OPCODE(FUNC_WLOWEROREQUAL):
+                if (scriptEng.operands[1] > scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
+                else
+                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
                 opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    case MAT_WORLD: MatrixRotateY(&matWorld, scriptEng.operands[1]); break;
-                    case MAT_VIEW: MatrixRotateY(&matView, scriptEng.operands[1]); break;
-                    case MAT_TEMP: MatrixRotateY(&matTemp, scriptEng.operands[1]); break;
-                }
-                break;
-            case FUNC_MATRIXROTATEZ:
+                NEXT_OPCODE();
+            OPCODE(FUNC_WNOTEQUAL):
+                if (scriptEng.operands[1] == scriptEng.operands[2])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 1];
+                else
+                    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
                 opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    case MAT_WORLD: MatrixRotateZ(&matWorld, scriptEng.operands[1]); break;
-                    case MAT_VIEW: MatrixRotateZ(&matView, scriptEng.operands[1]); break;
-                    case MAT_TEMP: MatrixRotateZ(&matTemp, scriptEng.operands[1]); break;
-                }
-                break;
-            case FUNC_MATRIXROTATEXYZ:
+                NEXT_OPCODE();
+            OPCODE(FUNC_LOOP):
+                opcodeSize    = 0;
+                scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + jumpTableStack[jumpTableStackPos--]];
+                NEXT_OPCODE();
+            OPCODE(FUNC_SWITCH):
+                jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];
+                if (scriptEng.operands[1] < jumpTable[jumpTableStart + scriptEng.operands[0]]
+                    || scriptEng.operands[1] > jumpTable[jumpTableStart + scriptEng.operands[0] + 1])
+                    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + scriptEng.operands[0] + 2];
+                else
+                    scriptCodePtr = scriptCodeStart
+                                    + jumpTable[jumpTableStart + scriptEng.operands[0] + 4
+                                                    + (scriptEng.operands[1] - jumpTable[jumpTableStart + scriptEng.operands[0]])];
                 opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    case MAT_WORLD: MatrixRotateXYZ(&matWorld, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case MAT_VIEW: MatrixRotateXYZ(&matView, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                    case MAT_TEMP: MatrixRotateXYZ(&matTemp, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
-                }
-                break;
-            case FUNC_TRANSFORMVERTICES:
+                NEXT_OPCODE();
+            OPCODE(FUNC_BREAK):
+                opcodeSize    = 0;
+                scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + jumpTableStack[jumpTableStackPos--] + 3];
+                NEXT_OPCODE();
+            OPCODE(FUNC_ENDSWITCH):
                 opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    case MAT_WORLD: TransformVerticies(&matWorld, scriptEng.operands[1], scriptEng.operands[2]); break;
-                    case MAT_VIEW: TransformVerticies(&matView, scriptEng.operands[1], scriptEng.operands[2]); break;
-                    case MAT_TEMP: TransformVerticies(&matTemp, scriptEng.operands[1], scriptEng.operands[2]); break;
-                }
-                break;
-            case FUNC_CALLFUNCTION: {
-                opcodeSize                        = 0;
-                functionStack[functionStackPos++] = scriptCodePtr;
-                functionStack[functionStackPos++] = jumpTableStart;
-                functionStack[functionStackPos++] = scriptCodeStart;
-                scriptCodeStart                   = scriptFunctionList[scriptEng.operands[0]].ptr.scriptCodePtr;
-                jumpTableStart                    = scriptFunctionList[scriptEng.operands[0]].ptr.jumpTablePtr;
-                scriptCodePtr                     = scriptCodeStart;
-            } break;
-            case FUNC_ENDFUNCTION:
-                opcodeSize      = 0;
-                scriptCodeStart = functionStack[--functionStackPos];
-                jumpTableStart  = functionStack[--functionStackPos];
-                scriptCodePtr   = functionStack[--functionStackPos];
-                break;
-            case FUNC_SETLAYERDEFORMATION:
+                --jumpTableStackPos;
+                NEXT_OPCODE();
+            OPCODE(FUNC_RAND): scriptEng.operands[0] = rand() % scriptEng.operands[1]; NEXT_OPCODE();
+            OPCODE(FUNC_SIN): {
+                scriptEng.operands[0] = Sin512(scriptEng.operands[1]);
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_COS): {
+                scriptEng.operands[0] = Cos512(scriptEng.operands[1]);
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_SIN256): {
+                scriptEng.operands[0] = Sin256(scriptEng.operands[1]);
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_COS256): {
+                scriptEng.operands[0] = Cos256(scriptEng.operands[1]);
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_SINCHANGE): {
+                scriptEng.operands[0] = scriptEng.operands[3] + (Sin512(scriptEng.operands[1]) >> scriptEng.operands[2]) - scriptEng.operands[4];
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_COSCHANGE): {
+                scriptEng.operands[0] = scriptEng.operands[3] + (Cos512(scriptEng.operands[1]) >> scriptEng.operands[2]) - scriptEng.operands[4];
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_ATAN2): {
+                scriptEng.operands[0] = ArcTanLookup(scriptEng.operands[1], scriptEng.operands[2]);
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_INTERPOLATE):
+                scriptEng.operands[0] =
+                    (scriptEng.operands[2] * (0x100 - scriptEng.operands[3]) + scriptEng.operands[3] * scriptEng.operands[1]) >> 8;
+                NEXT_OPCODE();
+            OPCODE(FUNC_INTERPOLATEXY):
+                scriptEng.operands[0] =
+                    (scriptEng.operands[3] * (0x100 - scriptEng.operands[6]) >> 8) + ((scriptEng.operands[6] * scriptEng.operands[2]) >> 8);
+                scriptEng.operands[1] =
+                    (scriptEng.operands[5] * (0x100 - scriptEng.operands[6]) >> 8) + (scriptEng.operands[6] * scriptEng.operands[4] >> 8);
+                NEXT_OPCODE();
+            OPCODE(FUNC_LOADSPRITESHEET):
+                opcodeSize                = 0;
+                scriptInfo->spriteSheetID = AddGraphicsFile(scriptText);
+                NEXT_OPCODE();
+            OPCODE(FUNC_REMOVESPRITESHEET):
                 opcodeSize = 0;
-                SetLayerDeformation(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4],
-                                    scriptEng.operands[5]);
-                break;
-            case FUNC_CHECKTOUCHRECT: opcodeSize = 0; scriptEng.checkResult = -1;
-#if !RETRO_USE_ORIGINAL_CODE
-                AddDebugHitbox(H_TYPE_FINGER, NULL, scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]);
-#endif
-                for (int f = 0; f < touches; ++f) {
-                    if (touchDown[f] && touchX[f] > scriptEng.operands[0] && touchX[f] < scriptEng.operands[2] && touchY[f] > scriptEng.operands[1]
-                        && touchY[f] < scriptEng.operands[3]) {
-                        scriptEng.checkResult = f;
-                    }
-                }
-                break;
-            case FUNC_GETTILELAYERENTRY:
-                scriptEng.operands[0] = stageLayouts[scriptEng.operands[1]].tiles[scriptEng.operands[2] + 0x100 * scriptEng.operands[3]];
-                break;
-            case FUNC_SETTILELAYERENTRY:
-                stageLayouts[scriptEng.operands[1]].tiles[scriptEng.operands[2] + 0x100 * scriptEng.operands[3]] = scriptEng.operands[0];
-                break;
-            case FUNC_GETBIT: scriptEng.operands[0] = (scriptEng.operands[1] & (1 << scriptEng.operands[2])) >> scriptEng.operands[2]; break;
-            case FUNC_SETBIT:
-                if (scriptEng.operands[2] <= 0)
-                    scriptEng.operands[0] &= ~(1 << scriptEng.operands[1]);
-                else
-                    scriptEng.operands[0] |= 1 << scriptEng.operands[1];
-                break;
-            case FUNC_PAUSEMUSIC:
+                RemoveGraphicsFile(scriptText, -1);
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWSPRITE):
+                opcodeSize  = 0;
+                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
+                DrawSprite((entity->XPos >> 16) - xScrollOffset + spriteFrame->pivotX, (entity->YPos >> 16) - yScrollOffset + spriteFrame->pivotY,
+                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWSPRITEXY):
+                opcodeSize  = 0;
+                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
+                DrawSprite((scriptEng.operands[1] >> 16) - xScrollOffset + spriteFrame->pivotX,
+                           (scriptEng.operands[2] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width, spriteFrame->height,
+                           spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWSPRITESCREENXY):
+                opcodeSize  = 0;
+                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
+                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY, spriteFrame->width,
+                           spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWTINTRECT):
                 opcodeSize = 0;
-                PauseSound();
-                break;
-            case FUNC_RESUMEMUSIC:
+                DrawTintRectangle(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWNUMBERS): {
                 opcodeSize = 0;
-                ResumeSound();
-                break;
-            case FUNC_CLEARDRAWLIST:
-                opcodeSize                                      = 0;
-                drawListEntries[scriptEng.operands[0]].listSize = 0;
-                break;
-            case FUNC_ADDDRAWLISTENTITYREF: {
-                opcodeSize                                                                                           = 0;
-                drawListEntries[scriptEng.operands[0]].entityRefs[drawListEntries[scriptEng.operands[0]].listSize++] = scriptEng.operands[1];
-                break;
-            }
-            case FUNC_GETDRAWLISTENTITYREF: scriptEng.operands[0] = drawListEntries[scriptEng.operands[1]].entityRefs[scriptEng.operands[2]]; break;
-            case FUNC_SETDRAWLISTENTITYREF:
-                opcodeSize                                                               = 0;
-                drawListEntries[scriptEng.operands[1]].entityRefs[scriptEng.operands[2]] = scriptEng.operands[0];
-                break;
-            case FUNC_GET16X16TILEINFO: {
-                scriptEng.operands[4] = scriptEng.operands[1] >> 7;
-                scriptEng.operands[5] = scriptEng.operands[2] >> 7;
-                scriptEng.operands[6] = stageLayouts[0].tiles[scriptEng.operands[4] + (scriptEng.operands[5] << 8)] << 6;
-                scriptEng.operands[6] += ((scriptEng.operands[1] & 0x7F) >> 4) + 8 * ((scriptEng.operands[2] & 0x7F) >> 4);
-                int index = tiles128x128.tileIndex[scriptEng.operands[6]];
-                switch (scriptEng.operands[3]) {
-                    case TILEINFO_INDEX: scriptEng.operands[0] = tiles128x128.tileIndex[scriptEng.operands[6]]; break;
-                    case TILEINFO_DIRECTION: scriptEng.operands[0] = tiles128x128.direction[scriptEng.operands[6]]; break;
-                    case TILEINFO_VISUALPLANE: scriptEng.operands[0] = tiles128x128.visualPlane[scriptEng.operands[6]]; break;
-                    case TILEINFO_SOLIDITYA: scriptEng.operands[0] = tiles128x128.collisionFlags[0][scriptEng.operands[6]]; break;
-                    case TILEINFO_SOLIDITYB: scriptEng.operands[0] = tiles128x128.collisionFlags[1][scriptEng.operands[6]]; break;
-                    case TILEINFO_FLAGSA: scriptEng.operands[0] = collisionMasks[0].flags[index]; break;
-                    case TILEINFO_ANGLEA: scriptEng.operands[0] = collisionMasks[0].angles[index]; break;
-                    case TILEINFO_FLAGSB: scriptEng.operands[0] = collisionMasks[1].flags[index]; break;
-                    case TILEINFO_ANGLEB: scriptEng.operands[0] = collisionMasks[1].angles[index]; break;
-                    default: break;
+                int i      = 10;
+                if (scriptEng.operands[6]) {
+                    while (scriptEng.operands[4] > 0) {
+                        int frameID = scriptEng.operands[3] % i / (i / 10) + scriptEng.operands[0];
+                        spriteFrame = &scriptFrames[scriptInfo->frameListOffset + frameID];
+                        DrawSprite(spriteFrame->pivotX + scriptEng.operands[1], spriteFrame->pivotY + scriptEng.operands[2], spriteFrame->width,
+                                   spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                        scriptEng.operands[1] -= scriptEng.operands[5];
+                        i *= 10;
+                        --scriptEng.operands[4];
+                    }
                 }
-                break;
+                else {
+                    int extra = 10;
+                    if (scriptEng.operands[3])
+                        extra = 10 * scriptEng.operands[3];
+                    while (scriptEng.operands[4] > 0) {
+                        if (extra >= i) {
+                            int frameID = scriptEng.operands[3] % i / (i / 10) + scriptEng.operands[0];
+                            spriteFrame = &scriptFrames[scriptInfo->frameListOffset + frameID];
+                            DrawSprite(spriteFrame->pivotX + scriptEng.operands[1], spriteFrame->pivotY + scriptEng.operands[2], spriteFrame->width,
+                                       spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                        }
+                        scriptEng.operands[1] -= scriptEng.operands[5];
+                        i *= 10;
+                        --scriptEng.operands[4];
+                    }
+                }
+                NEXT_OPCODE();
             }
-            case FUNC_COPY16X16TILE:
+            OPCODE(FUNC_DRAWACTNAME): {
                 opcodeSize = 0;
-                Copy16x16Tile(scriptEng.operands[0], scriptEng.operands[1]);
-                break;
-            case FUNC_SET16X16TILEINFO: {
-                scriptEng.operands[4] = scriptEng.operands[1] >> 7;
-                scriptEng.operands[5] = scriptEng.operands[2] >> 7;
-                scriptEng.operands[6] = stageLayouts[0].tiles[scriptEng.operands[4] + (scriptEng.operands[5] << 8)] << 6;
-                scriptEng.operands[6] += ((scriptEng.operands[1] & 0x7F) >> 4) + 8 * ((scriptEng.operands[2] & 0x7F) >> 4);
+                int charID = 0;
+
                 switch (scriptEng.operands[3]) {
-                    case TILEINFO_INDEX:
-                        tiles128x128.tileIndex[scriptEng.operands[6]]  = scriptEng.operands[0];
-                        if (renderType == RENDER_SW)
-                            tiles128x128.gfxDataPos[scriptEng.operands[6]] = scriptEng.operands[0] << 8;
-                        else if (renderType == RENDER_HW)
-                            tiles128x128.gfxDataPos[scriptEng.operands[6]] = (scriptEng.operands[0] << 2) & 0x3FFFC;
-                        break;
-                    case TILEINFO_DIRECTION: tiles128x128.direction[scriptEng.operands[6]] = scriptEng.operands[0]; break;
-                    case TILEINFO_VISUALPLANE: tiles128x128.visualPlane[scriptEng.operands[6]] = scriptEng.operands[0]; break;
-                    case TILEINFO_SOLIDITYA: tiles128x128.collisionFlags[0][scriptEng.operands[6]] = scriptEng.operands[0]; break;
-                    case TILEINFO_SOLIDITYB: tiles128x128.collisionFlags[1][scriptEng.operands[6]] = scriptEng.operands[0]; break;
-                    case TILEINFO_FLAGSA: collisionMasks[1].flags[tiles128x128.tileIndex[scriptEng.operands[6]]] = scriptEng.operands[0]; break;
-                    case TILEINFO_ANGLEA: collisionMasks[1].angles[tiles128x128.tileIndex[scriptEng.operands[6]]] = scriptEng.operands[0]; break;
                     default: break;
-                }
-                break;
-            }
-            case FUNC_GETANIMATIONBYNAME: {
-                AnimationFile *animFile = scriptInfo->animFile;
-                scriptEng.operands[0]   = -1;
-                int id                  = 0;
-                while (scriptEng.operands[0] == -1) {
-                    SpriteAnimation *anim = &animationList[animFile->aniListOffset + id];
-                    if (StrComp(scriptText, anim->name))
-                        scriptEng.operands[0] = id;
-                    else if (++id == animFile->animCount)
-                        scriptEng.operands[0] = 0;
-                }
-                break;
-            }
-            case FUNC_READSAVERAM:
-                opcodeSize            = 0;
-                scriptEng.checkResult = ReadSaveRAMData();
-                break;
-            case FUNC_WRITESAVERAM:
-                opcodeSize            = 0;
-                scriptEng.checkResult = WriteSaveRAMData();
-                break;
-            case FUNC_LOADTEXTFONT:
-                opcodeSize = 0;
-                LoadFontFile(scriptText);
-                break;
-            case FUNC_LOADTEXTFILE: {
-                opcodeSize     = 0;
-                TextMenu *menu = &gameMenu[scriptEng.operands[0]];
-                LoadTextFile(menu, scriptText, scriptEng.operands[2] != 0);
-                break;
-            }
-            case FUNC_DRAWTEXT: {
-                opcodeSize        = 0;
-                textMenuSurfaceNo = scriptInfo->spriteSheetID;
-                TextMenu *menu    = &gameMenu[scriptEng.operands[0]];
-                DrawBitmapText(menu, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4],
-                               scriptEng.operands[5], scriptEng.operands[6]);
-                break;
-            }
-            case FUNC_GETTEXTINFO: {
-                TextMenu *menu = &gameMenu[scriptEng.operands[1]];
-                switch (scriptEng.operands[2]) {
-                    case TEXTINFO_TEXTDATA:
-                        scriptEng.operands[0] = menu->textData[menu->entryStart[scriptEng.operands[3]] + scriptEng.operands[4]];
+                    case 0:                      // Draw Word 1 (but aligned from the right instead of left)
+                        charID = 0;
+                        for (charID = 0;; ++charID) {
+                            int nextChar = titleCardText[charID + 1];
+                            if (nextChar == '-' || !nextChar)
+                                break;
+                        }
+
+                        while (charID >= 0) {
+                            int character = titleCardText[charID];
+                            if (character == ' ')
+                                character = -1; // special space char
+                            if (character == '-')
+                                character = 0;
+                            if (character >= '0' && character <= '9')
+                                character -= 22;
+                            if (character > '9' && character < 'f')
+                                character -= 'A';
+
+                            if (character <= -1) {
+                                scriptEng.operands[1] -= scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
+                            }
+                            else {
+                                character += scriptEng.operands[0];
+                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
+
+                                scriptEng.operands[1] -= spriteFrame->width + scriptEng.operands[6];
+
+                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
+                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                            }
+                            charID--;
+                        }
+                        break;
+
+                    case 1: // Draw Word 1
+                        charID = 0;
+
+                        // Draw the first letter as a capital letter, the rest are lowercase (if scriptEng.operands[4] is true, otherwise they're all
+                        // uppercase)
+                        if (scriptEng.operands[4] == 1 && titleCardText[charID] != 0) {
+                            int character = titleCardText[charID];
+                            if (character == ' ')
+                                character = -1;
+                            if (character == '-')
+                                character = 0;
+                            if (character >= '0' && character <= '9')
+                                character -= 22;
+                            if (character > '9' && character < 'f')
+                                character -= 'A';
+
+                            if (character <= -1) {
+                                scriptEng.operands[1] += scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
+                            }
+                            else {
+                                character += scriptEng.operands[0];
+                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
+                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
+                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                                scriptEng.operands[1] += spriteFrame->width + scriptEng.operands[6];
+                            }
+
+                            scriptEng.operands[0] += 26;
+                            charID++;
+                        }
+
+                        while (titleCardText[charID] != 0 && titleCardText[charID] != '-') {
+                            int character = titleCardText[charID];
+                            if (character == ' ')
+                                character = -1;
+                            if (character == '-')
+                                character = 0;
+                            if (character > '/' && character < ':')
+                                character -= 22;
+                            if (character > '9' && character < 'f')
+                                character -= 'A';
+
+                            if (character <= -1) {
+                                scriptEng.operands[1] += scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
+                            }
+                            else {
+                                character += scriptEng.operands[0];
+                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
+                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
+                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                                scriptEng.operands[1] += spriteFrame->width + scriptEng.operands[6];
+                            }
+                            charID++;
+                        }
+                        break;
+
+                    case 2: // Draw Word 2
+                        charID = titleCardWord2;
+
+                        // Draw the first letter as a capital letter, the rest are lowercase (if scriptEng.operands[4] is true, otherwise they're all
+                        // uppercase)
+                        if (scriptEng.operands[4] == 1 && titleCardText[charID] != 0) {
+                            int character = titleCardText[charID];
+                            if (character == ' ')
+                                character = 0;
+                            if (character == '-')
+                                character = 0;
+                            if (character >= '0' && character <= '9')
+                                character -= 22;
+                            if (character > '9' && character < 'f')
+                                character -= 'A';
+
+                            if (character <= -1) {
+                                scriptEng.operands[1] += scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
+                            }
+                            else {
+                                character += scriptEng.operands[0];
+                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
+                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
+                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                                scriptEng.operands[1] += spriteFrame->width + scriptEng.operands[6];
+                            }
+                            scriptEng.operands[0] += 26;
+                            charID++;
+                        }
+
+                        while (titleCardText[charID] != 0) {
+                            int character = titleCardText[charID];
+                            if (character == ' ')
+                                character = -1;
+                            if (character == '-')
+                                character = 0;
+                            if (character >= '0' && character <= '9')
+                                character -= 22;
+                            if (character > '9' && character < 'f')
+                                character -= 'A';
+
+                            if (character <= -1) {
+                                scriptEng.operands[1] += scriptEng.operands[5] + scriptEng.operands[6]; // spaceWidth + spacing
+                            }
+                            else {
+                                character += scriptEng.operands[0];
+                                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + character];
+                                DrawSprite(scriptEng.operands[1] + spriteFrame->pivotX, scriptEng.operands[2] + spriteFrame->pivotY,
+                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                                scriptEng.operands[1] += spriteFrame->width + scriptEng.operands[6];
+                            }
+                            charID++;
+                        }
                         break;
-                    case TEXTINFO_TEXTSIZE: scriptEng.operands[0] = menu->entrySize[scriptEng.operands[3]]; break;
-                    case TEXTINFO_ROWCOUNT: scriptEng.operands[0] = menu->rowCount; break;
                 }
-                break;
-            }
-            case FUNC_GETVERSIONNUMBER: {
-                opcodeSize                           = 0;
-                TextMenu *menu                       = &gameMenu[scriptEng.operands[0]];
-                menu->entryHighlight[menu->rowCount] = scriptEng.operands[1];
-                AddTextMenuEntry(menu, Engine.gameVersion);
-                break;
+                NEXT_OPCODE();
             }
-            case FUNC_SETACHIEVEMENT:
-                opcodeSize = 0;
-                SetAchievement(scriptEng.operands[0], scriptEng.operands[1]);
-                break;
-            case FUNC_SETLEADERBOARD:
-                opcodeSize = 0;
-                SetLeaderboard(scriptEng.operands[0], scriptEng.operands[1]);
-                break;
-            case FUNC_LOADONLINEMENU:
+            OPCODE(FUNC_DRAWMENU):
+                opcodeSize        = 0;
+                textMenuSurfaceNo = scriptInfo->spriteSheetID;
+                DrawTextMenu(&gameMenu[scriptEng.operands[0]], scriptEng.operands[1], scriptEng.operands[2]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_SPRITEFRAME):
                 opcodeSize = 0;
-                switch (scriptEng.operands[0]) {
-                    default: break;
-                    case ONLINEMENU_ACHIEVEMENTS: LoadAchievementsMenu(); break;
-                    case ONLINEMENU_LEADERBOARDS: LoadLeaderboardsMenu(); break;
+                if (scriptSub == SUB_SETUP && scriptFrameCount < SPRITEFRAME_COUNT) {
+                    scriptFrames[scriptFrameCount].pivotX = scriptEng.operands[0];
+                    scriptFrames[scriptFrameCount].pivotY = scriptEng.operands[1];
+                    scriptFrames[scriptFrameCount].width  = scriptEng.operands[2];
+                    scriptFrames[scriptFrameCount].height = scriptEng.operands[3];
+                    scriptFrames[scriptFrameCount].sprX   = scriptEng.operands[4];
+                    scriptFrames[scriptFrameCount].sprY   = scriptEng.operands[5];
+                    ++scriptFrameCount;
                 }
-                break;
-            case FUNC_ENGINECALLBACK:
-                opcodeSize = 0;
-                Engine.Callback(scriptEng.operands[0]);
-                break;
-#if RETRO_USE_HAPTICS
-            case FUNC_HAPTICEFFECT:
-                opcodeSize = 0;
-                // params: scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]
-                if (scriptEng.operands[0] != -1)
-                    QueueHapticEffect(scriptEng.operands[0]);
-                else
-                    PlayHaptics(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]);
-                break;
-#endif
-        }
+                NEXT_OPCODE();
+            OPCODE(FUNC_EDITFRAME): {
+                if (scriptInfo->mobile) {
+                    opcodeSize  = 0;
+                    spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
 
-        // Set Values
-        if (opcodeSize > 0)
-            scriptCodePtr -= scriptCodePtr - scriptCodeOffset;
-        for (int i = 0; i < opcodeSize; ++i) {
-            int opcodeType = scriptCode[scriptCodePtr++];
-            if (opcodeType == SCRIPTVAR_VAR) {
-                int arrayVal = 0;
-                switch (scriptCode[scriptCodePtr++]) { // variable
-                    case VARARR_NONE: arrayVal = objectLoop; break;
-                    case VARARR_ARRAY:
-                        if (scriptCode[scriptCodePtr++] == 1)
-                            arrayVal = scriptEng.arrayPosition[scriptCode[scriptCodePtr++]];
-                        else
-                            arrayVal = scriptCode[scriptCodePtr++];
-                        break;
-                    case VARARR_ENTNOPLUS1:
-                        if (scriptCode[scriptCodePtr++] == 1)
-                            arrayVal = scriptEng.arrayPosition[scriptCode[scriptCodePtr++]] + objectLoop;
-                        else
-                            arrayVal = scriptCode[scriptCodePtr++] + objectLoop;
-                        break;
-                    case VARARR_ENTNOMINUS1:
-                        if (scriptCode[scriptCodePtr++] == 1)
-                            arrayVal = objectLoop - scriptEng.arrayPosition[scriptCode[scriptCodePtr++]];
-                        else
-                            arrayVal = objectLoop - scriptCode[scriptCodePtr++];
-                        break;
-                    default: break;
+                    spriteFrame->pivotX = scriptEng.operands[1];
+                    spriteFrame->pivotY = scriptEng.operands[2];
+                    spriteFrame->width  = scriptEng.operands[3];
+                    spriteFrame->height = scriptEng.operands[4];
+                    spriteFrame->sprX   = scriptEng.operands[5];
+                    spriteFrame->sprY   = scriptEng.operands[6];
                 }
-
-                // Variables
-                switch (scriptCode[scriptCodePtr++]) {
-                    default: break;
-                    case VAR_TEMPVALUE0: scriptEng.tempValue[0] = scriptEng.operands[i]; break;
-                    case VAR_TEMPVALUE1: scriptEng.tempValue[1] = scriptEng.operands[i]; break;
-                    case VAR_TEMPVALUE2: scriptEng.tempValue[2] = scriptEng.operands[i]; break;
-                    case VAR_TEMPVALUE3: scriptEng.tempValue[3] = scriptEng.operands[i]; break;
-                    case VAR_TEMPVALUE4: scriptEng.tempValue[4] = scriptEng.operands[i]; break;
-                    case VAR_TEMPVALUE5: scriptEng.tempValue[5] = scriptEng.operands[i]; break;
-                    case VAR_TEMPVALUE6: scriptEng.tempValue[6] = scriptEng.operands[i]; break;
-                    case VAR_TEMPVALUE7: scriptEng.tempValue[7] = scriptEng.operands[i]; break;
-                    case VAR_CHECKRESULT: scriptEng.checkResult = scriptEng.operands[i]; break;
-                    case VAR_ARRAYPOS0: scriptEng.arrayPosition[0] = scriptEng.operands[i]; break;
-                    case VAR_ARRAYPOS1: scriptEng.arrayPosition[1] = scriptEng.operands[i]; break;
-                    case VAR_GLOBAL: globalVariables[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_OBJECTENTITYNO: break;
-                    case VAR_OBJECTTYPE: {
-                        objectEntityList[arrayVal].type = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTPROPERTYVALUE: {
-                        objectEntityList[arrayVal].propertyValue = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTXPOS: {
-                        objectEntityList[arrayVal].XPos = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTYPOS: {
-                        objectEntityList[arrayVal].YPos = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTIXPOS: {
-                        objectEntityList[arrayVal].XPos = scriptEng.operands[i] << 16;
-                        break;
-                    }
-                    case VAR_OBJECTIYPOS: {
-                        objectEntityList[arrayVal].YPos = scriptEng.operands[i] << 16;
-                        break;
-                    }
-                    case VAR_OBJECTSTATE: {
-                        objectEntityList[arrayVal].state = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTROTATION: {
-                        objectEntityList[arrayVal].rotation = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTSCALE: {
-                        objectEntityList[arrayVal].scale = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTPRIORITY: {
-                        objectEntityList[arrayVal].priority = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTDRAWORDER: {
-                        objectEntityList[arrayVal].drawOrder = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTDIRECTION: {
-                        objectEntityList[arrayVal].direction = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTINKEFFECT: {
-                        objectEntityList[arrayVal].inkEffect = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTALPHA: {
-                        objectEntityList[arrayVal].alpha = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTFRAME: {
-                        objectEntityList[arrayVal].frame = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTANIMATION: {
-                        objectEntityList[arrayVal].animation = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTPREVANIMATION: {
-                        objectEntityList[arrayVal].prevAnimation = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTANIMATIONSPEED: {
-                        objectEntityList[arrayVal].animationSpeed = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTANIMATIONTIMER: {
-                        objectEntityList[arrayVal].animationTimer = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE0: {
-                        objectEntityList[arrayVal].values[0] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE1: {
-                        objectEntityList[arrayVal].values[1] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE2: {
-                        objectEntityList[arrayVal].values[2] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE3: {
-                        objectEntityList[arrayVal].values[3] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE4: {
-                        objectEntityList[arrayVal].values[4] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE5: {
-                        objectEntityList[arrayVal].values[5] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE6: {
-                        objectEntityList[arrayVal].values[6] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTVALUE7: {
-                        objectEntityList[arrayVal].values[7] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_OBJECTOUTOFBOUNDS: break;
-                    case VAR_PLAYERSTATE: {
-                        playerList[activePlayer].boundEntity->state = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERCONTROLMODE: {
-                        playerList[activePlayer].controlMode = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERCONTROLLOCK: {
-                        playerList[activePlayer].controlLock = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERCOLLISIONMODE: {
-                        playerList[activePlayer].collisionMode = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERCOLLISIONPLANE: {
-                        playerList[activePlayer].collisionPlane = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERXPOS: {
-                        playerList[activePlayer].XPos = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERYPOS: {
-                        playerList[activePlayer].YPos = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERIXPOS: {
-                        playerList[activePlayer].XPos = scriptEng.operands[i] << 16;
-                        break;
-                    }
-                    case VAR_PLAYERIYPOS: {
-                        playerList[activePlayer].YPos = scriptEng.operands[i] << 16;
-                        break;
-                    }
-                    case VAR_PLAYERSCREENXPOS: {
-                        playerList[activePlayer].screenXPos = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERSCREENYPOS: {
-                        playerList[activePlayer].screenYPos = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERSPEED: {
-                        playerList[activePlayer].speed = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERXVELOCITY: {
-                        playerList[activePlayer].XVelocity = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERYVELOCITY: {
-                        playerList[activePlayer].YVelocity = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERGRAVITY: {
-                        playerList[activePlayer].gravity = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERANGLE: {
-                        playerList[activePlayer].angle = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERSKIDDING: {
-                        playerList[activePlayer].skidding = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERPUSHING: {
-                        playerList[activePlayer].pushing = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERTRACKSCROLL: {
-                        playerList[activePlayer].trackScroll = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERUP: {
-                        playerList[activePlayer].up = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERDOWN: {
-                        playerList[activePlayer].down = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERLEFT: {
-                        playerList[activePlayer].left = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERRIGHT: {
-                        playerList[activePlayer].right = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERJUMPPRESS: {
-                        playerList[activePlayer].jumpPress = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERJUMPHOLD: {
-                        playerList[activePlayer].jumpHold = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERFOLLOWPLAYER1: {
-                        playerList[activePlayer].followPlayer1 = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERLOOKPOS: {
-                        playerList[activePlayer].lookPos = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERWATER: {
-                        playerList[activePlayer].water = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERTOPSPEED: {
-                        playerList[activePlayer].topSpeed = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERACCELERATION: {
-                        playerList[activePlayer].acceleration = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERDECELERATION: {
-                        playerList[activePlayer].deceleration = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERAIRACCELERATION: {
-                        playerList[activePlayer].airAcceleration = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERAIRDECELERATION: {
-                        playerList[activePlayer].airDeceleration = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERGRAVITYSTRENGTH: {
-                        playerList[activePlayer].gravityStrength = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERJUMPSTRENGTH: {
-                        playerList[activePlayer].jumpStrength = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERJUMPCAP: {
-                        playerList[activePlayer].jumpCap = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERROLLINGACCELERATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].rollingAcceleration = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERROLLINGDECELERATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].rollingDeceleration = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERENTITYNO: break;
-                    case VAR_PLAYERCOLLISIONLEFT: break;
-                    case VAR_PLAYERCOLLISIONTOP: break;
-                    case VAR_PLAYERCOLLISIONRIGHT: break;
-                    case VAR_PLAYERCOLLISIONBOTTOM: break;
-                    case VAR_PLAYERFLAILING: {
-                        scriptEng.operands[i] = playerList[activePlayer].flailing[arrayVal] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERTIMER: {
-                        playerList[activePlayer].timer = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERTILECOLLISIONS: {
-                        playerList[activePlayer].tileCollisions = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYEROBJECTINTERACTION: {
-                        scriptEng.operands[i] = playerList[activePlayer].objectInteractions = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERVISIBLE: {
-                        playerList[activePlayer].visible = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERROTATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->rotation = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERSCALE: {
-                        playerList[activePlayer].boundEntity->scale = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERPRIORITY: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->priority = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERDRAWORDER: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->drawOrder = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERDIRECTION: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->direction = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERINKEFFECT: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->inkEffect = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERALPHA: {
-                        playerList[activePlayer].boundEntity->alpha = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERFRAME: {
-                        playerList[activePlayer].boundEntity->frame = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERANIMATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->animation = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERPREVANIMATION: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->prevAnimation = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERANIMATIONSPEED: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->animationSpeed = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERANIMATIONTIMER: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->animationTimer = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE0: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[0] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE1: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[1] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE2: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[2] = scriptEng.operands[i];
-                        break;
-                    }
-                    case VAR_PLAYERVALUE3: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[3] = scriptEng.operands[i];
+                else {
+                    //"SetEditorIcon"
+                }
+            } NEXT_OPCODE();
+            OPCODE(FUNC_LOADPALETTE):
+                opcodeSize = 0;
+                LoadPalette(scriptText, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_ROTATEPALETTE):
+                opcodeSize = 0;
+                RotatePalette(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETSCREENFADE):
+                opcodeSize = 0;
+                SetFade(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETACTIVEPALETTE):
+                opcodeSize = 0;
+                SetActivePalette(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETPALETTEFADE):
+                opcodeSize = 0;
+                SetLimitedFade(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4],
+                               scriptEng.operands[5], scriptEng.operands[6]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_COPYPALETTE):
+                opcodeSize = 0;
+                CopyPalette(scriptEng.operands[0], scriptEng.operands[1]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_CLEARSCREEN):
+                opcodeSize = 0;
+                ClearScreen(scriptEng.operands[0]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWSPRITEFX):
+                opcodeSize  = 0;
+                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
+                switch (scriptEng.operands[1]) {
+                    default: break;
+                    case FX_SCALE:
+                        DrawSpriteScaled(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
+                                         (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY, entity->scale,
+                                         entity->scale, spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
+                                         scriptInfo->spriteSheetID);
                         break;
-                    }
-                    case VAR_PLAYERVALUE4: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[4] = scriptEng.operands[i];
+                    case FX_ROTATE:
+                        DrawSpriteRotated(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
+                                          (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY,
+                                          spriteFrame->sprX, spriteFrame->sprY, spriteFrame->width, spriteFrame->height, entity->rotation,
+                                          scriptInfo->spriteSheetID);
                         break;
-                    }
-                    case VAR_PLAYERVALUE5: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[5] = scriptEng.operands[i];
+                    case FX_ROTOZOOM:
+                        DrawSpriteRotozoom(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
+                                           (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY,
+                                           spriteFrame->sprX, spriteFrame->sprY, spriteFrame->width, spriteFrame->height, entity->rotation,
+                                           entity->scale, scriptInfo->spriteSheetID);
                         break;
-                    }
-                    case VAR_PLAYERVALUE6: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[6] = scriptEng.operands[i];
+                    case FX_INK:
+                        switch (entity->inkEffect) {
+                            case INK_NONE:
+                                DrawSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
+                                           (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
+                                           spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                                break;
+                            case INK_BLEND:
+                                DrawBlendedSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
+                                                  (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
+                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                                break;
+                            case INK_ALPHA:
+                                DrawAlphaBlendedSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
+                                                       (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
+                                                       spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, entity->alpha,
+                                                       scriptInfo->spriteSheetID);
+                                break;
+                            case INK_ADD:
+                                DrawAdditiveBlendedSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
+                                                          (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
+                                                          spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, entity->alpha,
+                                                          scriptInfo->spriteSheetID);
+                                break;
+                            case INK_SUB:
+                                DrawSubtractiveBlendedSprite((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
+                                                             (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
+                                                             spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, entity->alpha,
+                                                             scriptInfo->spriteSheetID);
+                                break;
+                        }
                         break;
-                    }
-                    case VAR_PLAYERVALUE7: {
-                        scriptEng.operands[i] = playerList[activePlayer].boundEntity->values[7] = scriptEng.operands[i];
+                    case FX_TINT:
+                        if (entity->inkEffect == INK_ALPHA) {
+                            DrawScaledTintMask(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
+                                               (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY,
+                                               entity->scale, entity->scale, spriteFrame->width, spriteFrame->height, spriteFrame->sprX,
+                                               spriteFrame->sprY, scriptInfo->spriteSheetID);
+                        }
+                        else {
+                            DrawSpriteScaled(entity->direction, (scriptEng.operands[2] >> 16) - xScrollOffset,
+                                             (scriptEng.operands[3] >> 16) - yScrollOffset, -spriteFrame->pivotX, -spriteFrame->pivotY, entity->scale,
+                                             entity->scale, spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
+                                             scriptInfo->spriteSheetID);
+                        }
                         break;
-                    }
-                    case VAR_PLAYERVALUE8: {
-                        playerList[activePlayer].values[0] = scriptEng.operands[i];
+                    case FX_FLIP:
+                        switch (entity->direction) {
+                            default:
+                            case FLIP_NONE:
+                                DrawSpriteFlipped((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
+                                                  (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
+                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_NONE, scriptInfo->spriteSheetID);
+                                break;
+                            case FLIP_X:
+                                DrawSpriteFlipped((scriptEng.operands[2] >> 16) - xScrollOffset - spriteFrame->width - spriteFrame->pivotX,
+                                                  (scriptEng.operands[3] >> 16) - yScrollOffset + spriteFrame->pivotY, spriteFrame->width,
+                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_X, scriptInfo->spriteSheetID);
+                                break;
+                            case FLIP_Y:
+                                DrawSpriteFlipped((scriptEng.operands[2] >> 16) - xScrollOffset + spriteFrame->pivotX,
+                                                  (scriptEng.operands[3] >> 16) - yScrollOffset - spriteFrame->height - spriteFrame->pivotY,
+                                                  spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_Y,
+                                                  scriptInfo->spriteSheetID);
+                                break;
+                            case FLIP_XY:
+                                DrawSpriteFlipped((scriptEng.operands[2] >> 16) - xScrollOffset - spriteFrame->width - spriteFrame->pivotX,
+                                                  (scriptEng.operands[3] >> 16) - yScrollOffset - spriteFrame->height - spriteFrame->pivotY,
+                                                  spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_XY,
+                                                  scriptInfo->spriteSheetID);
+                                break;
+                        }
                         break;
-                    }
-                    case VAR_PLAYERVALUE9: {
-                        playerList[activePlayer].values[1] = scriptEng.operands[i];
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWSPRITESCREENFX):
+                opcodeSize  = 0;
+                spriteFrame = &scriptFrames[scriptInfo->frameListOffset + scriptEng.operands[0]];
+                switch (scriptEng.operands[1]) {
+                    default: break;
+                    case FX_SCALE:
+                        DrawSpriteScaled(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX, -spriteFrame->pivotY,
+                                         entity->scale, entity->scale, spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
+                                         scriptInfo->spriteSheetID);
                         break;
-                    }
-                    case VAR_PLAYERVALUE10: {
-                        playerList[activePlayer].values[2] = scriptEng.operands[i];
+                    case FX_ROTATE:
+                        DrawSpriteRotated(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX, -spriteFrame->pivotY,
+                                          spriteFrame->sprX, spriteFrame->sprY, spriteFrame->width, spriteFrame->height, entity->rotation,
+                                          scriptInfo->spriteSheetID);
                         break;
-                    }
-                    case VAR_PLAYERVALUE11: {
-                        playerList[activePlayer].values[3] = scriptEng.operands[i];
+                    case FX_ROTOZOOM:
+                        DrawSpriteRotozoom(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX,
+                                           -spriteFrame->pivotY, spriteFrame->sprX, spriteFrame->sprY, spriteFrame->width, spriteFrame->height,
+                                           entity->rotation, entity->scale, scriptInfo->spriteSheetID);
                         break;
-                    }
-                    case VAR_PLAYERVALUE12: {
-                        playerList[activePlayer].values[4] = scriptEng.operands[i];
+                    case FX_INK:
+                        switch (entity->inkEffect) {
+                            case INK_NONE:
+                                DrawSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
+                                           spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                                break;
+                            case INK_BLEND:
+                                DrawBlendedSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
+                                                  spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
+                                                  scriptInfo->spriteSheetID);
+                                break;
+                            case INK_ALPHA:
+                                DrawAlphaBlendedSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
+                                                       spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, entity->alpha,
+                                                       scriptInfo->spriteSheetID);
+                                break;
+                            case INK_ADD:
+                                DrawAdditiveBlendedSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
+                                                          spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
+                                                          entity->alpha, scriptInfo->spriteSheetID);
+                                break;
+                            case INK_SUB:
+                                DrawSubtractiveBlendedSprite(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
+                                                             spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY,
+                                                             entity->alpha, scriptInfo->spriteSheetID);
+                                break;
+                        }
                         break;
-                    }
-                    case VAR_PLAYERVALUE13: {
-                        playerList[activePlayer].values[5] = scriptEng.operands[i];
+                    case FX_TINT:
+                        if (entity->inkEffect == INK_ALPHA) {
+                            DrawScaledTintMask(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX,
+                                               -spriteFrame->pivotY, entity->scale, entity->scale, spriteFrame->width, spriteFrame->height,
+                                               spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                        }
+                        else {
+                            DrawSpriteScaled(entity->direction, scriptEng.operands[2], scriptEng.operands[3], -spriteFrame->pivotX,
+                                             -spriteFrame->pivotY, entity->scale, entity->scale, spriteFrame->width, spriteFrame->height,
+                                             spriteFrame->sprX, spriteFrame->sprY, scriptInfo->spriteSheetID);
+                        }
                         break;
-                    }
-                    case VAR_PLAYERVALUE14: {
-                        playerList[activePlayer].values[6] = scriptEng.operands[i];
+                    case FX_FLIP:
+                        switch (entity->direction) {
+                            default:
+                            case FLIP_NONE:
+                                DrawSpriteFlipped(scriptEng.operands[2] + spriteFrame->pivotX, scriptEng.operands[3] + spriteFrame->pivotY,
+                                                  spriteFrame->width, spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_NONE,
+                                                  scriptInfo->spriteSheetID);
+                                break;
+                            case FLIP_X:
+                                DrawSpriteFlipped(scriptEng.operands[2] - spriteFrame->width - spriteFrame->pivotX,
+                                                  scriptEng.operands[3] + spriteFrame->pivotY, spriteFrame->width, spriteFrame->height,
+                                                  spriteFrame->sprX, spriteFrame->sprY, FLIP_X, scriptInfo->spriteSheetID);
+                                break;
+                            case FLIP_Y:
+                                DrawSpriteFlipped(scriptEng.operands[2] + spriteFrame->pivotX,
+                                                  scriptEng.operands[3] - spriteFrame->height - spriteFrame->pivotY, spriteFrame->width,
+                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_Y, scriptInfo->spriteSheetID);
+                                break;
+                            case FLIP_XY:
+                                DrawSpriteFlipped(scriptEng.operands[2] - spriteFrame->width - spriteFrame->pivotX,
+                                                  scriptEng.operands[3] - spriteFrame->height - spriteFrame->pivotY, spriteFrame->width,
+                                                  spriteFrame->height, spriteFrame->sprX, spriteFrame->sprY, FLIP_XY, scriptInfo->spriteSheetID);
+                                break;
+                        }
                         break;
-                    }
-                    case VAR_PLAYERVALUE15: {
-                        playerList[activePlayer].values[7] = scriptEng.operands[i];
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_LOADANIMATION):
+                opcodeSize           = 0;
+                scriptInfo->animFile = AddAnimationFile(scriptText);
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETUPMENU): {
+                opcodeSize     = 0;
+                TextMenu *menu = &gameMenu[scriptEng.operands[0]];
+                SetupTextMenu(menu, scriptEng.operands[1]);
+                menu->selectionCount = scriptEng.operands[2];
+                menu->alignment      = scriptEng.operands[3];
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_ADDMENUENTRY): {
+                opcodeSize                           = 0;
+                TextMenu *menu                       = &gameMenu[scriptEng.operands[0]];
+                menu->entryHighlight[menu->rowCount] = scriptEng.operands[2];
+                AddTextMenuEntry(menu, scriptText);
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_EDITMENUENTRY): {
+                opcodeSize     = 0;
+                TextMenu *menu = &gameMenu[scriptEng.operands[0]];
+                EditTextMenuEntry(menu, scriptText, scriptEng.operands[2]);
+                menu->entryHighlight[scriptEng.operands[2]] = scriptEng.operands[3];
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_LOADSTAGE):
+                opcodeSize = 0;
+                stageMode  = STAGEMODE_LOAD;
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWRECT):
+                opcodeSize = 0;
+                DrawRectangle(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4],
+                              scriptEng.operands[5], scriptEng.operands[6], scriptEng.operands[7]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_RESETOBJECTENTITY): {
+                opcodeSize            = 0;
+                Entity *newEnt        = &objectEntityList[scriptEng.operands[0]];
+                SetObjectEntityType(scriptEng.operands[0], scriptEng.operands[1]);
+                newEnt->propertyValue = scriptEng.operands[2];
+                newEnt->XPos          = scriptEng.operands[3];
+                newEnt->YPos          = scriptEng.operands[4];
+                newEnt->direction     = FLIP_NONE;
+                newEnt->frame         = 0;
+                SetObjectEntityPriority(scriptEng.operands[0], PRIORITY_BOUNDS);
+                newEnt->rotation      = 0;
+                newEnt->state         = 0;
+                newEnt->drawOrder     = 3;
+                newEnt->scale         = 0x200;
+                newEnt->inkEffect     = INK_NONE;
+                newEnt->values[0]     = 0;
+                newEnt->values[1]     = 0;
+                newEnt->values[2]     = 0;
+                newEnt->values[3]     = 0;
+                newEnt->values[4]     = 0;
+                newEnt->values[5]     = 0;
+                newEnt->values[6]     = 0;
+                newEnt->values[7]     = 0;
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_PLAYEROBJECTCOLLISION):
+                opcodeSize              = 0;
+                switch (scriptEng.operands[0]) {
+                    default: break;
+                    case C_TOUCH:
+                        scriptEng.operands[5] = entity->XPos >> 16;
+                        scriptEng.operands[6] = entity->YPos >> 16;
+                        TouchCollision(scriptEng.operands[5] + scriptEng.operands[1], scriptEng.operands[6] + scriptEng.operands[2],
+                                       scriptEng.operands[5] + scriptEng.operands[3], scriptEng.operands[6] + scriptEng.operands[4]);
                         break;
-                    }
-                    case VAR_PLAYEROUTOFBOUNDS: break;
-                    case VAR_STAGESTATE: stageMode = scriptEng.operands[i]; break;
-                    case VAR_STAGEACTIVELIST: activeStageList = scriptEng.operands[i]; break;
-                    case VAR_STAGELISTPOS: stageListPosition = scriptEng.operands[i]; break;
-                    case VAR_STAGETIMEENABLED: timeEnabled = scriptEng.operands[i]; break;
-                    case VAR_STAGEMILLISECONDS: stageMilliseconds = scriptEng.operands[i]; break;
-                    case VAR_STAGESECONDS: stageSeconds = scriptEng.operands[i]; break;
-                    case VAR_STAGEMINUTES: stageMinutes = scriptEng.operands[i]; break;
-                    case VAR_STAGEACTNO: actID = scriptEng.operands[i]; break;
-                    case VAR_STAGEPAUSEENABLED: pauseEnabled = scriptEng.operands[i]; break;
-                    case VAR_STAGELISTSIZE: break;
-                    case VAR_STAGENEWXBOUNDARY1: newXBoundary1 = scriptEng.operands[i]; break;
-                    case VAR_STAGENEWXBOUNDARY2: newXBoundary2 = scriptEng.operands[i]; break;
-                    case VAR_STAGENEWYBOUNDARY1: newYBoundary1 = scriptEng.operands[i]; break;
-                    case VAR_STAGENEWYBOUNDARY2: newYBoundary2 = scriptEng.operands[i]; break;
-                    case VAR_STAGEXBOUNDARY1:
-                        if (xBoundary1 != scriptEng.operands[i]) {
-                            xBoundary1    = scriptEng.operands[i];
-                            newXBoundary1 = scriptEng.operands[i];
-                        }
+                    case C_BOX:
+                        BoxCollision(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
+                                     entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
                         break;
-                    case VAR_STAGEXBOUNDARY2:
-                        if (xBoundary2 != scriptEng.operands[i]) {
-                            xBoundary2    = scriptEng.operands[i];
-                            newXBoundary2 = scriptEng.operands[i];
+                    case C_BOX2:
+                        // C_PLATFORM if pc ver, as there's no box2 there
+                        if (!scriptInfo->mobile) {
+                            PlatformCollision(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
+                                              entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
                         }
-                        break;
-                    case VAR_STAGEYBOUNDARY1:
-                        if (yBoundary1 != scriptEng.operands[i]) {
-                            yBoundary1    = scriptEng.operands[i];
-                            newYBoundary1 = scriptEng.operands[i];
+                        else {
+                            BoxCollision2(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
+                                          entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
                         }
                         break;
-                    case VAR_STAGEYBOUNDARY2:
-                        if (yBoundary2 != scriptEng.operands[i]) {
-                            yBoundary2    = scriptEng.operands[i];
-                            newYBoundary2 = scriptEng.operands[i];
+                    case C_PLATFORM:
+                        if (scriptInfo->mobile) {
+                            PlatformCollision(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
+                                              entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
                         }
                         break;
-                    case VAR_STAGEDEFORMATIONDATA0: bgDeformationData0[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_STAGEDEFORMATIONDATA1: bgDeformationData1[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_STAGEDEFORMATIONDATA2: bgDeformationData2[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_STAGEDEFORMATIONDATA3: bgDeformationData3[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_STAGEWATERLEVEL: waterLevel = scriptEng.operands[i]; break;
-                    case VAR_STAGEACTIVELAYER: activeTileLayers[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_STAGEMIDPOINT: tLayerMidPoint = scriptEng.operands[i]; break;
-                    case VAR_STAGEPLAYERLISTPOS: playerListPos = scriptEng.operands[i]; break;
-                    case VAR_STAGEACTIVEPLAYER:
-                        activePlayer = scriptEng.operands[i];
-                        if (activePlayer > activePlayerCount)
-                            activePlayer = 0;
-                        break;
-                    case VAR_SCREENCAMERAENABLED: cameraEnabled = scriptEng.operands[i]; break;
-                    case VAR_SCREENCAMERATARGET: cameraTarget = scriptEng.operands[i]; break;
-                    case VAR_SCREENCAMERASTYLE: cameraStyle = scriptEng.operands[i]; break;
-                    case VAR_SCREENDRAWLISTSIZE: drawListEntries[arrayVal].listSize = scriptEng.operands[i]; break;
-                    case VAR_SCREENCENTERX: break;
-                    case VAR_SCREENCENTERY: break;
-                    case VAR_SCREENXSIZE: break;
-                    case VAR_SCREENYSIZE: break;
-                    case VAR_SCREENXOFFSET:
-                        xScrollOffset = scriptEng.operands[i];
-                        xScrollA      = xScrollOffset;
-                        xScrollB      = SCREEN_XSIZE + xScrollOffset;
-                        break;
-                    case VAR_SCREENYOFFSET:
-                        yScrollOffset = scriptEng.operands[i];
-                        yScrollA      = yScrollOffset;
-                        yScrollB      = SCREEN_YSIZE + yScrollOffset;
+                    case C_BOX3:
+                        BoxCollision3(entity->XPos + (scriptEng.operands[1] << 16), entity->YPos + (scriptEng.operands[2] << 16),
+                                      entity->XPos + (scriptEng.operands[3] << 16), entity->YPos + (scriptEng.operands[4] << 16));
                         break;
-                    case VAR_SCREENSHAKEX: cameraShakeX = scriptEng.operands[i]; break;
-                    case VAR_SCREENSHAKEY: cameraShakeY = scriptEng.operands[i]; break;
-                    case VAR_SCREENADJUSTCAMERAY: cameraAdjustY = scriptEng.operands[i]; break;
-                    case VAR_TOUCHSCREENDOWN: break;
-                    case VAR_TOUCHSCREENXPOS: break;
-                    case VAR_TOUCHSCREENYPOS: break;
-                    case VAR_MUSICVOLUME: SetMusicVolume(scriptEng.operands[i]); break;
-                    case VAR_MUSICCURRENTTRACK: break;
-                    case VAR_KEYDOWNUP: keyDown.up = scriptEng.operands[i]; break;
-                    case VAR_KEYDOWNDOWN: keyDown.down = scriptEng.operands[i]; break;
-                    case VAR_KEYDOWNLEFT: keyDown.left = scriptEng.operands[i]; break;
-                    case VAR_KEYDOWNRIGHT: keyDown.right = scriptEng.operands[i]; break;
-                    case VAR_KEYDOWNBUTTONA: keyDown.A = scriptEng.operands[i]; break;
-                    case VAR_KEYDOWNBUTTONB: keyDown.B = scriptEng.operands[i]; break;
-                    case VAR_KEYDOWNBUTTONC: keyDown.C = scriptEng.operands[i]; break;
-                    case VAR_KEYDOWNSTART: keyDown.start = scriptEng.operands[i]; break;
-                    case VAR_KEYPRESSUP: keyPress.up = scriptEng.operands[i]; break;
-                    case VAR_KEYPRESSDOWN: keyPress.down = scriptEng.operands[i]; break;
-                    case VAR_KEYPRESSLEFT: keyPress.left = scriptEng.operands[i]; break;
-                    case VAR_KEYPRESSRIGHT: keyPress.right = scriptEng.operands[i]; break;
-                    case VAR_KEYPRESSBUTTONA: keyPress.A = scriptEng.operands[i]; break;
-                    case VAR_KEYPRESSBUTTONB: keyPress.B = scriptEng.operands[i]; break;
-                    case VAR_KEYPRESSBUTTONC: keyPress.C = scriptEng.operands[i]; break;
-                    case VAR_KEYPRESSSTART: keyPress.start = scriptEng.operands[i]; break;
-                    case VAR_MENU1SELECTION: gameMenu[0].selection1 = scriptEng.operands[i]; break;
-                    case VAR_MENU2SELECTION: gameMenu[1].selection1 = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERXSIZE: stageLayouts[arrayVal].xsize = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERYSIZE: stageLayouts[arrayVal].ysize = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERTYPE: stageLayouts[arrayVal].type = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERANGLE:
-                        stageLayouts[arrayVal].angle = scriptEng.operands[i];
-                        if (stageLayouts[arrayVal].angle < 0)
-                            stageLayouts[arrayVal].angle += 0x200;
-                        stageLayouts[arrayVal].angle &= 0x1FFu;
+                    case C_ENEMY:
+                        scriptEng.operands[5] = entity->XPos >> 16;
+                        scriptEng.operands[6] = entity->YPos >> 16;
+                        EnemyCollision(scriptEng.operands[5] + scriptEng.operands[1], scriptEng.operands[6] + scriptEng.operands[2],
+                                      scriptEng.operands[5] + scriptEng.operands[3], scriptEng.operands[6] + scriptEng.operands[4]);
                         break;
-                    case VAR_TILELAYERXPOS: stageLayouts[arrayVal].XPos = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERYPOS: stageLayouts[arrayVal].YPos = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERZPOS: stageLayouts[arrayVal].ZPos = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERPARALLAXFACTOR: stageLayouts[arrayVal].parallaxFactor = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERSCROLLSPEED: stageLayouts[arrayVal].scrollSpeed = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERSCROLLPOS: stageLayouts[arrayVal].scrollPos = scriptEng.operands[i]; break;
-                    case VAR_TILELAYERDEFORMATIONOFFSET:
-                        stageLayouts[arrayVal].deformationOffset = scriptEng.operands[i];
-                        stageLayouts[arrayVal].deformationOffset &= 0xFFu;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_CREATETEMPOBJECT): {
+                opcodeSize = 0;
+                if (objectEntityList[scriptEng.arrayPosition[2]].type > 0 && ++scriptEng.arrayPosition[2] == ENTITY_COUNT)
+                    scriptEng.arrayPosition[2] = TEMPENTITY_START;
+                Entity *temp         = &objectEntityList[scriptEng.arrayPosition[2]];
+                SetObjectEntityType(scriptEng.arrayPosition[2], scriptEng.operands[0]);
+                temp->propertyValue  = scriptEng.operands[1];
+                temp->XPos           = scriptEng.operands[2];
+                temp->YPos           = scriptEng.operands[3];
+                temp->direction      = FLIP_NONE;
+                temp->frame          = 0;
+                SetObjectEntityPriority(scriptEng.arrayPosition[2], PRIORITY_ACTIVE);
+                temp->rotation       = 0;
+                temp->state          = 0;
+                temp->drawOrder      = 3;
+                temp->scale          = 512;
+                temp->inkEffect      = INK_NONE;
+                temp->alpha          = 0;
+                temp->animation      = 0;
+                temp->prevAnimation  = 0;
+                temp->animationSpeed = 0;
+                temp->animationTimer = 0;
+                temp->values[0]      = 0;
+                temp->values[1]      = 0;
+                temp->values[2]      = 0;
+                temp->values[3]      = 0;
+                temp->values[4]      = 0;
+                temp->values[5]      = 0;
+                temp->values[6]      = 0;
+                temp->values[7]      = 0;
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_BINDPLAYERTOOBJECT): {
+                opcodeSize   = 0;
+                Entity *pEnt = &objectEntityList[scriptEng.operands[1]];
+
+                playerList[scriptEng.operands[0]].animationFile = scriptInfo->animFile;
+                playerList[scriptEng.operands[0]].boundEntity   = pEnt;
+                playerList[scriptEng.operands[0]].entityNo      = scriptEng.operands[1];
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_PLAYERTILECOLLISION):
+                opcodeSize = 0;
+                if (player->tileCollisions) {
+                    ProcessPlayerTileCollisions(player);
+                }
+                else {
+                    player->XPos += player->XVelocity;
+                    player->YPos += player->YVelocity;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_PROCESSPLAYERCONTROL):
+                opcodeSize = 0;
+                ProcessPlayerControl(player);
+                NEXT_OPCODE();
+            OPCODE(FUNC_PROCESSANIMATION):
+                ProcessObjectAnimation(scriptInfo, entity);
+                opcodeSize = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWOBJECTANIMATION):
+                opcodeSize = 0;
+                DrawObjectAnimation(scriptInfo, entity, (entity->XPos >> 16) - xScrollOffset, (entity->YPos >> 16) - yScrollOffset);
+                NEXT_OPCODE();
+            OPCODE(FUNC_DRAWPLAYERANIMATION):
+                opcodeSize = 0;
+                if (player->visible) {
+                    if (cameraTarget == activePlayer)
+                        DrawObjectAnimation(scriptInfo, entity, player->screenXPos, player->screenYPos);
+                    else
+                        DrawObjectAnimation(scriptInfo, entity, (player->XPos >> 16) - xScrollOffset, (player->YPos >> 16) - yScrollOffset);
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETMUSICTRACK):
+                opcodeSize = 0;
+                if (scriptEng.operands[2] <= 1)
+                    SetMusicTrack(scriptText, scriptEng.operands[1], scriptEng.operands[2], 0);
+                else
+                    SetMusicTrack(scriptText, scriptEng.operands[1], true, scriptEng.operands[2]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_PLAYMUSIC):
+                opcodeSize = 0;
+                PlayMusic(scriptEng.operands[0]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_STOPMUSIC):
+                opcodeSize = 0;
+                StopMusic();
+                NEXT_OPCODE();
+            OPCODE(FUNC_PLAYSFX):
+                opcodeSize = 0;
+                PlaySfx(scriptEng.operands[0], scriptEng.operands[1]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_STOPSFX):
+                opcodeSize = 0;
+                StopSfx(scriptEng.operands[0]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETSFXATTRIBUTES):
+                opcodeSize = 0;
+                SetSfxAttributes(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_OBJECTTILECOLLISION):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    default: break;
+                    case CSIDE_FLOOR: ObjectFloorCollision(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case CSIDE_LWALL: ObjectLWallCollision(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case CSIDE_RWALL: ObjectRWallCollision(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case CSIDE_ROOF: ObjectRoofCollision(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_OBJECTTILEGRIP):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    default: break;
+                    case CSIDE_FLOOR: ObjectFloorGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case CSIDE_LWALL: ObjectLWallGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case CSIDE_RWALL: ObjectRWallGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case CSIDE_ROOF: ObjectRoofGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case CSIDE_ENTITY: ObjectEntityGrip(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_LOADVIDEO):
+                opcodeSize = 0;
+                PauseSound();
+                if (FindStringToken(scriptText, ".rsv", 1) <= -1)
+                    PlayVideoFile(scriptText); // not an rsv
+                else
+                    scriptInfo->spriteSheetID = AddGraphicsFile(scriptText);
+                ResumeSound();
+                NEXT_OPCODE();
+            OPCODE(FUNC_NEXTVIDEOFRAME):
+                opcodeSize = 0;
+                UpdateVideoFrame();
+                NEXT_OPCODE();
+            OPCODE(FUNC_PLAYSTAGESFX):
+                opcodeSize = 0;
+                PlaySfx(globalSFXCount + scriptEng.operands[0], scriptEng.operands[1]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_STOPSTAGESFX):
+                opcodeSize = 0;
+                StopSfx(globalSFXCount + scriptEng.operands[0]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_NOT): scriptEng.operands[0] = ~scriptEng.operands[0]; NEXT_OPCODE();
+            OPCODE(FUNC_DRAW3DSCENE):
+                opcodeSize = 0;
+                TransformVertexBuffer();
+                Sort3DDrawList();
+                Draw3DScene(scriptInfo->spriteSheetID);
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETIDENTITYMATRIX):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    case MAT_WORLD: SetIdentityMatrix(&matWorld); break;
+                    case MAT_VIEW: SetIdentityMatrix(&matView); break;
+                    case MAT_TEMP: SetIdentityMatrix(&matTemp); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_MATRIXMULTIPLY):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    case MAT_WORLD:
+                        switch (scriptEng.operands[1]) {
+                            case MAT_WORLD: MatrixMultiply(&matWorld, &matWorld); break;
+                            case MAT_VIEW: MatrixMultiply(&matWorld, &matView); break;
+                            case MAT_TEMP: MatrixMultiply(&matWorld, &matTemp); break;
+                        }
                         break;
-                    case VAR_TILELAYERDEFORMATIONOFFSETW:
-                        stageLayouts[arrayVal].deformationOffsetW = scriptEng.operands[i];
-                        stageLayouts[arrayVal].deformationOffsetW &= 0xFFu;
+                    case MAT_VIEW:
+                        switch (scriptEng.operands[1]) {
+                            case MAT_WORLD: MatrixMultiply(&matView, &matWorld); break;
+                            case MAT_VIEW: MatrixMultiply(&matView, &matView); break;
+                            case MAT_TEMP: MatrixMultiply(&matView, &matTemp); break;
+                        }
                         break;
-                    case VAR_HPARALLAXPARALLAXFACTOR: hParallax.parallaxFactor[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_HPARALLAXSCROLLSPEED: hParallax.scrollSpeed[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_HPARALLAXSCROLLPOS: hParallax.scrollPos[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_VPARALLAXPARALLAXFACTOR: vParallax.parallaxFactor[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_VPARALLAXSCROLLSPEED: vParallax.scrollSpeed[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_VPARALLAXSCROLLPOS: vParallax.scrollPos[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_3DSCENENOVERTICES: vertexCount = scriptEng.operands[i]; break;
-                    case VAR_3DSCENENOFACES: faceCount = scriptEng.operands[i]; break;
-                    case VAR_VERTEXBUFFERX: vertexBuffer[arrayVal].x = scriptEng.operands[i]; break;
-                    case VAR_VERTEXBUFFERY: vertexBuffer[arrayVal].y = scriptEng.operands[i]; break;
-                    case VAR_VERTEXBUFFERZ: vertexBuffer[arrayVal].z = scriptEng.operands[i]; break;
-                    case VAR_VERTEXBUFFERU: vertexBuffer[arrayVal].u = scriptEng.operands[i]; break;
-                    case VAR_VERTEXBUFFERV: vertexBuffer[arrayVal].v = scriptEng.operands[i]; break;
-                    case VAR_FACEBUFFERA: faceBuffer[arrayVal].a = scriptEng.operands[i]; break;
-                    case VAR_FACEBUFFERB: faceBuffer[arrayVal].b = scriptEng.operands[i]; break;
-                    case VAR_FACEBUFFERC: faceBuffer[arrayVal].c = scriptEng.operands[i]; break;
-                    case VAR_FACEBUFFERD: faceBuffer[arrayVal].d = scriptEng.operands[i]; break;
-                    case VAR_FACEBUFFERFLAG: faceBuffer[arrayVal].flags = scriptEng.operands[i]; break;
-                    case VAR_FACEBUFFERCOLOR: faceBuffer[arrayVal].colour = scriptEng.operands[i]; break;
-                    case VAR_3DSCENEPROJECTIONX: projectionX = scriptEng.operands[i]; break;
-                    case VAR_3DSCENEPROJECTIONY: projectionY = scriptEng.operands[i]; break;
-                    case VAR_ENGINESTATE: Engine.gameMode = scriptEng.operands[i]; break;
-                    case VAR_STAGEDEBUGMODE: debugMode = scriptEng.operands[i]; break;
-                    case VAR_ENGINEMESSAGE: break;
-                    case VAR_SAVERAM: saveRAM[arrayVal] = scriptEng.operands[i]; break;
-                    case VAR_ENGINELANGUAGE: Engine.language = scriptEng.operands[i]; break;
-                    case VAR_OBJECTSPRITESHEET: {
-                        objectScriptList[objectEntityList[arrayVal].type].spriteSheetID = scriptEng.operands[i];
+                    case MAT_TEMP:
+                        switch (scriptEng.operands[1]) {
+                            case MAT_WORLD: MatrixMultiply(&matTemp, &matWorld); break;
+                            case MAT_VIEW: MatrixMultiply(&matTemp, &matView); break;
+                            case MAT_TEMP: MatrixMultiply(&matTemp, &matTemp); break;
+                        }
                         break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_MATRIXTRANSLATEXYZ):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    case MAT_WORLD: MatrixTranslateXYZ(&matWorld, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case MAT_VIEW: MatrixTranslateXYZ(&matView, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case MAT_TEMP: MatrixTranslateXYZ(&matTemp, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_MATRIXSCALEXYZ):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    case MAT_WORLD: MatrixScaleXYZ(&matWorld, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case MAT_VIEW: MatrixScaleXYZ(&matView, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case MAT_TEMP: MatrixScaleXYZ(&matTemp, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_MATRIXROTATEX):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    case MAT_WORLD: MatrixRotateX(&matWorld, scriptEng.operands[1]); break;
+                    case MAT_VIEW: MatrixRotateX(&matView, scriptEng.operands[1]); break;
+                    case MAT_TEMP: MatrixRotateX(&matTemp, scriptEng.operands[1]); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_MATRIXROTATEY):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    case MAT_WORLD: MatrixRotateY(&matWorld, scriptEng.operands[1]); break;
+                    case MAT_VIEW: MatrixRotateY(&matView, scriptEng.operands[1]); break;
+                    case MAT_TEMP: MatrixRotateY(&matTemp, scriptEng.operands[1]); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_MATRIXROTATEZ):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    case MAT_WORLD: MatrixRotateZ(&matWorld, scriptEng.operands[1]); break;
+                    case MAT_VIEW: MatrixRotateZ(&matView, scriptEng.operands[1]); break;
+                    case MAT_TEMP: MatrixRotateZ(&matTemp, scriptEng.operands[1]); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_MATRIXROTATEXYZ):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    case MAT_WORLD: MatrixRotateXYZ(&matWorld, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case MAT_VIEW: MatrixRotateXYZ(&matView, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                    case MAT_TEMP: MatrixRotateXYZ(&matTemp, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_TRANSFORMVERTICES):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    case MAT_WORLD: TransformVerticies(&matWorld, scriptEng.operands[1], scriptEng.operands[2]); break;
+                    case MAT_VIEW: TransformVerticies(&matView, scriptEng.operands[1], scriptEng.operands[2]); break;
+                    case MAT_TEMP: TransformVerticies(&matTemp, scriptEng.operands[1], scriptEng.operands[2]); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_CALLFUNCTION): {
+                opcodeSize                        = 0;
+                functionStack[functionStackPos++] = scriptCodePtr;
+                functionStack[functionStackPos++] = jumpTableStart;
+                functionStack[functionStackPos++] = scriptCodeStart;
+                scriptCodeStart                   = scriptFunctionList[scriptEng.operands[0]].ptr.scriptCodePtr;
+                jumpTableStart                    = scriptFunctionList[scriptEng.operands[0]].ptr.jumpTablePtr;
+                scriptCodePtr                     = scriptCodeStart;
+            } NEXT_OPCODE();
+            OPCODE(FUNC_ENDFUNCTION):
+                opcodeSize      = 0;
+                scriptCodeStart = functionStack[--functionStackPos];
+                jumpTableStart  = functionStack[--functionStackPos];
+                scriptCodePtr   = functionStack[--functionStackPos];
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETLAYERDEFORMATION):
+                opcodeSize = 0;
+                SetLayerDeformation(scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4],
+                                    scriptEng.operands[5]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_CHECKTOUCHRECT): opcodeSize = 0; scriptEng.checkResult = -1;
+#if !RETRO_USE_ORIGINAL_CODE
+                AddDebugHitbox(H_TYPE_FINGER, NULL, scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]);
+#endif
+                for (int f = 0; f < touches; ++f) {
+                    if (touchDown[f] && touchX[f] > scriptEng.operands[0] && touchX[f] < scriptEng.operands[2] && touchY[f] > scriptEng.operands[1]
+                        && touchY[f] < scriptEng.operands[3]) {
+                        scriptEng.checkResult = f;
                     }
-                    case VAR_ENGINEONLINEACTIVE: break;
-                    case VAR_ENGINEFRAMESKIPTIMER: Engine.frameSkipTimer = scriptEng.operands[i]; break;
-                    case VAR_ENGINEFRAMESKIPSETTING: Engine.frameSkipSetting = scriptEng.operands[i]; break;
-                    case VAR_ENGINESFXVOLUME:
-                        sfxVolume = scriptEng.operands[i];
-                        if (sfxVolume < 0)
-                            sfxVolume = 0;
-                        if (sfxVolume > MAX_VOLUME)
-                            sfxVolume = MAX_VOLUME;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_GETTILELAYERENTRY):
+                scriptEng.operands[0] = stageLayouts[scriptEng.operands[1]].tiles[scriptEng.operands[2] + 0x100 * scriptEng.operands[3]];
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETTILELAYERENTRY):
+                FlushDrawCommands(); // queued layer draws may still be reading the layout
+                InvalidateTileRowCache();
+                stageLayouts[scriptEng.operands[1]].tiles[scriptEng.operands[2] + 0x100 * scriptEng.operands[3]] = scriptEng.operands[0];
+                NEXT_OPCODE();
+            OPCODE(FUNC_GETBIT): scriptEng.operands[0] = (scriptEng.operands[1] & (1 << scriptEng.operands[2])) >> scriptEng.operands[2]; NEXT_OPCODE();
+            OPCODE(FUNC_SETBIT):
+                if (scriptEng.operands[2] <= 0)
+                    scriptEng.operands[0] &= ~(1 << scriptEng.operands[1]);
+                else
+                    scriptEng.operands[0] |= 1 << scriptEng.operands[1];
+                NEXT_OPCODE();
+            OPCODE(FUNC_PAUSEMUSIC):
+                opcodeSize = 0;
+                PauseSound();
+                NEXT_OPCODE();
+            OPCODE(FUNC_RESUMEMUSIC):
+                opcodeSize = 0;
+                ResumeSound();
+                NEXT_OPCODE();
+            OPCODE(FUNC_CLEARDRAWLIST):
+                opcodeSize = 0;
+                SyncDrawLists(true);
+                drawListEntries[scriptEng.operands[0]].listSize = 0;
+                NEXT_OPCODE();
+            OPCODE(FUNC_ADDDRAWLISTENTITYREF): {
+                opcodeSize = 0;
+                SyncDrawLists(true);
+                drawListEntries[scriptEng.operands[0]].entityRefs[drawListEntries[scriptEng.operands[0]].listSize++] = scriptEng.operands[1];
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_GETDRAWLISTENTITYREF):
+                SyncDrawLists(false);
+                scriptEng.operands[0] = drawListEntries[scriptEng.operands[1]].entityRefs[scriptEng.operands[2]];
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETDRAWLISTENTITYREF):
+                opcodeSize = 0;
+                SyncDrawLists(true);
+                drawListEntries[scriptEng.operands[1]].entityRefs[scriptEng.operands[2]] = scriptEng.operands[0];
+                NEXT_OPCODE();
+            OPCODE(FUNC_GET16X16TILEINFO): {
+                scriptEng.operands[4] = scriptEng.operands[1] >> 7;
+                scriptEng.operands[5] = scriptEng.operands[2] >> 7;
+                scriptEng.operands[6] = stageLayouts[0].tiles[scriptEng.operands[4] + (scriptEng.operands[5] << 8)] << 6;
+                scriptEng.operands[6] += ((scriptEng.operands[1] & 0x7F) >> 4) + 8 * ((scriptEng.operands[2] & 0x7F) >> 4);
+                int index = tiles128x128.tileIndex[scriptEng.operands[6]];
+                switch (scriptEng.operands[3]) {
+                    case TILEINFO_INDEX: scriptEng.operands[0] = tiles128x128.tileIndex[scriptEng.operands[6]]; break;
+                    case TILEINFO_DIRECTION: scriptEng.operands[0] = tiles128x128.direction[scriptEng.operands[6]]; break;
+                    case TILEINFO_VISUALPLANE: scriptEng.operands[0] = tiles128x128.visualPlane[scriptEng.operands[6]]; break;
+                    case TILEINFO_SOLIDITYA: scriptEng.operands[0] = tiles128x128.collisionFlags[0][scriptEng.operands[6]]; break;
+                    case TILEINFO_SOLIDITYB: scriptEng.operands[0] = tiles128x128.collisionFlags[1][scriptEng.operands[6]]; break;
+                    case TILEINFO_FLAGSA: scriptEng.operands[0] = collisionMasks[0].flags[index]; break;
+                    case TILEINFO_ANGLEA: scriptEng.operands[0] = collisionMasks[0].angles[index]; break;
+                    case TILEINFO_FLAGSB: scriptEng.operands[0] = collisionMasks[1].flags[index]; break;
+                    case TILEINFO_ANGLEB: scriptEng.operands[0] = collisionMasks[1].angles[index]; break;
+                    default: break;
+                }
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_COPY16X16TILE):
+                opcodeSize = 0;
+                Copy16x16Tile(scriptEng.operands[0], scriptEng.operands[1]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_SET16X16TILEINFO): {
+                FlushDrawCommands();
+                InvalidateTileRowCache();
+                scriptEng.operands[4] = scriptEng.operands[1] >> 7;
+                scriptEng.operands[5] = scriptEng.operands[2] >> 7;
+                scriptEng.operands[6] = stageLayouts[0].tiles[scriptEng.operands[4] + (scriptEng.operands[5] << 8)] << 6;
+                scriptEng.operands[6] += ((scriptEng.operands[1] & 0x7F) >> 4) + 8 * ((scriptEng.operands[2] & 0x7F) >> 4);
+                switch (scriptEng.operands[3]) {
+                    case TILEINFO_INDEX:
+                        tiles128x128.tileIndex[scriptEng.operands[6]]  = scriptEng.operands[0];
+                        if (renderType == RENDER_SW)
+                            tiles128x128.gfxDataPos[scriptEng.operands[6]] = scriptEng.operands[0] << 8;
+                        else if (renderType == RENDER_HW)
+                            tiles128x128.gfxDataPos[scriptEng.operands[6]] = (scriptEng.operands[0] << 2) & 0x3FFFC;
                         break;
-                    case VAR_ENGINEBGMVOLUME:
-                        bgmVolume = scriptEng.operands[i];
-                        if (bgmVolume < 0)
-                            bgmVolume = 0;
-                        if (bgmVolume > MAX_VOLUME)
-                            bgmVolume = MAX_VOLUME;
+                    case TILEINFO_DIRECTION: tiles128x128.direction[scriptEng.operands[6]] = scriptEng.operands[0]; break;
+                    case TILEINFO_VISUALPLANE: tiles128x128.visualPlane[scriptEng.operands[6]] = scriptEng.operands[0]; break;
+                    case TILEINFO_SOLIDITYA: tiles128x128.collisionFlags[0][scriptEng.operands[6]] = scriptEng.operands[0]; break;
+                    case TILEINFO_SOLIDITYB: tiles128x128.collisionFlags[1][scriptEng.operands[6]] = scriptEng.operands[0]; break;
+                    case TILEINFO_FLAGSA: collisionMasks[1].flags[tiles128x128.tileIndex[scriptEng.operands[6]]] = scriptEng.operands[0]; break;
+                    case TILEINFO_ANGLEA: collisionMasks[1].angles[tiles128x128.tileIndex[scriptEng.operands[6]]] = scriptEng.operands[0]; break;
+                    default: break;
+                }
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_GETANIMATIONBYNAME): {
+                AnimationFile *animFile = scriptInfo->animFile;
+                scriptEng.operands[0]   = -1;
+                int id                  = 0;
+                while (scriptEng.operands[0] == -1) {
+                    SpriteAnimation *anim = &animationList[animFile->aniListOffset + id];
+                    if (StrComp(scriptText, anim->name))
+                        scriptEng.operands[0] = id;
+                    else if (++id == animFile->animCount)
+                        scriptEng.operands[0] = 0;
+                }
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_READSAVERAM):
+                opcodeSize            = 0;
+                scriptEng.checkResult = ReadSaveRAMData();
+                NEXT_OPCODE();
+            OPCODE(FUNC_WRITESAVERAM):
+                opcodeSize            = 0;
+                scriptEng.checkResult = WriteSaveRAMData();
+                NEXT_OPCODE();
+            OPCODE(FUNC_LOADTEXTFONT):
+                opcodeSize = 0;
+                LoadFontFile(scriptText);
+                NEXT_OPCODE();
+            OPCODE(FUNC_LOADTEXTFILE): {
+                opcodeSize     = 0;
+                TextMenu *menu = &gameMenu[scriptEng.operands[0]];
+                LoadTextFile(menu, scriptText, scriptEng.operands[2] != 0);
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_DRAWTEXT): {
+                opcodeSize        = 0;
+                textMenuSurfaceNo = scriptInfo->spriteSheetID;
+                TextMenu *menu    = &gameMenu[scriptEng.operands[0]];
+                DrawBitmapText(menu, scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3], scriptEng.operands[4],
+                               scriptEng.operands[5], scriptEng.operands[6]);
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_GETTEXTINFO): {
+                TextMenu *menu = &gameMenu[scriptEng.operands[1]];
+                switch (scriptEng.operands[2]) {
+                    case TEXTINFO_TEXTDATA:
+                        scriptEng.operands[0] = menu->textData[menu->entryStart[scriptEng.operands[3]] + scriptEng.operands[4]];
                         break;
-                    case VAR_ENGINEPLATFORMID: break;
-                    case VAR_ENGINETRIALMODE: break;
-                    case VAR_KEYPRESSANYSTART: break;
+                    case TEXTINFO_TEXTSIZE: scriptEng.operands[0] = menu->entrySize[scriptEng.operands[3]]; break;
+                    case TEXTINFO_ROWCOUNT: scriptEng.operands[0] = menu->rowCount; break;
+                }
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_GETVERSIONNUMBER): {
+                opcodeSize                           = 0;
+                TextMenu *menu                       = &gameMenu[scriptEng.operands[0]];
+                menu->entryHighlight[menu->rowCount] = scriptEng.operands[1];
+                AddTextMenuEntry(menu, Engine.gameVersion);
+                NEXT_OPCODE();
+            }
+            OPCODE(FUNC_SETACHIEVEMENT):
+                opcodeSize = 0;
+                SetAchievement(scriptEng.operands[0], scriptEng.operands[1]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_SETLEADERBOARD):
+                opcodeSize = 0;
+                SetLeaderboard(scriptEng.operands[0], scriptEng.operands[1]);
+                NEXT_OPCODE();
+            OPCODE(FUNC_LOADONLINEMENU):
+                opcodeSize = 0;
+                switch (scriptEng.operands[0]) {
+                    default: break;
+                    case ONLINEMENU_ACHIEVEMENTS: LoadAchievementsMenu(); break;
+                    case ONLINEMENU_LEADERBOARDS: LoadLeaderboardsMenu(); break;
+                }
+                NEXT_OPCODE();
+            OPCODE(FUNC_ENGINECALLBACK):
+                opcodeSize = 0;
+                Engine.Callback(scriptEng.operands[0]);
+                NEXT_OPCODE();
 #if RETRO_USE_HAPTICS
-                    case VAR_ENGINEHAPTICSENABLED: Engine.hapticsEnabled = scriptEng.operands[i]; break;
+            OPCODE(FUNC_HAPTICEFFECT):
+                opcodeSize = 0;
+                // params: scriptEng.operands[0], scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]
+                if (scriptEng.operands[0] != -1)
+                    QueueHapticEffect(scriptEng.operands[0]);
+                else
+                    PlayHaptics(scriptEng.operands[1], scriptEng.operands[2], scriptEng.operands[3]);
+                NEXT_OPCODE();
+#endif
+        }
+
+        SetScriptOperands(operands, opcodeSize);
+    } while (running);
+
+#if RETRO_USE_THREADED_SCRIPT
+scriptEnd:
 #endif
+    return scriptCodePtr;
+}
+
+#undef FETCH_OPCODE
+#undef OPCODE
+#undef OPCODE_DEFAULT
+#undef NEXT_OPCODE
+
+void ProcessScript(int scriptCodeStart, int jumpTableStart, byte scriptSub)
+{
+    jumpTableStackPos = 0;
+    functionStackPos  = 0;
+    RunScriptCode(scriptCodeStart, scriptCodeStart, jumpTableStart, scriptSub, false);
+}
+
+// Ahead-of-time compiled object subs
+// ExportNativeScripts writes each object sub of the loaded stage out as a C++ function (NativeScripts.hpp), plus a table of them
+// (NativeScriptList.hpp). Building with RETRO_USE_NATIVE_SCRIPTS compiles those in & LinkNativeScripts matches them up with the
+// loaded objects by type name and a hash of the sub's bytecode, anything that isn't matched runs through ProcessScript as usual
+#define NATIVESCRIPT_OPCOUNT   (0x4000)
+#define NATIVESCRIPT_JUMPCOUNT (0x1000)
+#define NATIVESCRIPT_CASECOUNT (0x400)
+#define NATIVESCRIPT_COUNT     (0x800)
+
+struct NativeScriptInfo {
+    char typeName[0x40];
+    byte sub;
+    uint hash;
+};
+
+const char nativeScriptSubNames[SCRIPTSUB_COUNT][0x20] = { "Main", "PlayerInteraction", "Draw", "Startup" };
+
+int nativeOpList[NATIVESCRIPT_OPCOUNT];     // code pos of every instruction in the sub, relative to its start
+int nativeJumpList[NATIVESCRIPT_JUMPCOUNT]; // jump table entries the sub's control flow resolved to
+int nativeOpCount   = 0;
+int nativeJumpCount = 0;
+
+bool exportNativeScripts = false;
+NativeScriptInfo nativeScriptExports[NATIVESCRIPT_COUNT];
+int nativeScriptExportCount = 0;
+
+inline void HashNativeScriptValue(uint *hash, int value)
+{
+    // FNV-1a
+    for (int b = 0; b < 4; ++b) {
+        *hash ^= (value >> (b << 3)) & 0xFF;
+        *hash *= 0x01000193;
+    }
+}
+
+bool AddNativeScriptJumps(int jumpTableStart, int jumpID, int count, uint *hash)
+{
+    for (int j = jumpTableStart + jumpID; j < jumpTableStart + jumpID + count; ++j) {
+        if (j < 0 || j >= JUMPTABLE_COUNT || nativeJumpCount >= NATIVESCRIPT_JUMPCOUNT)
+            return false;
+        HashNativeScriptValue(hash, jumpTable[j]);
+        nativeJumpList[nativeJumpCount++] = jumpTable[j];
+    }
+    return true;
+}
+
+// Walks an object sub up to its FUNC_END, filling nativeOpList & nativeJumpList
+// The hash covers the sub's bytecode & the jump table entries it reads, so compiled code only gets linked to the exact script it came from
+bool ReadNativeScriptSub(int scriptCodeStart, int jumpTableStart, uint *hash)
+{
+    *hash           = 0x811C9DC5;
+    nativeOpCount   = 0;
+    nativeJumpCount = 0;
+
+    int scriptCodePtr = scriptCodeStart;
+    while (true) {
+        // the writer reads the instructions back out of scriptCodeDecoded, so only code it covers can be exported
+        if (scriptCodePtr < 0 || scriptCodePtr >= scriptCodeDecodedSize || nativeOpCount >= NATIVESCRIPT_OPCOUNT)
+            return false;
+
+        ScriptOperand *instruction = GetScriptInstruction(scriptCodePtr, NULL);
+        nativeOpList[nativeOpCount++] = scriptCodePtr - scriptCodeStart;
+        for (int c = scriptCodePtr; c < instruction->value && c < SCRIPTDATA_COUNT; ++c) HashNativeScriptValue(hash, scriptCode[c]);
+
+        ScriptOperand *operands = &instruction[1];
+        bool constJump          = instruction->type > 0 && operands[0].type == SCRIPTVAR_INTCONST;
+        switch (instruction->variable) {
+            default: break;
+            case FUNC_IFEQUAL:
+            case FUNC_IFGREATER:
+            case FUNC_IFGREATEROREQUAL:
+            case FUNC_IFLOWER:
+            case FUNC_IFLOWEROREQUAL:
+            case FUNC_IFNOTEQUAL:
+            case FUNC_WEQUAL:
+            case FUNC_WGREATER:
+            case FUNC_WGREATEROREQUAL:
+            case FUNC_WLOWER:
+            case FUNC_WLOWEROREQUAL:
+            case FUNC_WNOTEQUAL:
+                if (constJump && !AddNativeScriptJumps(jumpTableStart, operands[0].value, 2, hash))
+                    return false;
+                break;
+            case FUNC_SWITCH:
+                if (constJump) {
+                    if (!AddNativeScriptJumps(jumpTableStart, operands[0].value, 4, hash))
+                        return false;
+                    // the case list starts after the lowest case, highest case, default & end entries
+                    int caseCount = nativeJumpList[nativeJumpCount - 3] - nativeJumpList[nativeJumpCount - 4] + 1;
+                    if (caseCount > NATIVESCRIPT_CASECOUNT)
+                        return false;
+                    if (caseCount > 0 && !AddNativeScriptJumps(jumpTableStart, operands[0].value + 4, caseCount, hash))
+                        return false;
                 }
+                break;
+            case FUNC_ENDFUNCTION: return false;
+        }
+
+        if (instruction->variable == FUNC_END)
+            return true;
+        scriptCodePtr = instruction->value;
+    }
+}
+
+// Label positions are instructions that a jump can land on
+bool IsNativeScriptLabel(int pos)
+{
+    int start = 0;
+    int end   = nativeOpCount - 1;
+    while (start <= end) {
+        int mid = (start + end) >> 1;
+        if (nativeOpList[mid] == pos) {
+            for (int j = 0; j < nativeJumpCount; ++j) {
+                if (nativeJumpList[j] == pos)
+                    return true;
+            }
+            return false;
+        }
+        if (nativeOpList[mid] < pos)
+            start = mid + 1;
+        else
+            end = mid - 1;
+    }
+    return false;
+}
+
+bool GetNativeScriptOperand(ScriptOperand *operand, char *dest)
+{
+    if (operand->type == SCRIPTVAR_INTCONST) {
+        sprintf(dest, "%d", operand->value);
+        return true;
+    }
+    if (operand->type != SCRIPTVAR_VAR)
+        return false;
+
+    char arrayVal[0x40];
+    switch (operand->arrayType) {
+        default: StrCopy(arrayVal, "0"); break;
+        case OPERANDARR_OBJECTLOOP: StrCopy(arrayVal, "objectLoop"); break;
+        case OPERANDARR_CONST: sprintf(arrayVal, "%d", operand->value); break;
+        case OPERANDARR_ARRAYPOS: sprintf(arrayVal, "scriptEng.arrayPosition[%d]", operand->value); break;
+        case OPERANDARR_ENTNOPLUSCONST: sprintf(arrayVal, "%d + objectLoop", operand->value); break;
+        case OPERANDARR_ENTNOPLUSARRAYPOS: sprintf(arrayVal, "scriptEng.arrayPosition[%d] + objectLoop", operand->value); break;
+        case OPERANDARR_ENTNOMINUSCONST: sprintf(arrayVal, "objectLoop - (%d)", operand->value); break;
+        case OPERANDARR_ENTNOMINUSARRAYPOS: sprintf(arrayVal, "objectLoop - scriptEng.arrayPosition[%d]", operand->value); break;
+    }
+
+    // only variables that are plain loads & stores in ProcessScript, everything else is left to the interpreter
+    switch (operand->variable) {
+        default: return false;
+        case VAR_TEMPVALUE0:
+        case VAR_TEMPVALUE1:
+        case VAR_TEMPVALUE2:
+        case VAR_TEMPVALUE3:
+        case VAR_TEMPVALUE4:
+        case VAR_TEMPVALUE5:
+        case VAR_TEMPVALUE6:
+        case VAR_TEMPVALUE7: sprintf(dest, "scriptEng.tempValue[%d]", operand->variable - VAR_TEMPVALUE0); break;
+        case VAR_CHECKRESULT: StrCopy(dest, "scriptEng.checkResult"); break;
+        case VAR_ARRAYPOS0:
+        case VAR_ARRAYPOS1: sprintf(dest, "scriptEng.arrayPosition[%d]", operand->variable - VAR_ARRAYPOS0); break;
+        case VAR_GLOBAL: sprintf(dest, "globalVariables[%s]", arrayVal); break;
+        case VAR_OBJECTXPOS: sprintf(dest, "objectEntityList[%s].XPos", arrayVal); break;
+        case VAR_OBJECTYPOS: sprintf(dest, "objectEntityList[%s].YPos", arrayVal); break;
+        case VAR_OBJECTVALUE0:
+        case VAR_OBJECTVALUE1:
+        case VAR_OBJECTVALUE2:
+        case VAR_OBJECTVALUE3:
+        case VAR_OBJECTVALUE4:
+        case VAR_OBJECTVALUE5:
+        case VAR_OBJECTVALUE6:
+        case VAR_OBJECTVALUE7: sprintf(dest, "objectEntityList[%s].values[%d]", arrayVal, operand->variable - VAR_OBJECTVALUE0); break;
+    }
+    return true;
+}
+
+void WriteNativeScript(FileIO *file, const char *text, ...)
+{
+    char buffer[0x400];
+    va_list args;
+    va_start(args, text);
+    vsprintf(buffer, text, args);
+    va_end(args);
+    fWrite(buffer, 1, StrLength(buffer), file);
+}
+
+void WriteNativeScriptJump(FileIO *file, int pos)
+{
+    if (IsNativeScriptLabel(pos))
+        WriteNativeScript(file, "goto L_%d;\n", pos);
+    else
+        WriteNativeScript(file, "{ scriptCodePtr = scriptCodeStart + %d; goto dispatch; }\n", pos);
+}
+
+void WriteNativeScriptOp(FileIO *file, int scriptCodeStart, int jumpTableStart, int pos)
+{
+    ScriptOperand *instruction = &scriptCodeDecoded[scriptCodeStart + pos];
+    ScriptOperand *operands    = &instruction[1];
+    int opcode                 = instruction->variable;
+    int opcodeSize             = instruction->type;
+
+    if (IsNativeScriptLabel(pos))
+        WriteNativeScript(file, "L_%d:\n", pos);
+    if (opcode >= FUNC_MAX_CNT) {
+        WriteNativeScript(file, "    // invalid opcode\n");
+        return;
+    }
+    WriteNativeScript(file, "    // %s\n", functions[opcode].name);
+
+    switch (opcode) {
+        default: break;
+        case FUNC_END: WriteNativeScript(file, "    return;\n"); return;
+        case FUNC_ELSE:
+            WriteNativeScript(file, "    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + jumpTableStack[jumpTableStackPos--] + 1];\n");
+            WriteNativeScript(file, "    goto dispatch;\n");
+            return;
+        case FUNC_ENDIF:
+        case FUNC_ENDSWITCH: WriteNativeScript(file, "    --jumpTableStackPos;\n"); return;
+        case FUNC_LOOP:
+            WriteNativeScript(file, "    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + jumpTableStack[jumpTableStackPos--]];\n");
+            WriteNativeScript(file, "    goto dispatch;\n");
+            return;
+        case FUNC_BREAK:
+            WriteNativeScript(file, "    scriptCodePtr = scriptCodeStart + jumpTable[jumpTableStart + jumpTableStack[jumpTableStackPos--] + 3];\n");
+            WriteNativeScript(file, "    goto dispatch;\n");
+            return;
+    }
+
+    char operandText[10][0x80];
+    bool nativeOperands = true;
+    for (int i = 0; i < opcodeSize; ++i) nativeOperands = GetNativeScriptOperand(&operands[i], operandText[i]) && nativeOperands;
+    bool constJump = nativeOperands && opcodeSize > 0 && operands[0].type == SCRIPTVAR_INTCONST;
+
+    const char *body   = NULL; // opcodes that write their operands back
+    const char *check  = NULL; // opcodes that only read their operands
+    const char *branch = NULL; // condition for skipping an if/while
+    bool loop          = false;
+    switch (opcode) {
+        default: break;
+        case FUNC_EQUAL: body = "scriptEng.operands[0] = scriptEng.operands[1];"; break;
+        case FUNC_ADD: body = "scriptEng.operands[0] += scriptEng.operands[1];"; break;
+        case FUNC_SUB: body = "scriptEng.operands[0] -= scriptEng.operands[1];"; break;
+        case FUNC_INC: body = "++scriptEng.operands[0];"; break;
+        case FUNC_DEC: body = "--scriptEng.operands[0];"; break;
+        case FUNC_MUL: body = "scriptEng.operands[0] *= scriptEng.operands[1];"; break;
+        case FUNC_DIV: body = "scriptEng.operands[0] /= scriptEng.operands[1];"; break;
+        case FUNC_SHR: body = "scriptEng.operands[0] >>= scriptEng.operands[1];"; break;
+        case FUNC_SHL: body = "scriptEng.operands[0] <<= scriptEng.operands[1];"; break;
+        case FUNC_AND: body = "scriptEng.operands[0] &= scriptEng.operands[1];"; break;
+        case FUNC_OR: body = "scriptEng.operands[0] |= scriptEng.operands[1];"; break;
+        case FUNC_XOR: body = "scriptEng.operands[0] ^= scriptEng.operands[1];"; break;
+        case FUNC_MOD: body = "scriptEng.operands[0] %= scriptEng.operands[1];"; break;
+        case FUNC_FLIPSIGN: body = "scriptEng.operands[0] = -scriptEng.operands[0];"; break;
+        case FUNC_NOT: body = "scriptEng.operands[0] = ~scriptEng.operands[0];"; break;
+        case FUNC_CHECKEQUAL: check = "scriptEng.checkResult = scriptEng.operands[0] == scriptEng.operands[1];"; break;
+        case FUNC_CHECKGREATER: check = "scriptEng.checkResult = scriptEng.operands[0] > scriptEng.operands[1];"; break;
+        case FUNC_CHECKLOWER: check = "scriptEng.checkResult = scriptEng.operands[0] < scriptEng.operands[1];"; break;
+        case FUNC_CHECKNOTEQUAL: check = "scriptEng.checkResult = scriptEng.operands[0] != scriptEng.operands[1];"; break;
+        case FUNC_WEQUAL: loop = true;
+        case FUNC_IFEQUAL: branch = "scriptEng.operands[1] != scriptEng.operands[2]"; break;
+        case FUNC_WGREATER: loop = true;
+        case FUNC_IFGREATER: branch = "scriptEng.operands[1] <= scriptEng.operands[2]"; break;
+        case FUNC_WGREATEROREQUAL: loop = true;
+        case FUNC_IFGREATEROREQUAL: branch = "scriptEng.operands[1] < scriptEng.operands[2]"; break;
+        case FUNC_WLOWER: loop = true;
+        case FUNC_IFLOWER: branch = "scriptEng.operands[1] >= scriptEng.operands[2]"; break;
+        case FUNC_WLOWEROREQUAL: loop = true;
+        case FUNC_IFLOWEROREQUAL: branch = "scriptEng.operands[1] > scriptEng.operands[2]"; break;
+        case FUNC_WNOTEQUAL: loop = true;
+        case FUNC_IFNOTEQUAL: branch = "scriptEng.operands[1] == scriptEng.operands[2]"; break;
+        case FUNC_SWITCH:
+        case FUNC_CALLFUNCTION: break;
+    }
+
+    bool native = nativeOperands && (body || check || (branch && constJump) || (opcode == FUNC_SWITCH && constJump) || opcode == FUNC_CALLFUNCTION);
+    if (!native) {
+        // let the interpreter run this one, control flow picks up from wherever it left off
+        if (branch || opcode == FUNC_SWITCH) {
+            WriteNativeScript(file, "    scriptCodePtr = RunScriptCode(scriptCodeStart + %d, scriptCodeStart, jumpTableStart, scriptSub, true);\n", pos);
+            WriteNativeScript(file, "    goto dispatch;\n");
+        }
+        else {
+            WriteNativeScript(file, "    RunScriptCode(scriptCodeStart + %d, scriptCodeStart, jumpTableStart, scriptSub, true);\n", pos);
+        }
+        return;
+    }
+
+    for (int i = 0; i < opcodeSize; ++i) WriteNativeScript(file, "    scriptEng.operands[%d] = %s;\n", i, operandText[i]);
+
+    if (body) {
+        WriteNativeScript(file, "    %s\n", body);
+        for (int i = 0; i < opcodeSize; ++i) {
+            if (operands[i].type == SCRIPTVAR_VAR)
+                WriteNativeScript(file, "    %s = scriptEng.operands[%d];\n", operandText[i], i);
+        }
+    }
+    else if (check) {
+        WriteNativeScript(file, "    %s\n", check);
+    }
+    else if (branch) {
+        int jumpID = jumpTableStart + operands[0].value;
+        if (loop) {
+            WriteNativeScript(file, "    if (%s)\n        ", branch);
+            WriteNativeScriptJump(file, jumpTable[jumpID + 1]);
+            WriteNativeScript(file, "    else\n        jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];\n");
+        }
+        else {
+            WriteNativeScript(file, "    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];\n");
+            WriteNativeScript(file, "    if (%s)\n        ", branch);
+            WriteNativeScriptJump(file, jumpTable[jumpID]);
+        }
+    }
+    else if (opcode == FUNC_SWITCH) {
+        int jumpID = jumpTableStart + operands[0].value;
+        WriteNativeScript(file, "    jumpTableStack[++jumpTableStackPos] = scriptEng.operands[0];\n");
+        WriteNativeScript(file, "    switch (scriptEng.operands[1]) {\n");
+        WriteNativeScript(file, "        default: ");
+        WriteNativeScriptJump(file, jumpTable[jumpID + 2]);
+        for (int c = jumpTable[jumpID]; c <= jumpTable[jumpID + 1]; ++c) {
+            WriteNativeScript(file, "        case %d: ", c);
+            WriteNativeScriptJump(file, jumpTable[jumpID + 4 + (c - jumpTable[jumpID])]);
+        }
+        WriteNativeScript(file, "    }\n");
+    }
+    else if (opcode == FUNC_CALLFUNCTION) {
+        WriteNativeScript(file, "    if (!CallNativeScriptFunction(scriptEng.operands[0], scriptCodeStart, jumpTableStart, scriptSub))\n");
+        WriteNativeScript(file, "        return;\n");
+    }
+}
+
+bool WriteNativeScriptSub(FileIO *file, int objectID, int sub, ScriptPtr *subPtr)
+{
+    // function calls need their ID up front, the interpreter can't run just the call for us
+    for (int o = 0; o < nativeOpCount; ++o) {
+        ScriptOperand *instruction = &scriptCodeDecoded[subPtr->scriptCodePtr + nativeOpList[o]];
+        char operandText[0x80];
+        if (instruction->variable == FUNC_CALLFUNCTION && !GetNativeScriptOperand(&instruction[1], operandText))
+            return false;
+    }
+
+    WriteNativeScript(file, "// %s - %s\n", typeNames[objectID], nativeScriptSubNames[sub]);
+    WriteNativeScript(file, "void NativeScript%d(int scriptCodeStart, int jumpTableStart, byte scriptSub)\n{\n", nativeScriptExportCount);
+    WriteNativeScript(file, "    int scriptCodePtr = scriptCodeStart;\n");
+    WriteNativeScript(file, "    jumpTableStackPos = 0;\n");
+    WriteNativeScript(file, "    functionStackPos  = 0;\n\n");
+    for (int o = 0; o < nativeOpCount; ++o) WriteNativeScriptOp(file, subPtr->scriptCodePtr, subPtr->jumpTablePtr, nativeOpList[o]);
+
+    // dynamic jumps land here, anything that isn't part of this sub is left to the interpreter
+    WriteNativeScript(file, "\ndispatch:\n");
+    WriteNativeScript(file, "    switch (scriptCodePtr - scriptCodeStart) {\n");
+    WriteNativeScript(file, "        default: RunScriptCode(scriptCodePtr, scriptCodeStart, jumpTableStart, scriptSub, false); return;\n");
+    for (int j = 0; j < nativeJumpCount; ++j) {
+        bool listed = false;
+        for (int p = 0; p < j && !listed; ++p) listed = nativeJumpList[p] == nativeJumpList[j];
+        if (!listed && IsNativeScriptLabel(nativeJumpList[j]))
+            WriteNativeScript(file, "        case %d: goto L_%d;\n", nativeJumpList[j], nativeJumpList[j]);
+    }
+    WriteNativeScript(file, "    }\n}\n\n");
+    return true;
+}
+
+void ExportNativeScripts()
+{
+    char pathBuffer[0x100];
+    sprintf(pathBuffer, BASE_PATH "NativeScripts.hpp");
+    // a fresh export every session, subs already exported this session are skipped
+    FileIO *file = fOpen(pathBuffer, nativeScriptExportCount ? "a" : "w");
+    if (!file)
+        return;
+
+    int exportStart = nativeScriptExportCount;
+    for (int o = 0; o < OBJECT_COUNT; ++o) {
+        ObjectScript *scriptInfo         = &objectScriptList[o];
+        ScriptPtr *subs[SCRIPTSUB_COUNT] = { &scriptInfo->subMain, &scriptInfo->subPlayerInteraction, &scriptInfo->subDraw,
+                                             &scriptInfo->subStartup };
+        for (int s = 0; s < SCRIPTSUB_COUNT && nativeScriptExportCount < NATIVESCRIPT_COUNT; ++s) {
+            uint hash = 0;
+            if (scriptCode[subs[s]->scriptCodePtr] <= 0 || !ReadNativeScriptSub(subs[s]->scriptCodePtr, subs[s]->jumpTablePtr, &hash))
+                continue;
+
+            bool exported = false;
+            for (int e = 0; e < nativeScriptExportCount && !exported; ++e) {
+                NativeScriptInfo *info = &nativeScriptExports[e];
+                exported               = info->sub == s && info->hash == hash && StrComp(info->typeName, typeNames[o]);
             }
-            else if (opcodeType == SCRIPTVAR_INTCONST) { // int constant
-                scriptCodePtr++;
+
+            if (!exported && WriteNativeScriptSub(file, o, s, subs[s])) {
+                NativeScriptInfo *info = &nativeScriptExports[nativeScriptExportCount++];
+                StrCopy(info->typeName, typeNames[o]);
+                info->sub  = s;
+                info->hash = hash;
             }
-            else if (opcodeType == SCRIPTVAR_STRCONST) { // string constant
-                int strLen = scriptCode[scriptCodePtr++];
-                for (int c = 0; c < strLen; ++c) {
-                    switch (c % 4) {
-                        case 0: break;
-                        case 1: break;
-                        case 2: break;
-                        case 3: ++scriptCodePtr; break;
-                        default: break;
-                    }
+        }
+    }
+    fClose(file);
+
+    // the list has to come after every function, so it gets rewritten each time
+    sprintf(pathBuffer, BASE_PATH "NativeScriptList.hpp");
+    file = fOpen(pathBuffer, "w");
+    if (!file)
+        return;
+    for (int e = 0; e < nativeScriptExportCount; ++e) {
+        NativeScriptInfo *info = &nativeScriptExports[e];
+        WriteNativeScript(file, "    { \"%s\", %d, 0x%08X, NativeScript%d },\n", info->typeName, info->sub, info->hash, e);
+    }
+    fClose(file);
+
+    PrintLog("Exported %d native script subs (%d total)", nativeScriptExportCount - exportStart, nativeScriptExportCount);
+}
+
+#if RETRO_USE_NATIVE_SCRIPTS
+// Runs a script function for compiled code, returning to a FUNC_END (the empty slot at the end of scriptCode) so it stops once the
+// function is done. Returns false if the function ended the whole sub instead
+bool CallNativeScriptFunction(int functionID, int scriptCodeStart, int jumpTableStart, byte scriptSub)
+{
+    int stackPos                      = functionStackPos;
+    functionStack[functionStackPos++] = SCRIPTDATA_COUNT - 1;
+    functionStack[functionStackPos++] = jumpTableStart;
+    functionStack[functionStackPos++] = scriptCodeStart;
+    ScriptPtr *ptr                    = &scriptFunctionList[functionID].ptr;
+    RunScriptCode(ptr->scriptCodePtr, ptr->scriptCodePtr, ptr->jumpTablePtr, scriptSub, false);
+    return functionStackPos == stackPos;
+}
+
+#include "NativeScripts.hpp"
+
+struct NativeScriptLink {
+    const char *typeName;
+    byte sub;
+    uint hash;
+    NativeScriptSub function;
+};
+
+const NativeScriptLink nativeScriptList[] = {
+#include "NativeScriptList.hpp"
+    { "", 0, 0, NULL },
+};
+
+NativeScriptSub objectNativeScripts[OBJECT_COUNT][SCRIPTSUB_COUNT];
+
+void LinkNativeScripts()
+{
+    int linkCount = 0;
+    for (int o = 0; o < OBJECT_COUNT; ++o) {
+        ObjectScript *scriptInfo         = &objectScriptList[o];
+        ScriptPtr *subs[SCRIPTSUB_COUNT] = { &scriptInfo->subMain, &scriptInfo->subPlayerInteraction, &scriptInfo->subDraw,
+                                             &scriptInfo->subStartup };
+        for (int s = 0; s < SCRIPTSUB_COUNT; ++s) {
+            objectNativeScripts[o][s] = NULL;
+
+            uint hash = 0;
+            if (scriptCode[subs[s]->scriptCodePtr] <= 0 || !ReadNativeScriptSub(subs[s]->scriptCodePtr, subs[s]->jumpTablePtr, &hash))
+                continue;
+
+            for (int n = 0; nativeScriptList[n].function; ++n) {
+                const NativeScriptLink *link = &nativeScriptList[n];
+                if (link->sub == s && link->hash == hash && StrComp(link->typeName, typeNames[o])) {
+                    objectNativeScripts[o][s] = link->function;
+                    ++linkCount;
+                    break;
                 }
-                scriptCodePtr++;
             }
         }
     }
+    PrintLog("Linked %d native script subs", linkCount);
+}
+#endif
+
+#if RETRO_USE_SCRIPT_PROFILER
+ScriptProfile scriptProfiles[SCRIPTPROFILE_COUNT];
+int scriptProfileCount             = 0;
+int scriptProfileFrames            = 0;
+uint scriptProfileOpcodes          = 0;
+long long scriptProfileFacesDrawn  = 0;
+long long scriptProfileFacesCulled = 0;
+
+// first of the 4 sub entries for each loaded object type, matched by name so timings carry over between stages
+int scriptProfileIDs[OBJECT_COUNT];
+
+const char scriptProfileSubNames[SCRIPTSUB_COUNT][0x20] = { "Main", "PlayerInteraction", "Draw", "Startup" };
+
+long long GetScriptProfileTime()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void LinkScriptProfiles()
+{
+    for (int o = 0; o < OBJECT_COUNT; ++o) {
+        scriptProfileIDs[o] = -1;
+        for (int p = 0; p < scriptProfileCount; p += SCRIPTSUB_COUNT) {
+            if (StrComp(scriptProfiles[p].typeName, typeNames[o])) {
+                scriptProfileIDs[o] = p;
+                break;
+            }
+        }
+
+        if (scriptProfileIDs[o] < 0 && scriptProfileCount + SCRIPTSUB_COUNT <= SCRIPTPROFILE_COUNT) {
+            scriptProfileIDs[o] = scriptProfileCount;
+            for (int s = 0; s < SCRIPTSUB_COUNT; ++s) {
+                ScriptProfile *profile = &scriptProfiles[scriptProfileCount++];
+                MEM_ZERO(*profile);
+                StrCopy(profile->typeName, typeNames[o]);
+                profile->sub = s;
+            }
+        }
+    }
+}
+
+void AddScriptProfile(int objectType, byte scriptSub, uint opcodeCount, long long time)
+{
+    if (scriptProfileIDs[objectType] < 0)
+        return;
+
+    ScriptProfile *profile = &scriptProfiles[scriptProfileIDs[objectType] + scriptSub];
+    profile->callCount++;
+    profile->opcodeCount += opcodeCount;
+    profile->time += time;
+    profile->frameTime += time;
+}
+
+void NextScriptProfileFrame()
+{
+    for (int p = 0; p < scriptProfileCount; ++p) {
+        ScriptProfile *profile = &scriptProfiles[p];
+        if (profile->frameTime > profile->peakFrameTime)
+            profile->peakFrameTime = profile->frameTime;
+        profile->frameTime = 0;
+    }
+    ++scriptProfileFrames;
+}
+
+void ResetScriptProfiler()
+{
+    for (int p = 0; p < scriptProfileCount; ++p) {
+        ScriptProfile *profile = &scriptProfiles[p];
+        profile->callCount     = 0;
+        profile->opcodeCount   = 0;
+        profile->time          = 0;
+        profile->frameTime     = 0;
+        profile->peakFrameTime = 0;
+    }
+    scriptProfileFrames      = 0;
+    scriptProfileFacesDrawn  = 0;
+    scriptProfileFacesCulled = 0;
+}
+
+// Fills list with the IDs of every profile that was called, most time spent first
+int SortScriptProfiles(int *list)
+{
+    int count = 0;
+    for (int p = 0; p < scriptProfileCount; ++p) {
+        if (!scriptProfiles[p].callCount)
+            continue;
+
+        int pos = count++;
+        while (pos > 0 && scriptProfiles[list[pos - 1]].time < scriptProfiles[p].time) {
+            list[pos] = list[pos - 1];
+            --pos;
+        }
+        list[pos] = p;
+    }
+    return count;
+}
+
+void WriteScriptProfile()
+{
+    char pathBuffer[0x100];
+    sprintf(pathBuffer, BASE_PATH "ScriptProfile.txt");
+    FileIO *file = fOpen(pathBuffer, "w");
+    if (!file)
+        return;
+
+    int list[SCRIPTPROFILE_COUNT];
+    int count  = SortScriptProfiles(list);
+    int frames = scriptProfileFrames > 0 ? scriptProfileFrames : 1;
+
+    char buffer[0x200];
+    sprintf(buffer, "Script profile over %d frames, sorted by total time\n", scriptProfileFrames);
+    fWrite(buffer, 1, StrLength(buffer), file);
+    sprintf(buffer, "3D faces: %lld drawn, %lld culled (%.1f / %.1f per frame)\n\n", scriptProfileFacesDrawn, scriptProfileFacesCulled,
+            scriptProfileFacesDrawn / (float)frames, scriptProfileFacesCulled / (float)frames);
+    fWrite(buffer, 1, StrLength(buffer), file);
+    sprintf(buffer, "%-32s %-18s %10s %11s %12s %9s %11s %12s %13s\n", "Object", "Sub", "Calls", "Calls/Frame", "Opcodes", "Ops/Call",
+            "Total ms", "Avg us/Frame", "Peak us/Frame");
+    fWrite(buffer, 1, StrLength(buffer), file);
+
+    for (int i = 0; i < count; ++i) {
+        ScriptProfile *profile = &scriptProfiles[list[i]];
+        sprintf(buffer, "%-32s %-18s %10d %11.2f %12lld %9.1f %11.3f %12.2f %13.2f\n", profile->typeName, scriptProfileSubNames[profile->sub],
+                profile->callCount, profile->callCount / (float)frames, profile->opcodeCount, profile->opcodeCount / (float)profile->callCount,
+                profile->time / 1000000.0, profile->time / 1000.0 / frames, profile->peakFrameTime / 1000.0);
+        fWrite(buffer, 1, StrLength(buffer), file);
+    }
+    fClose(file);
 }
+#endif
@@ -10,6 +10,28 @@
 
 #define RETRO_USE_COMPILER (1)
 
+// Run object subs through the ahead-of-time compiled code in NativeScripts.hpp/NativeScriptList.hpp (written by ExportNativeScripts)
+#ifndef RETRO_USE_NATIVE_SCRIPTS
+#define RETRO_USE_NATIVE_SCRIPTS (0)
+#endif
+
+// Record call counts, opcode counts & timings for each object type's subs, viewable from the dev menu & written to ScriptProfile.txt
+#ifndef RETRO_USE_SCRIPT_PROFILER
+#define RETRO_USE_SCRIPT_PROFILER (0)
+#endif
+
+// Decode the loaded scripts once into a table sized to them, 0 decodes each instruction every time it runs (make replaycheck-decode)
+#ifndef RETRO_USE_DECODED_SCRIPTS
+#define RETRO_USE_DECODED_SCRIPTS (1)
+#endif
+
+// Each opcode handler fetches the next instruction & jumps straight to its handler through a table of label addresses,
+// instead of going back around the loop to the switch. Needs the GCC/Clang "labels as values" extension (make THREADED_SCRIPT=1)
+// Off by default, make replaycheck-threaded checks it runs every script exactly the same as the switch
+#ifndef RETRO_USE_THREADED_SCRIPT
+#define RETRO_USE_THREADED_SCRIPT (0)
+#endif
+
 struct ScriptPtr {
     int scriptCodePtr;
     int jumpTablePtr;
@@ -34,6 +56,9 @@ struct ObjectScript {
 #if !RETRO_USE_ORIGINAL_CODE
     bool mobile; // flag for detecting mobile/updated bytecode
 #endif
+#if RETRO_USE_PALETTE_FADE
+    bool blocksPaletteFade; // subDraw can draw or change something the palette fade can't stand in for (see ScanPaletteFadeScripts)
+#endif
 };
 
 struct ScriptEngine {
@@ -44,6 +69,7 @@ struct ScriptEngine {
 };
 
 enum ScriptSubs { SUB_MAIN = 0, SUB_PLAYERINTERACTION = 1, SUB_DRAW = 2, SUB_SETUP = 3 };
+#define SCRIPTSUB_COUNT (4)
 
 extern ObjectScript objectScriptList[OBJECT_COUNT];
 
@@ -89,9 +115,72 @@ bool CheckOpcodeType(char *text); // Never actually used
 void ParseScriptFile(char *scriptName, int scriptID);
 #endif
 void LoadBytecode(int stageListID, int scriptID);
+void DecodeScriptCode();
+#if RETRO_USE_PALETTE_FADE
+void ScanPaletteFadeScripts();
+#endif
 
 void ProcessScript(int scriptCodeStart, int jumpTableStart, byte scriptSub);
 
+#if RETRO_USE_SCRIPT_PROFILER
+#define SCRIPTPROFILE_COUNT (0x800)
+
+struct ScriptProfile {
+    char typeName[0x40];
+    byte sub;
+    int callCount;
+    long long opcodeCount;
+    long long time;          // in nanoseconds
+    long long frameTime;     // time spent during the current frame
+    long long peakFrameTime; // most time spent during a single frame
+};
+
+extern ScriptProfile scriptProfiles[SCRIPTPROFILE_COUNT];
+extern int scriptProfileCount;
+extern int scriptProfileFrames;
+extern uint scriptProfileOpcodes;
+extern long long scriptProfileFacesDrawn; // 3D faces that made it through Cull3DDrawList
+extern long long scriptProfileFacesCulled;
+
+long long GetScriptProfileTime();
+void LinkScriptProfiles();
+void AddScriptProfile(int objectType, byte scriptSub, uint opcodeCount, long long time);
+void NextScriptProfileFrame();
+void ResetScriptProfiler();
+int SortScriptProfiles(int *list);
+void WriteScriptProfile();
+#endif
+
+extern bool exportNativeScripts;
+void ExportNativeScripts();
+
+#if RETRO_USE_NATIVE_SCRIPTS
+typedef void (*NativeScriptSub)(int scriptCodeStart, int jumpTableStart, byte scriptSub);
+extern NativeScriptSub objectNativeScripts[OBJECT_COUNT][SCRIPTSUB_COUNT];
+
+void LinkNativeScripts();
+#endif
+
+// Runs one of an object type's subs, using the compiled version if there is one
+inline void ProcessObjectScript(int objectType, ScriptPtr *sub, byte scriptSub)
+{
+#if RETRO_USE_SCRIPT_PROFILER
+    uint opcodeCount = scriptProfileOpcodes;
+    long long time   = GetScriptProfileTime();
+#endif
+
+#if RETRO_USE_NATIVE_SCRIPTS
+    if (objectNativeScripts[objectType][scriptSub])
+        objectNativeScripts[objectType][scriptSub](sub->scriptCodePtr, sub->jumpTablePtr, scriptSub);
+    else
+#endif
+        ProcessScript(sub->scriptCodePtr, sub->jumpTablePtr, scriptSub);
+
+#if RETRO_USE_SCRIPT_PROFILER
+    AddScriptProfile(objectType, scriptSub, scriptProfileOpcodes - opcodeCount, GetScriptProfileTime() - time);
+#endif
+}
+
 void ClearScriptData();
 
 #endif // !SCRIPT_H
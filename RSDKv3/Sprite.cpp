@@ -209,8 +209,96 @@ void ReadGifPictureData(int width, int height, bool interlaced, byte *gfxData, i
     for (int h = 0; h < height; ++h) ReadGifLine(gfxData, width, h * width + offset);
 }
 
+// Grows a span pool to fit count entries, doubling each time so loading sheet after sheet doesn't realloc for every one
+template <typename T> bool ReserveSpanPool(T **pool, int *size, int count, int max)
+{
+    if (count <= *size)
+        return true;
+    if (count > max)
+        return false;
+
+    int newSize = *size ? *size : 0x1000;
+    while (newSize < count) newSize <<= 1;
+    if (newSize > max)
+        newSize = max;
+    T *newPool = (T *)realloc(*pool, newSize * sizeof(T));
+    if (!newPool)
+        return false;
+    *pool = newPool;
+    *size = newSize;
+    return true;
+}
+
+void BuildSurfaceSpans(GFXSurface *surface)
+{
+    surface->spanRowPosition = -1;
+    if (renderType != RENDER_SW || surface->dataPosition + surface->width * surface->height > GFXDATA_SIZE)
+        return;
+
+    if (!ReserveSpanPool(&gfxSpanRows, &gfxSpanRowsSize, gfxSpanRowPosition + surface->height + 1, GFXSPANROW_MAX)) {
+        PrintLog("WARNING: Exceeded max gfx span rows!");
+        return;
+    }
+
+    int spanPos     = gfxSpanPosition;
+    int opaqueCount = 0;
+    byte *gfxData   = &graphicData[surface->dataPosition];
+    for (int y = 0; y < surface->height; ++y) {
+        gfxSpanRows[gfxSpanRowPosition + y] = spanPos;
+        int x = 0;
+        while (x < surface->width) {
+            while (x < surface->width && !gfxData[x]) ++x;
+            if (x == surface->width)
+                break;
+
+            if (!ReserveSpanPool(&gfxSpanList, &gfxSpanListSize, spanPos + 1, GFXSPAN_MAX)) {
+                PrintLog("WARNING: Exceeded max gfx spans!");
+                return;
+            }
+            gfxSpanList[spanPos].start = x;
+            while (x < surface->width && gfxData[x]) ++x;
+            gfxSpanList[spanPos].length = x - gfxSpanList[spanPos].start;
+            opaqueCount += gfxSpanList[spanPos++].length;
+        }
+        gfxData += surface->width;
+    }
+    gfxSpanRows[gfxSpanRowPosition + surface->height] = spanPos;
+
+    // dithered sheets made of very short runs draw faster through the per pixel path, so they don't keep their table
+    int spanCount = spanPos - gfxSpanPosition;
+    if (opaqueCount < spanCount * 4)
+        return;
+
+    surface->spanRowPosition = gfxSpanRowPosition;
+    gfxSpanRowPosition += surface->height + 1;
+    gfxSpanPosition = spanPos;
+    PrintLog("Built span table for %s: %d spans, %d bytes", surface->fileName, spanCount,
+             (int)(spanCount * sizeof(GFXSpan) + (surface->height + 1) * sizeof(int)));
+}
+void RemoveSurfaceSpans(int sheetID)
+{
+    GFXSurface *surface = &gfxSurface[sheetID];
+    if (surface->spanRowPosition < 0)
+        return;
+
+    int rowStart  = surface->spanRowPosition;
+    int rowCount  = surface->height + 1;
+    int spanStart = gfxSpanRows[rowStart];
+    int spanCount = gfxSpanRows[rowStart + surface->height] - spanStart;
+    for (int i = spanStart; i < gfxSpanPosition - spanCount; ++i) gfxSpanList[i] = gfxSpanList[i + spanCount];
+    for (int i = rowStart; i < gfxSpanRowPosition - rowCount; ++i) gfxSpanRows[i] = gfxSpanRows[i + rowCount] - spanCount;
+    gfxSpanPosition -= spanCount;
+    gfxSpanRowPosition -= rowCount;
+    for (int i = 0; i < SURFACE_COUNT; ++i) {
+        if (gfxSurface[i].spanRowPosition > rowStart)
+            gfxSurface[i].spanRowPosition -= rowCount;
+    }
+    surface->spanRowPosition = -1;
+}
+
 int AddGraphicsFile(const char *filePath)
 {
+    FlushDrawCommands(); // queued draws still point into graphicData
     char sheetPath[0x100];
 
     StrCopy(sheetPath, "Data/Sprites/");
@@ -240,6 +328,7 @@ int AddGraphicsFile(const char *filePath)
 }
 void RemoveGraphicsFile(const char *filePath, int sheetID)
 {
+    FlushDrawCommands();
     if (sheetID < 0) {
         for (int i = 0; i < SURFACE_COUNT; ++i) {
             if (StrLength(gfxSurface[i].fileName) > 0 && StrComp(gfxSurface[i].fileName, filePath))
@@ -249,6 +338,7 @@ void RemoveGraphicsFile(const char *filePath, int sheetID)
 
     if (sheetID >= 0 && StrLength(gfxSurface[sheetID].fileName)) {
         StrCopy(gfxSurface[sheetID].fileName, "");
+        RemoveSurfaceSpans(sheetID);
         int dataPosStart = gfxSurface[sheetID].dataPosition;
         int dataPosEnd   = gfxSurface[sheetID].dataPosition + gfxSurface[sheetID].height * gfxSurface[sheetID].width;
         for (int i = 0x200000 - dataPosEnd; i > 0; --i) graphicData[dataPosStart++] = graphicData[dataPosEnd++];
@@ -303,6 +393,7 @@ int LoadBMPFile(const char *filePath, byte sheetID)
             gfxData -= 2 * surface->width;
         }
         gfxDataPosition += surface->height * surface->width;
+        BuildSurfaceSpans(surface);
 
         if (renderType == RENDER_SW) {
             surface->widthShifted = 0;
@@ -390,9 +481,11 @@ int LoadGIFFile(const char *filePath, byte sheetID)
         gfxDataPosition += surface->width * surface->height;
         if (gfxDataPosition < GFXDATA_SIZE) {
             ReadGifPictureData(surface->width, surface->height, interlaced, graphicData, surface->dataPosition);
+            BuildSurfaceSpans(surface);
         }
         else {
-            gfxDataPosition = 0;
+            surface->spanRowPosition = -1;
+            gfxDataPosition          = 0;
             PrintLog("WARNING: Exceeded max gfx surface size!");
         }
 
@@ -442,6 +535,7 @@ int LoadGFXFile(const char *filePath, byte sheetID)
         }
 
         gfxDataPosition += surface->height * surface->width;
+        BuildSurfaceSpans(surface);
         if (renderType == RENDER_SW) {
             surface->widthShifted = 0;
             int w                 = surface->width;
@@ -492,7 +586,8 @@ int LoadRSVFile(const char *filePath, byte sheetID)
         videoPlaying          = 2; // playing rsv
         surface->width        = videoWidth;
         surface->height       = videoHeight;
-        surface->dataPosition = gfxDataPosition;
+        surface->dataPosition    = gfxDataPosition;
+        surface->spanRowPosition = -1;
         gfxDataPosition += surface->width * surface->height;
 
         if (gfxDataPosition >= GFXDATA_SIZE) {
@@ -526,7 +621,8 @@ int LoadPVRFile(const char *filePath, byte sheetID)
 
         surface->width        = width;
         surface->height       = height;
-        surface->dataPosition = gfxDataPosition;
+        surface->dataPosition    = gfxDataPosition;
+        surface->spanRowPosition = -1;
         gfxDataPosition += surface->width * surface->height;
 
         if (renderType == RENDER_SW) {
@@ -4,6 +4,9 @@
 int AddGraphicsFile(const char *filePath);
 void RemoveGraphicsFile(const char *filePath, int sheetID);
 
+void BuildSurfaceSpans(GFXSurface *surface);
+void RemoveSurfaceSpans(int sheetID);
+
 int LoadBMPFile(const char *filePath, byte sheetID);
 int LoadGIFFile(const char *filePath, byte sheetID);
 int LoadGFXFile(const char *filePath, byte sheetID);
@@ -343,6 +343,7 @@ void InitUserdata()
         ini.SetBool("Dev", "EngineDebugMode", engineDebugMode = false);
         ini.SetBool("Dev", "TxtScripts", forceUseScripts = false);
         forceUseScripts_Config = forceUseScripts;
+        ini.SetBool("Dev", "ExportNativeScripts", exportNativeScripts = false);
         ini.SetInteger("Dev", "StartingCategory", Engine.startList = 0);
         ini.SetInteger("Dev", "StartingScene", Engine.startStage = 0);
         ini.SetInteger("Dev", "FastForwardSpeed", Engine.fastForwardSpeed = 8);
@@ -350,6 +351,11 @@ void InitUserdata()
         ini.SetBool("Dev", "UseSteamDir", Engine.useSteamDir = false);
 #endif
         ini.SetBool("Dev", "UseHQModes", Engine.useHQModes = true);
+        ini.SetInteger("Dev", "RenderBands", Engine.renderBands = 1);
+        ini.SetBool("Dev", "DeferredDrawing", Engine.deferredDrawing = false);
+        ini.SetBool("Dev", "FlippedTileset", Engine.flippedTileset = true);
+        ini.SetBool("Dev", "PaletteFade", Engine.paletteFade = false);
+        ini.SetBool("Dev", "CullBackFaces", Engine.cullBackFaces = false);
         sprintf(Engine.dataFile, "%s", "Data.rsdk");
         ini.SetString("Dev", "DataFile", Engine.dataFile);
 
@@ -449,6 +455,8 @@ void InitUserdata()
         if (!ini.GetBool("Dev", "TxtScripts", &forceUseScripts))
             forceUseScripts = false;
         forceUseScripts_Config = forceUseScripts;
+        if (!ini.GetBool("Dev", "ExportNativeScripts", &exportNativeScripts))
+            exportNativeScripts = false;
         if (!ini.GetInteger("Dev", "StartingCategory", &Engine.startList))
             Engine.startList = 0;
         if (!ini.GetInteger("Dev", "StartingScene", &Engine.startStage))
@@ -461,6 +469,16 @@ void InitUserdata()
 #endif
         if (!ini.GetBool("Dev", "UseHQModes", &Engine.useHQModes))
             Engine.useHQModes = true;
+        if (!ini.GetInteger("Dev", "RenderBands", &Engine.renderBands))
+            Engine.renderBands = 1;
+        if (!ini.GetBool("Dev", "DeferredDrawing", &Engine.deferredDrawing))
+            Engine.deferredDrawing = false;
+        if (!ini.GetBool("Dev", "FlippedTileset", &Engine.flippedTileset))
+            Engine.flippedTileset = true;
+        if (!ini.GetBool("Dev", "PaletteFade", &Engine.paletteFade))
+            Engine.paletteFade = false;
+        if (!ini.GetBool("Dev", "CullBackFaces", &Engine.cullBackFaces))
+            Engine.cullBackFaces = false;
 
         Engine.startList_Game  = Engine.startList;
         Engine.startStage_Game = Engine.startStage;
@@ -759,6 +777,8 @@ void WriteSettings()
     ini.SetBool("Dev", "EngineDebugMode", engineDebugMode);
     ini.SetComment("Dev", "ScriptsComment", "Enable this flag to force the engine to load from the scripts folder instead of from bytecode");
     ini.SetBool("Dev", "TxtScripts", forceUseScripts_Config);
+    ini.SetComment("Dev", "NSComment", "Enable this flag to write every object script the engine loads out as C++, for building with native scripts");
+    ini.SetBool("Dev", "ExportNativeScripts", exportNativeScripts);
     ini.SetComment("Dev", "SCComment", "Sets the starting category ID");
     ini.SetInteger("Dev", "StartingCategory", Engine.startList);
     ini.SetComment("Dev", "SSComment", "Sets the starting scene ID");
@@ -774,6 +794,27 @@ void WriteSettings()
         "Determines if applicable rendering modes (such as 3D floor from special stages) will render in \"High Quality\" mode or standard mode");
     ini.SetBool("Dev", "UseHQModes", Engine.useHQModes);
 
+    ini.SetComment("Dev", "RenderBandsComment",
+                   "How many threads the software renderer splits stage drawing across (0 = one per CPU core, 1 = single threaded, the default)");
+    ini.SetInteger("Dev", "RenderBands", Engine.renderBands);
+
+    ini.SetComment("Dev", "DeferredDrawingComment",
+                   "Determines if stage drawing is queued up and rasterized on other threads while the game logic carries on, instead of as it's issued");
+    ini.SetBool("Dev", "DeferredDrawing", Engine.deferredDrawing);
+
+    ini.SetComment("Dev", "FlippedTilesetComment",
+                   "Determines if the software renderer keeps flipped copies of the stage tiles (faster layer drawing for 768KB more memory)");
+    ini.SetBool("Dev", "FlippedTileset", Engine.flippedTileset);
+
+    ini.SetComment("Dev", "PaletteFadeComment",
+                   "Determines if stage fades are applied to the palettes instead of every pixel (faster, frames with blended effects in them still "
+                   "fade every pixel so they come out the same)");
+    ini.SetBool("Dev", "PaletteFade", Engine.paletteFade);
+
+    ini.SetComment("Dev", "CullBackFacesComment",
+                   "Determines if 3D faces facing away from the camera are skipped (faster, but models drawn double sided lose their backs)");
+    ini.SetBool("Dev", "CullBackFaces", Engine.cullBackFaces);
+
     ini.SetComment("Dev", "DataFileComment", "Determines what RSDK file will be loaded");
     ini.SetString("Dev", "DataFile", Engine.dataFile);
 
@@ -48,7 +48,47 @@ int main(int argc, char *argv[])
             usingCWD = true;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    // -selfcheck <seed>: check the vector paths against their scalar reference and exit, nonzero if any case differs
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (StrComp(argv[i], "-selfcheck"))
+            return RunSelfCheck(atoi(argv[i + 1])) ? 1 : 0;
+    }
+#endif
+
     Engine.Init();
+#if !RETRO_USE_ORIGINAL_CODE
+    // -record <file> / -replay <file>: input replays, -hashes <file>: per frame state hash log, -frames <count>: exit after that many frames
+    // -benchmark <file>: time every stage and write the results as json, -benchframes <count>: frames to time per stage
+    // -renderbands <count>, -deferdraw <0/1>, -cullbackfaces <0/1>, -exportnative <0/1>: override RenderBands, DeferredDrawing,
+    // CullBackFaces & ExportNativeScripts from settings.ini
+    const char *benchmarkPath = nullptr;
+    int benchmarkFrames       = 600;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (StrComp(argv[i], "-record"))
+            StartInputRecording(argv[++i]);
+        else if (StrComp(argv[i], "-replay"))
+            StartInputReplay(argv[++i]);
+        else if (StrComp(argv[i], "-hashes"))
+            OpenStateHashLog(argv[++i]);
+        else if (StrComp(argv[i], "-frames"))
+            Engine.frameLimit = atoi(argv[++i]);
+        else if (StrComp(argv[i], "-benchmark"))
+            benchmarkPath = argv[++i];
+        else if (StrComp(argv[i], "-benchframes"))
+            benchmarkFrames = atoi(argv[++i]);
+        else if (StrComp(argv[i], "-renderbands"))
+            Engine.renderBands = atoi(argv[++i]);
+        else if (StrComp(argv[i], "-deferdraw"))
+            Engine.deferredDrawing = atoi(argv[++i]) != 0;
+        else if (StrComp(argv[i], "-cullbackfaces"))
+            Engine.cullBackFaces = atoi(argv[++i]) != 0;
+        else if (StrComp(argv[i], "-exportnative"))
+            exportNativeScripts = atoi(argv[++i]) != 0;
+    }
+    if (benchmarkPath)
+        StartBenchmark(benchmarkPath, benchmarkFrames);
+#endif
     Engine.Run();
 #endif
 